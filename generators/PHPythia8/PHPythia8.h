@@ -12,12 +12,15 @@
 
 #ifndef __CINT__
 #include <gsl/gsl_rng.h>
+#include <pthread.h>
 #endif
 
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <cmath>
+#include <deque>
+#include <vector>
 
 class PHCompositeNode;
 class PHHepMCGenEvent;
@@ -65,6 +68,15 @@ public:
   
   void set_node_name(std::string s) {_node_name = s;}
 
+  /// generate on n worker threads, each with its own PYTHIA8 instance
+  /// seeded from RANDOMSEED. The triggers are applied on the workers,
+  /// so their Apply() must not change the trigger object. Events are
+  /// taken from the workers in turn, so the output is reproducible for
+  /// a given number of threads
+  void set_generator_threads(const int n) {_nthreads = n;}
+  /// number of accepted events each worker keeps ready
+  void set_queue_depth(const int n) {_queue_depth = n;}
+
   void beam_vertex_parameters(double beamX,
 			      double beamY,
 			      double beamZ,
@@ -84,6 +96,21 @@ private:
 
   int read_config(const char *cfg_file = 0);
   int create_node_tree(PHCompositeNode *topNode);
+#ifndef __CINT__
+  bool apply_triggers(Pythia8::Pythia *pythia);
+
+  // one generator thread with its own PYTHIA8 and its accepted events
+  struct GenWorker {
+    PHPythia8 *parent;
+    Pythia8::Pythia *pythia;
+    HepMC::Pythia8ToHepMC *tohepmc;
+    std::deque<HepMC::GenEvent *> accepted;
+    pthread_t thread;
+  };
+  int start_workers(const unsigned int seed);
+  void stop_workers();
+  static void *generator_thread(void *arg);
+#endif
   double percent_diff(const double a, const double b){return abs((a-b)/a);}
   
   int _eventcount;
@@ -117,6 +144,17 @@ private:
 #ifndef __CINT__
   gsl_rng *RandomGenerator;
 #endif
+
+  // threaded generation
+  int _nthreads;
+  int _queue_depth;
+#ifndef __CINT__
+  std::vector<GenWorker *> _workers;
+  volatile bool _stop_workers;
+  pthread_mutex_t _mutex;
+  pthread_cond_t _acceptedcond;
+  pthread_cond_t _spacecond;
+#endif
 };
 
 #endif	/* __PHPYTHIA8_H__ */
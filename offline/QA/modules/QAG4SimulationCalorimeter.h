@@ -9,6 +9,10 @@
 #include <stdint.h>
 #include <TString.h>
 
+#ifndef __CINT__
+#include <g4cemc/RawTowerEnergyGrid.h>
+#endif
+
 class PHCompositeNode;
 class PHG4HitContainer;
 class PHG4TruthInfoContainer;
@@ -101,6 +105,9 @@ private:
 #ifndef __CINT__
   //CINT is not c++11 compatible
   std::shared_ptr<CaloEvalStack> _caloevalstack;
+
+  //! dense tower energies for the NxN window sums, reused between events
+  RawTowerEnergyGrid _tower_grid;
 #endif
 
   std::string _calo_name;
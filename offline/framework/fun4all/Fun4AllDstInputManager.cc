@@ -30,6 +30,10 @@ Fun4AllDstInputManager::Fun4AllDstInputManager(const string &name, const string
   events_total(0),
   events_thisfile(0),
   events_skipped_during_sync(0),
+  readcachesize(0),
+  prefetchdepth(0),
+  asyncunzip(0),
+  readtime(0),
   fname(NULL),
   RunNode("RUN"),
   dstNode(NULL),
@@ -102,6 +106,9 @@ Fun4AllDstInputManager::fileopen(const string &filenam)
   IManager = new PHNodeIOManager(frog.location(filename.c_str()), PHReadOnly);
   if (IManager->isFunctional())
     {
+      IManager->SetReadCacheSize(readcachesize);
+      IManager->SetPrefetchDepth(prefetchdepth);
+      IManager->SetAsyncUnzip(asyncunzip);
       isopen = 1;
       events_thisfile = 0;
       setBranches(); // set branch selections
@@ -184,6 +191,11 @@ int Fun4AllDstInputManager::fileclose()
       cout << Name() << ": fileclose: No Input file open" << endl;
       return -1;
     }
+  readtime += IManager->GetReadTime();
+  if (verbosity > 0)
+    {
+      IManager->PrintReadStats();
+    }
   delete IManager;
   IManager = 0;
   isopen = 0;
@@ -570,6 +582,21 @@ Fun4AllDstInputManager::Print(const string &what) const
 	  cout << endl;
 	}
     }
+  if (what == "ALL" || what == "READ")
+    {
+      cout << "--------------------------------------" << endl << endl;
+      cout << "Read settings of Fun4AllDstInputManager " << Name() << ":" << endl;
+      cout << "read cache size: " << readcachesize
+	   << ", prefetch depth: " << prefetchdepth
+	   << ", async unzip: " << asyncunzip << endl;
+      double totaltime = readtime;
+      if (IManager)
+	{
+	  totaltime += IManager->GetReadTime();
+	  IManager->PrintReadStats();
+	}
+      cout << "total time spent reading (ms): " << totaltime << endl;
+    }
   if ( (what == "ALL" || what == "PHOOL") && IManager)
     {
       // loop over the map and print out the content (name and location in memory)
@@ -25,6 +25,12 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   virtual int setSyncBranches(PHNodeIOManager *IManager);
   void Print(const std::string &what = "ALL") const;
   int PushBackEvents(const int i);
+  //! TTreeCache size in bytes for the event tree (0: root default)
+  void SetReadCacheSize(const long long bytes) {readcachesize = bytes;}
+  //! make the read cache large enough to hold nevents
+  void SetPrefetchDepth(const int nevents) {prefetchdepth = nevents;}
+  //! decompress the cached baskets in a background thread
+  void AsyncUnzip(const int i = 1) {asyncunzip = i;}
 
  protected:
   int ReadNextEventSyncObject();
@@ -34,6 +40,10 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int events_total;
   int events_thisfile;
   int events_skipped_during_sync;
+  long long readcachesize;
+  int prefetchdepth;
+  int asyncunzip;
+  double readtime;
   const char *fname;
   std::string RunNode;
   std::map<const std::string, int> branchread;
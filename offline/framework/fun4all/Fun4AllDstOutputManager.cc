@@ -1,10 +1,18 @@
 #include "Fun4AllDstOutputManager.h"
 #include "Fun4AllServer.h"
 
+#include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIOManager.h>
 #include <phool/PHNodeIterator.h>
 
+#include <TROOT.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+#include <TThread.h>
+#endif
+
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <string>
@@ -13,7 +21,15 @@
 using namespace std;
 
 Fun4AllDstOutputManager::Fun4AllDstOutputManager(const string &myname, const string &fname): 
- Fun4AllOutputManager( myname )
+ Fun4AllOutputManager( myname ),
+ compression_algorithm(0),
+ compression_level(3),
+ async_depth(0),
+ rollover_events(0),
+ rollover_bytes(0),
+ events_thisfile(0),
+ file_sequence(0),
+ basefilename(fname)
 {
   outfilename = fname;
   dstOut = new PHNodeIOManager(fname.c_str(), PHWrite);
@@ -24,7 +40,7 @@ Fun4AllDstOutputManager::Fun4AllDstOutputManager(const string &myname, const str
 	   << " exiting now" << endl;
       exit(1);
     }
-  dstOut->SetCompressionLevel(3);
+  ConfigureOutput();
   return ;
 }
 
@@ -80,7 +96,123 @@ Fun4AllDstOutputManager::outfileopen(const string &fname)
       return -1;
     }
 
-  dstOut->SetCompressionLevel(3);
+  ConfigureOutput();
+  return 0;
+}
+
+void
+Fun4AllDstOutputManager::ConfigureOutput()
+{
+  dstOut->SetCompressionLevel(compression_level);
+  dstOut->SetCompressionAlgorithm(compression_algorithm);
+  dstOut->SetAsyncWrite(async_depth);
+  vector<string>::const_iterator iter;
+  for (iter = swapnodes.begin(); iter != swapnodes.end(); ++iter)
+    {
+      dstOut->SwapNode(*iter);
+    }
+  return;
+}
+
+void
+Fun4AllDstOutputManager::SetCompression(const int algorithm, const int level)
+{
+  compression_algorithm = algorithm;
+  compression_level = level;
+  if (dstOut)
+    {
+      ConfigureOutput();
+    }
+  return;
+}
+
+void
+Fun4AllDstOutputManager::AsyncWrite(const int depth)
+{
+  if (depth > 0)
+    {
+      // the writer thread streams objects while the event loop goes on
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+      ROOT::EnableThreadSafety();
+#else
+      TThread::Initialize();
+#endif
+    }
+  async_depth = depth;
+  if (dstOut)
+    {
+      ConfigureOutput();
+    }
+  return;
+}
+
+int
+Fun4AllDstOutputManager::SwapNode(const string &nodename)
+{
+  vector<string>::const_iterator iter;
+  for (iter = swapnodes.begin(); iter != swapnodes.end(); ++iter)
+    {
+      if ( *iter == nodename)
+        {
+          cout << "Node " << nodename << " allready in list" << endl;
+          return -1;
+        }
+    }
+  swapnodes.push_back(nodename);
+  if (dstOut)
+    {
+      dstOut->SwapNode(nodename);
+    }
+  return 0;
+}
+
+void
+Fun4AllDstOutputManager::SetSizeRollover(const unsigned int sizeInMB)
+{
+  rollover_bytes = sizeInMB;
+  rollover_bytes *= 1024. * 1024.;
+  return;
+}
+
+// close the current file (with the run node written to it, so every
+// file of the sequence can be used on its own) and open the next one
+int
+Fun4AllDstOutputManager::Rollover()
+{
+  Fun4AllServer *se = Fun4AllServer::instance();
+  PHNodeIterator nodeiter(se->topNode());
+  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode*>(nodeiter.findFirst("PHCompositeNode", "RUN"));
+  if (runNode)
+    {
+      // WriteNode deletes dstOut which waits for the writer thread
+      WriteNode(runNode);
+    }
+  else
+    {
+      delete dstOut;
+      dstOut = 0;
+    }
+
+  file_sequence++;
+  string::size_type pos = basefilename.rfind(".root");
+  if (pos == string::npos)
+    {
+      pos = basefilename.size();
+    }
+  char seq[16];
+  snprintf(seq, sizeof(seq), "-%04d", file_sequence);
+  outfilename = basefilename.substr(0, pos) + seq + basefilename.substr(pos);
+  if (verbosity > 0)
+    {
+      cout << ThisName << ": rolling over to " << outfilename << endl;
+    }
+  events_thisfile = 0;
+  if (outfileopen(outfilename))
+    {
+      cout << PHWHERE << " Could not open " << outfilename
+	   << " exiting now" << endl;
+      exit(1);
+    }
   return 0;
 }
 
@@ -109,6 +241,28 @@ Fun4AllDstOutputManager::Print(const string &what) const
     {
       vector<string>::const_iterator iter;
       cout << ThisName << " writes " << outfilename << endl;
+      cout << ThisName << ": compression algorithm " << compression_algorithm
+           << ", level " << compression_level;
+      if (async_depth > 0)
+        {
+          cout << ", asynchronous writing (queue depth " << async_depth << ")";
+        }
+      cout << endl;
+      if (async_depth > 0)
+        {
+          for (iter = swapnodes.begin(); iter != swapnodes.end(); ++iter)
+            {
+              cout << ThisName << ": Node " << *iter << " is handed to the writer without a copy" << endl;
+            }
+        }
+      if (rollover_events > 0)
+        {
+          cout << ThisName << ": new file every " << rollover_events << " events" << endl;
+        }
+      if (rollover_bytes > 0)
+        {
+          cout << ThisName << ": new file every " << rollover_bytes / (1024. * 1024.) << " MB" << endl;
+        }
       if (savenodes.empty())
         {
           if (stripnodes.empty())
@@ -198,6 +352,7 @@ Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
         }
     }
   dstOut->write(startNode);
+  events_thisfile++;
   if (savenodes.empty())
     {
       Fun4AllServer *se = Fun4AllServer::instance();
@@ -214,6 +369,21 @@ Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
             }
         }
     }
+  if ((rollover_events > 0 && events_thisfile >= rollover_events) ||
+      (rollover_bytes > 0 && dstOut->GetBytesWritten() >= rollover_bytes))
+    {
+      Rollover();
+    }
+  return 0;
+}
+
+int
+Fun4AllDstOutputManager::HandOverEvent()
+{
+  if (dstOut)
+    {
+      dstOut->HandOverEvent();
+    }
   return 0;
 }
 
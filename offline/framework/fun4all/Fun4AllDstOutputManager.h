@@ -25,11 +25,41 @@ class Fun4AllDstOutputManager: public Fun4AllOutputManager
 
   int Write(PHCompositeNode *startNode);
   int WriteNode(PHCompositeNode *thisNode);
+  int HandOverEvent();
+
+  //! compression algorithm (1: zlib, 2: lzma, 4: lz4) and level (0-9)
+  void SetCompression(const int algorithm, const int level);
+  //! fill and compress the output tree in a background thread, queue up to depth events
+  void AsyncWrite(const int depth = 4);
+  /*! with AsyncWrite the writer gets copies of the node objects. For the
+    nodes given here it gets the objects themselves and the nodes get
+    spares of the same class instead. Only safe if the module filling the
+    node looks up its object each event (not keeping the pointer) and the
+    Reset() of the class clears all of its content
+  */
+  int SwapNode(const std::string &nodename);
+  /*! start a new output file after nevents events, the first file keeps
+    the given name, the following ones get -0001, -0002, ... appended
+  */
+  void SetEventRollover(const unsigned int nevents) {rollover_events = nevents;}
+  //! start a new output file once sizeInMB have been written
+  void SetSizeRollover(const unsigned int sizeInMB);
 
  protected:
+  void ConfigureOutput();
+  int Rollover();
   std::vector <std::string> savenodes;
   std::vector <std::string> stripnodes;
+  std::vector <std::string> swapnodes;
   PHNodeIOManager *dstOut;
+  int compression_algorithm;
+  int compression_level;
+  int async_depth;
+  unsigned int rollover_events;
+  double rollover_bytes;
+  unsigned int events_thisfile;
+  int file_sequence;
+  std::string basefilename;
 };
 
 #endif /* __FUN4ALLDSTOUTPUTMANAGER_H__ */
@@ -52,6 +52,14 @@ class Fun4AllOutputManager: public Fun4AllBase
   //! write specified node
   virtual int WriteNode(PHCompositeNode* /*thisNode*/)
   { return 0; }
+
+  /*! \brief
+    called once all output managers wrote the event, before the node
+    tree is reset. Managers writing in the background take the objects
+    of the event here
+  */
+  virtual int HandOverEvent()
+  { return 0; }
   
   //! retrieves pointer to vector of event selector module names
   virtual std::vector <std::string> *EventSelector() 
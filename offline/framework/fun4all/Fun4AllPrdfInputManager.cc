@@ -15,6 +15,7 @@
 
 #include <Event/Event.h>
 #include <Event/fileEventiterator.h>
+#include <Event/mmapEventiterator.h>
 
 #include <cstdlib>
 #include <memory>
@@ -31,6 +32,7 @@ Fun4AllPrdfInputManager::Fun4AllPrdfInputManager(const string &name, const strin
  isopen(0),
  events_total(0),
  events_thisfile(0),
+ use_mmap(0),
  topNodeName(topnodename),
  evt(NULL),
  save_evt(NULL),
@@ -75,7 +77,14 @@ int Fun4AllPrdfInputManager::fileopen(const string &filenam)
       cout << ThisName << ": opening file " << filename.c_str() << endl;
     }
   int status = 0;
-  eventiterator = new fileEventiterator(fname.c_str(), status);
+  if (use_mmap)
+    {
+      eventiterator = new mmapEventiterator(fname.c_str(), status);
+    }
+  else
+    {
+      eventiterator = new fileEventiterator(fname.c_str(), status);
+    }
   events_thisfile = 0;
   if (status)
     {
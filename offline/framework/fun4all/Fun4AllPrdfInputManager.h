@@ -26,6 +26,8 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   int PushBackEvents(const int i);
   int GetSyncObject(SyncObject **mastersync);
   int SyncIt(const SyncObject *mastersync);
+  //! read the prdf through a memory mapping (mmapEventiterator)
+  void UseMmap(const int i = 1) {use_mmap = i;}
 
  protected:
   int OpenNextFile();
@@ -33,6 +35,7 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   int isopen;
   int events_total;
   int events_thisfile;
+  int use_mmap;
   std::string topNodeName;
   PHCompositeNode *topNode;
   Event *evt;
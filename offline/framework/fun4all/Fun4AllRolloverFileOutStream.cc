@@ -3,6 +3,7 @@
 #include "Fun4AllServer.h"
 
 #include <Event/ogzBuffer.h>
+#include <Event/oparallelBuffer.h>
 #include <Event/Event.h>
 
 #include <phool/phool.h>
@@ -22,6 +23,8 @@ Fun4AllRolloverFileOutStream::Fun4AllRolloverFileOutStream(const string &frule,
 
 {
   i_offset = offset;
+  compression_threads = 0;
+  use_lzo = 0;
   current_sequence = offset;
   max_file_size = sizeInMB;
   max_file_size = max_file_size * 1024 * 1024;
@@ -75,7 +78,16 @@ Fun4AllRolloverFileOutStream::WriteEventOut(Event *evt)
       mymanager->SetOutfileName(outfilename);
       // compression level 6 is best compromize between speed and compression
       // max is 9 which is much slower but only squeezes out a few more bytes
-      ob = new ogzBuffer ( outfile_desc, xb, LENGTH, 6, irun, iseq);
+      if (compression_threads > 0)
+	{
+	  ob = new oparallelBuffer ( outfile_desc, xb, LENGTH, compression_threads,
+				     (use_lzo ? oparallelBuffer::LZO : oparallelBuffer::GZIP),
+				     6, irun, iseq);
+	}
+      else
+	{
+	  ob = new ogzBuffer ( outfile_desc, xb, LENGTH, 6, irun, iseq);
+	}
       delete [] outfilename;
     }
 
@@ -103,5 +115,11 @@ Fun4AllRolloverFileOutStream::identify(ostream &os) const
 {
   os << "Fun4AllRolloverFileOutStream writing to " << filerule
      << " current sequence " << current_sequence << endl;
+  oparallelBuffer *pob = dynamic_cast<oparallelBuffer *>(ob);
+  if (pob)
+    {
+      os << "compressing on " << compression_threads << " threads, "
+	 << pob->getThroughput() / (1024. * 1024.) << " MB/s" << endl;
+    }
     return ;
 }
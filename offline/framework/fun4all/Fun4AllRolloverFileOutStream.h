@@ -14,12 +14,18 @@ class Fun4AllRolloverFileOutStream: public Fun4AllFileOutStream
   virtual ~Fun4AllRolloverFileOutStream() {}
   int WriteEventOut(Event *evt);
   void identify(std::ostream &os = std::cout) const;
+  //! compress the buffers on nthreads worker threads while the next one is filled (0: no threads)
+  void CompressionThreads(const int nthreads) {compression_threads = nthreads;}
+  //! write lzo instead of gzip compressed buffers (only with CompressionThreads)
+  void UseLzo(const int i = 1) {use_lzo = i;}
 
  protected:
   unsigned long long max_file_size;
   int current_sequence;
   int i_offset;
   int i_increment;
+  int compression_threads;
+  int use_lzo;
   
 
 };
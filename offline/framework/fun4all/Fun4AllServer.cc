@@ -4,6 +4,7 @@
 #include "Fun4AllSyncManager.h"
 #include "Fun4AllOutputManager.h"
 #include "Fun4AllReturnCodes.h"
+#include "Fun4AllSubsysScheduler.h"
 #include "SubsysReco.h"
 
 #include <phool/getClass.h>
@@ -25,6 +26,10 @@
 #include <TNamed.h>
 #include <TROOT.h>
 #include <TSystem.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+#include <TThread.h>
+#endif
 
 #include <boost/foreach.hpp>
 
@@ -59,7 +64,9 @@ Fun4AllServer::Fun4AllServer(const std::string &name):
   runnumber(0),
   eventnumber(0),
   beginruntimestamp(NULL),
-  keep_db_connected(0)
+  keep_db_connected(0),
+  subsysscheduler(NULL),
+  subsysgraph_dirty(true)
 {
   InitAll();
   return ;
@@ -69,6 +76,7 @@ Fun4AllServer::~Fun4AllServer()
 {
   Reset();
   delete beginruntimestamp;
+  delete subsysscheduler;
   while (Subsystems.begin() != Subsystems.end())
     {
       if (verbosity>=VERBOSITY_MORE)
@@ -261,6 +269,7 @@ Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const string &topnodenam
       cout << "Registering Subsystem " << subsystem->Name() << endl;
     }
   Subsystems.push_back(newsubsyspair);
+  subsysgraph_dirty = true;
 
   RetCodes.push_back(iret); // vector with return codes
   return 0;
@@ -308,6 +317,7 @@ Fun4AllServer::unregisterSubsystemsNow()
                << " at index " << index << endl;
         }
       Subsystems.erase(Subsystems.begin() + index);
+      subsysgraph_dirty = true;
       delete (*removeiter).first;
       // also update the vector with return codes
       RetCodes.erase(RetCodes.begin() + index);
@@ -534,84 +544,65 @@ Fun4AllServer::process_event()
     }
   gROOT->cd(default_Tdirectory.c_str());
   string currdir = gDirectory->GetPath();
-  for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+  if (subsysscheduler)
     {
-      if (verbosity >= VERBOSITY_MORE)
-        {
-          cout << "Fun4AllServer::process_event processing " << (*iter).first->Name() << endl;
-        }
-      ostringstream newdirname;
-      newdirname << (*iter).second->getName() << "/" << (*iter).first->Name();
-      if (!gROOT->cd(newdirname.str().c_str()))
-        {
-          cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-               << (*iter).second->getName()
-               << " - send e-mail to off-l with your macro" << endl;
-          exit(1);
-        }
-      else
+      if (subsysgraph_dirty)
         {
-          if (verbosity >= VERBOSITY_EVEN_MORE)
+          subsysscheduler->BuildGraph(Subsystems);
+          if (verbosity >= VERBOSITY_SOME)
             {
-              cout << "process_event: cded to " << newdirname.str().c_str() << endl;
+              subsysscheduler->Print();
             }
+          subsysgraph_dirty = false;
         }
-
-      try
-	{
-	  RetCodes[icnt] = (*iter).first->process_event((*iter).second);
-	}
-      catch (const exception& e)
-	{
-	  cout << PHWHERE << " caught exception thrown during process_event from "
-	       << (*iter).first->Name() << endl;
-	  cout << "error: " << e.what() << endl;
-	  exit(1);
-	}
-      catch (...)
-	{
-	  cout << PHWHERE << " caught unknown type exception thrown during process_event from "
-	       << (*iter).first->Name() << endl;
-	  exit(1);
-	}
-      if ( RetCodes[icnt] )
+      // bring the node indices up to date here, otherwise the first
+      // lookup in a worker rebuilds them while holding the index lock
+      map<string, PHCompositeNode *>::const_iterator topiter;
+      for (topiter = topnodemap.begin(); topiter != topnodemap.end(); ++topiter)
         {
-          if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
+          topiter->second->updateIndex();
+        }
+      vector<int> executed(Subsystems.size(), 0);
+      // the workers are idle outside of process_event
+      PHCompositeNode::LockIndex(true);
+      subsysscheduler->process_event(RetCodes, executed);
+      PHCompositeNode::LockIndex(false);
+      // evaluate the return codes in the order of registration
+      for (icnt = 0; icnt < Subsystems.size(); icnt++)
+        {
+          if (!executed[icnt])
             {
-              if (verbosity >= VERBOSITY_EVEN_MORE)
-                {
-                  cout << "Fun4AllServer::Discard Event by " << (*iter).first->Name() << endl;
-                }
+              continue;
             }
-          else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
+          int iret = CheckRetCode(icnt);
+          if (iret == Fun4AllReturnCodes::ABORTEVENT)
             {
-              retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
               eventbad = 1;
-              if (verbosity >= VERBOSITY_MORE)
-                {
-                  cout << "Fun4AllServer::Abort Event by " << (*iter).first->Name() << endl;
-                }
               break;
             }
-          else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
+          else if (iret == Fun4AllReturnCodes::ABORTRUN)
             {
-              retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
-              cout << "Fun4AllServer::Abort Run by " << (*iter).first->Name() << endl;
               return Fun4AllReturnCodes::ABORTRUN;
             }
-          else
+        }
+    }
+  else
+    {
+      for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+        {
+          RetCodes[icnt] = ProcessSubsystem(icnt);
+          int iret = CheckRetCode(icnt);
+          if (iret == Fun4AllReturnCodes::ABORTEVENT)
+            {
+              eventbad = 1;
+              break;
+            }
+          else if (iret == Fun4AllReturnCodes::ABORTRUN)
             {
-              cout << "Fun4AllServer::Unknown return code: "
-                   << RetCodes[icnt] << " from process_event method of "
-                   << (*iter).first->Name() << endl;
-              cout << "This smells like an uninitialized return code and" << endl;
-              cout << "it is too dangerous to continue, this Run will be aborted" << endl;
-              cout << "If you do not know how to fix this please send mail to" << endl;
-              cout << "phenix-off-l with this message" << endl;
               return Fun4AllReturnCodes::ABORTRUN;
             }
+          icnt++;
         }
-      icnt++;
     }
   if (!eventbad)
     {
@@ -685,10 +676,124 @@ Fun4AllServer::process_event()
         }
       syncman->ResetEvent();
     }
+  vector<Fun4AllOutputManager *>::iterator iterOutMan;
+  for (iterOutMan = OutputManager.begin(); iterOutMan != OutputManager.end(); ++iterOutMan)
+    {
+      (*iterOutMan)->HandOverEvent();
+    }
   ResetNodeTree();
   return 0;
 }
 
+int
+Fun4AllServer::ProcessSubsystem(const unsigned int icnt)
+{
+  SubsysReco *subsys = Subsystems[icnt].first;
+  PHCompositeNode *subsystopNode = Subsystems[icnt].second;
+  if (verbosity >= VERBOSITY_MORE)
+    {
+      cout << "Fun4AllServer::process_event processing " << subsys->Name() << endl;
+    }
+  ostringstream newdirname;
+  newdirname << subsystopNode->getName() << "/" << subsys->Name();
+  if (!gROOT->cd(newdirname.str().c_str()))
+    {
+      cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+           << subsystopNode->getName()
+           << " - send e-mail to off-l with your macro" << endl;
+      exit(1);
+    }
+  else
+    {
+      if (verbosity >= VERBOSITY_EVEN_MORE)
+        {
+          cout << "process_event: cded to " << newdirname.str().c_str() << endl;
+        }
+    }
+
+  int iret = 0;
+  try
+    {
+      iret = subsys->process_event(subsystopNode);
+    }
+  catch (const exception& e)
+    {
+      cout << PHWHERE << " caught exception thrown during process_event from "
+           << subsys->Name() << endl;
+      cout << "error: " << e.what() << endl;
+      exit(1);
+    }
+  catch (...)
+    {
+      cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+           << subsys->Name() << endl;
+      exit(1);
+    }
+  return iret;
+}
+
+int
+Fun4AllServer::CheckRetCode(const unsigned int icnt)
+{
+  if ( RetCodes[icnt] )
+    {
+      if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
+        {
+          if (verbosity >= VERBOSITY_EVEN_MORE)
+            {
+              cout << "Fun4AllServer::Discard Event by " << Subsystems[icnt].first->Name() << endl;
+            }
+        }
+      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
+        {
+          retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
+          if (verbosity >= VERBOSITY_MORE)
+            {
+              cout << "Fun4AllServer::Abort Event by " << Subsystems[icnt].first->Name() << endl;
+            }
+          return Fun4AllReturnCodes::ABORTEVENT;
+        }
+      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
+        {
+          retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
+          cout << "Fun4AllServer::Abort Run by " << Subsystems[icnt].first->Name() << endl;
+          return Fun4AllReturnCodes::ABORTRUN;
+        }
+      else
+        {
+          cout << "Fun4AllServer::Unknown return code: "
+               << RetCodes[icnt] << " from process_event method of "
+               << Subsystems[icnt].first->Name() << endl;
+          cout << "This smells like an uninitialized return code and" << endl;
+          cout << "it is too dangerous to continue, this Run will be aborted" << endl;
+          cout << "If you do not know how to fix this please send mail to" << endl;
+          cout << "phenix-off-l with this message" << endl;
+          return Fun4AllReturnCodes::ABORTRUN;
+        }
+    }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void
+Fun4AllServer::ParallelSubsystems(const int nthreads)
+{
+  delete subsysscheduler;
+  subsysscheduler = NULL;
+  if (nthreads > 0)
+    {
+      // the worker threads cd to their own TDirectory, this needs
+      // root's thread local gDirectory
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+      ROOT::EnableThreadSafety();
+#else
+      TThread::Initialize();
+#endif
+      subsysscheduler = new Fun4AllSubsysScheduler(this, nthreads);
+      subsysgraph_dirty = true;
+    }
+  return;
+}
+
 int
 Fun4AllServer::ResetNodeTree()
 {
@@ -775,6 +880,8 @@ int Fun4AllServer::BeginRun(const int runno)
     {
       unregisterSubsystemsNow();
     }
+  // modules might declare their nodes in InitRun
+  subsysgraph_dirty = true;
 
   // we have to do the same TDirectory games as in the Init methods
   // save the current dir, cd to the subsystem name dir (which was
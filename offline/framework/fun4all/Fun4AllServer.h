@@ -10,6 +10,7 @@
 
 
 class Fun4AllInputManager;
+class Fun4AllSubsysScheduler;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
 class PHCompositeNode;
@@ -21,6 +22,8 @@ class TNamed;
 
 class Fun4AllServer: public Fun4AllBase
 {
+  friend class Fun4AllSubsysScheduler;
+
  public:
   static Fun4AllServer *instance();
   virtual ~Fun4AllServer();
@@ -98,6 +101,8 @@ class Fun4AllServer: public Fun4AllBase
   void EventNumber(const int evtno) {eventnumber = evtno;}
   void NodeIdentify(const std::string &name);
   void KeepDBConnection(const int i=1) {keep_db_connected = i;}
+  //! run independent SubsysRecos concurrently on nthreads threads (0: serial)
+  void ParallelSubsystems(const int nthreads);
 
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
@@ -106,6 +111,8 @@ class Fun4AllServer: public Fun4AllBase
   int CountOutNodesRecursive(PHCompositeNode *startNode, const int icount);
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
+  int ProcessSubsystem(const unsigned int icnt);
+  int CheckRetCode(const unsigned int icnt);
   int setRun(const int runnumber);
   static Fun4AllServer *__instance;
   int OutNodeCount;
@@ -131,6 +138,8 @@ class Fun4AllServer: public Fun4AllBase
   std::map<int,int> retcodesmap;
   TH1 *FrameWorkVars;
   int keep_db_connected;
+  Fun4AllSubsysScheduler *subsysscheduler;
+  bool subsysgraph_dirty;
 };
 
 #endif /* __FUN4ALLSERVER_H */
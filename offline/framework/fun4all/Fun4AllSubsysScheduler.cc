@@ -0,0 +1,218 @@
+#include "Fun4AllSubsysScheduler.h"
+#include "Fun4AllServer.h"
+#include "Fun4AllReturnCodes.h"
+#include "SubsysReco.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+  bool intersect(const set<string> &a, const set<string> &b)
+  {
+    set<string>::const_iterator ia = a.begin();
+    set<string>::const_iterator ib = b.begin();
+    while (ia != a.end() && ib != b.end())
+      {
+	if (*ia < *ib)
+	  {
+	    ++ia;
+	  }
+	else if (*ib < *ia)
+	  {
+	    ++ib;
+	  }
+	else
+	  {
+	    return true;
+	  }
+      }
+    return false;
+  }
+}
+
+Fun4AllSubsysScheduler::Fun4AllSubsysScheduler(Fun4AllServer *server, const int nthreads):
+  se(server),
+  event_retcodes(NULL),
+  event_executed(NULL),
+  nrunning(0),
+  abortevent(false),
+  stopthreads(false)
+{
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&workcond, NULL);
+  pthread_cond_init(&donecond, NULL);
+  for (int i = 0; i < nthreads; i++)
+    {
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, StartWorker, this))
+	{
+	  cout << PHWHERE << " could not start worker thread " << i << endl;
+	  exit(1);
+	}
+      threads.push_back(thread);
+    }
+}
+
+Fun4AllSubsysScheduler::~Fun4AllSubsysScheduler()
+{
+  pthread_mutex_lock(&mutex);
+  stopthreads = true;
+  pthread_cond_broadcast(&workcond);
+  pthread_mutex_unlock(&mutex);
+  for (vector<pthread_t>::iterator iter = threads.begin(); iter != threads.end(); ++iter)
+    {
+      pthread_join(*iter, NULL);
+    }
+  pthread_cond_destroy(&donecond);
+  pthread_cond_destroy(&workcond);
+  pthread_mutex_destroy(&mutex);
+}
+
+void
+Fun4AllSubsysScheduler::BuildGraph(const vector<pair<SubsysReco *, PHCompositeNode *> > &subsystems)
+{
+  unsigned int nmodules = subsystems.size();
+  modulenames.clear();
+  dependents.assign(nmodules, vector<unsigned int>());
+  ndependencies.assign(nmodules, 0);
+  for (unsigned int j = 0; j < nmodules; j++)
+    {
+      const SubsysReco *later = subsystems[j].first;
+      modulenames.push_back(later->Name());
+      for (unsigned int i = 0; i < j; i++)
+	{
+	  const SubsysReco *earlier = subsystems[i].first;
+	  if (!earlier->NodesDeclared() || !later->NodesDeclared() ||
+	      intersect(earlier->OutputNodes(), later->InputNodes()) ||
+	      intersect(earlier->OutputNodes(), later->OutputNodes()) ||
+	      intersect(earlier->InputNodes(), later->OutputNodes()))
+	    {
+	      dependents[i].push_back(j);
+	      ndependencies[j]++;
+	    }
+	}
+    }
+  return;
+}
+
+void
+Fun4AllSubsysScheduler::process_event(vector<int> &retcodes, vector<int> &executed)
+{
+  pthread_mutex_lock(&mutex);
+  event_retcodes = &retcodes;
+  event_executed = &executed;
+  fill(executed.begin(), executed.end(), 0);
+  waiting = ndependencies;
+  ready.clear();
+  for (unsigned int i = 0; i < waiting.size(); i++)
+    {
+      if (!waiting[i])
+	{
+	  ready.insert(i);
+	}
+    }
+  abortevent = false;
+  pthread_cond_broadcast(&workcond);
+  while (!EventDone())
+    {
+      pthread_cond_wait(&donecond, &mutex);
+    }
+  event_retcodes = NULL;
+  event_executed = NULL;
+  pthread_mutex_unlock(&mutex);
+  return;
+}
+
+bool
+Fun4AllSubsysScheduler::EventDone() const
+{
+  return (nrunning == 0 && (ready.empty() || abortevent));
+}
+
+void *
+Fun4AllSubsysScheduler::StartWorker(void *arg)
+{
+  static_cast<Fun4AllSubsysScheduler *>(arg)->Worker();
+  return NULL;
+}
+
+void
+Fun4AllSubsysScheduler::Worker()
+{
+  pthread_mutex_lock(&mutex);
+  while (true)
+    {
+      while (!stopthreads && (ready.empty() || abortevent))
+	{
+	  pthread_cond_wait(&workcond, &mutex);
+	}
+      if (stopthreads)
+	{
+	  break;
+	}
+      // lowest index first keeps the order close to the serial one
+      unsigned int imodule = *ready.begin();
+      ready.erase(ready.begin());
+      nrunning++;
+      pthread_mutex_unlock(&mutex);
+
+      int iret = se->ProcessSubsystem(imodule);
+
+      pthread_mutex_lock(&mutex);
+      nrunning--;
+      (*event_retcodes)[imodule] = iret;
+      (*event_executed)[imodule] = 1;
+      if (iret && iret != Fun4AllReturnCodes::DISCARDEVENT)
+	{
+	  // abort event, abort run or some garbage, the server sorts it out
+	  abortevent = true;
+	}
+      else
+	{
+	  for (vector<unsigned int>::const_iterator iter = dependents[imodule].begin();
+	       iter != dependents[imodule].end(); ++iter)
+	    {
+	      if (!--waiting[*iter])
+		{
+		  ready.insert(*iter);
+		}
+	    }
+	  pthread_cond_broadcast(&workcond);
+	}
+      if (EventDone())
+	{
+	  pthread_cond_signal(&donecond);
+	}
+    }
+  pthread_mutex_unlock(&mutex);
+  return;
+}
+
+void
+Fun4AllSubsysScheduler::Print() const
+{
+  cout << "Fun4AllSubsysScheduler: " << threads.size() << " threads" << endl;
+  for (unsigned int i = 0; i < modulenames.size(); i++)
+    {
+      cout << modulenames[i] << " waits for " << ndependencies[i] << " modules, ";
+      if (dependents[i].empty())
+	{
+	  cout << "nobody waits for it" << endl;
+	  continue;
+	}
+      cout << "needed by:";
+      for (vector<unsigned int>::const_iterator iter = dependents[i].begin();
+	   iter != dependents[i].end(); ++iter)
+	{
+	  cout << " " << modulenames[*iter];
+	}
+      cout << endl;
+    }
+  return;
+}
@@ -0,0 +1,62 @@
+#ifndef FUN4ALLSUBSYSSCHEDULER_H
+#define FUN4ALLSUBSYSSCHEDULER_H
+
+#include <pthread.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Fun4AllServer;
+class PHCompositeNode;
+class SubsysReco;
+
+/** Runs the process_event of the registered SubsysRecos on a pool of
+ *  threads. The modules are ordered by a dependency graph built from the
+ *  nodes they declared (SubsysReco::DeclareInputNode/DeclareOutputNode):
+ *  a module depends on every earlier module which writes a node it reads
+ *  or writes, or which reads a node it writes. Modules without
+ *  declarations depend on all earlier modules and all later modules
+ *  depend on them, so they keep their place in the sequence.
+ *  Once a module returns ABORTEVENT or ABORTRUN no new module is started.
+ */
+
+class Fun4AllSubsysScheduler
+{
+ public:
+  Fun4AllSubsysScheduler(Fun4AllServer *server, const int nthreads);
+  virtual ~Fun4AllSubsysScheduler();
+
+  void BuildGraph(const std::vector<std::pair<SubsysReco *, PHCompositeNode *> > &subsystems);
+  /// runs all modules, executed[i] is set to 1 for modules which ran
+  void process_event(std::vector<int> &retcodes, std::vector<int> &executed);
+  void Print() const;
+  int NThreads() const {return threads.size();}
+
+ protected:
+  static void *StartWorker(void *arg);
+  void Worker();
+  bool EventDone() const;
+
+  Fun4AllServer *se;
+  std::vector<std::string> modulenames;
+  std::vector<std::vector<unsigned int> > dependents;
+  std::vector<unsigned int> ndependencies;
+
+  // per event bookkeeping, protected by mutex
+  std::vector<unsigned int> waiting;
+  std::set<unsigned int> ready;
+  std::vector<int> *event_retcodes;
+  std::vector<int> *event_executed;
+  unsigned int nrunning;
+  bool abortevent;
+  bool stopthreads;
+
+  std::vector<pthread_t> threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t workcond;
+  pthread_cond_t donecond;
+};
+
+#endif /* FUN4ALLSUBSYSSCHEDULER_H */
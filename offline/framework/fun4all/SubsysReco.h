@@ -2,6 +2,7 @@
 #define __SUBSYSRECO_H__
 
 #include "Fun4AllBase.h"
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -59,12 +60,28 @@ class SubsysReco: public Fun4AllBase
 
   virtual void Print(const std::string &what = "ALL") const {}
 
+  /** Declare the nodes which are read and written by process_event().
+      If Fun4AllServer::ParallelSubsystems() is used, modules which
+      declared their nodes and do not share any written node with each
+      other are run concurrently. Modules which do not declare anything
+      are always run strictly in sequence.
+  */
+  void DeclareInputNode(const std::string &nodename) {inputnodes.insert(nodename);}
+  void DeclareOutputNode(const std::string &nodename) {outputnodes.insert(nodename);}
+  const std::set<std::string> &InputNodes() const {return inputnodes;}
+  const std::set<std::string> &OutputNodes() const {return outputnodes;}
+  bool NodesDeclared() const {return (!inputnodes.empty() || !outputnodes.empty());}
+
  protected:
 
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
   */
   SubsysReco(const std::string &name = "NONAME") : Fun4AllBase(name) {}
+
+ private:
+  std::set<std::string> inputnodes;
+  std::set<std::string> outputnodes;
 };
 
 #endif /* __SUBSYSRECO_H__ */
@@ -10,16 +10,58 @@
 #include "PHPointerListIterator.h"
 #include "phooldefs.h"
 
+#include <pthread.h>
+
 #include <iostream>
 
 using namespace std;
 
-PHCompositeNode::PHCompositeNode() : PHNode("NULL")
+namespace
+{
+  // One lock for the indices of all nodes, a change in a sub tree
+  // invalidates the tree index of all parents. Modules running in
+  // parallel look up nodes while others may add new ones. It is only
+  // taken while that is the case (PHCompositeNode::LockIndex), serial
+  // jobs do not pay for it.
+  pthread_mutex_t index_mutex = PTHREAD_MUTEX_INITIALIZER;
+  bool lock_index = false;
+
+  class IndexLock
+  {
+  public:
+    IndexLock(): locked(lock_index)
+    {
+      if (locked)
+	{
+	  pthread_mutex_lock(&index_mutex);
+	}
+    }
+    ~IndexLock()
+    {
+      if (locked)
+	{
+	  pthread_mutex_unlock(&index_mutex);
+	}
+    }
+  private:
+    bool locked;
+  };
+}
+
+void
+PHCompositeNode::LockIndex(const bool yesno)
+{
+  lock_index = yesno;
+}
+
+PHCompositeNode::PHCompositeNode() : PHNode("NULL"),
+  treeIndexValid(false)
 {}
 
 PHCompositeNode::PHCompositeNode(const string& name) : 
   PHNode(name,"PHCompositeNode"),
-  deleteMe(0)
+  deleteMe(0),
+  treeIndexValid(false)
 {
   type = "PHCompositeNode";
 }
@@ -39,25 +81,27 @@ PHCompositeNode::~PHCompositeNode()
 PHBoolean
 PHCompositeNode::addNode(PHNode* newNode)
 {
+  IndexLock lock;
   //
   // Check all existing subNodes for name-conflict.
   //
-  PHPointerListIterator<PHNode> nodeIter(subNodes);
-  PHNode* thisNode;
-  while ((thisNode = nodeIter())) 
+  if (subNodeIndex.find(newNode->getName()) != subNodeIndex.end())
     {
-      if (thisNode->getName() == newNode->getName()) 
-	{
-	  cout << PHWHERE << "Node " << newNode->getName() 
-               << " already exists" << endl;
-	  return False;
-	}
+      cout << PHWHERE << "Node " << newNode->getName() 
+	   << " already exists" << endl;
+      return False;
     }
   //
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
-  return (subNodes.append(newNode));
+  if (!subNodes.append(newNode))
+    {
+      return False;
+    }
+  subNodeIndex[newNode->getName()] = newNode;
+  invalidateTreeIndex();
+  return True;
 }
 
 void
@@ -69,8 +113,14 @@ PHCompositeNode::prune()
     {
       if (!thisNode->isPersistent()) 
 	{
-	  subNodes.removeAt(nodeIter.pos());
-	  --nodeIter;
+	  {
+	    IndexLock lock;
+	    subNodes.removeAt(nodeIter.pos());
+	    --nodeIter;
+	    subNodeIndex.erase(thisNode->getName());
+	    invalidateTreeIndex();
+	  }
+	  // not under the lock, the destructor calls forgetMe
 	  delete thisNode;
 	}
       else
@@ -91,6 +141,7 @@ PHCompositeNode::forgetMe(PHNode* child)
     {
       return;
     }
+  IndexLock lock;
   PHPointerListIterator<PHNode> nodeIter(subNodes);
   PHNode* thisNode;
   while (child && (thisNode = nodeIter())) 
@@ -98,11 +149,147 @@ PHCompositeNode::forgetMe(PHNode* child)
       if (thisNode == child) 
 	{
 	  subNodes.removeAt(nodeIter.pos());
+	  subNodeIndex.erase(thisNode->getName());
+	  invalidateTreeIndex();
 	  child = 0;
 	}
     }   
 }
 
+void
+PHCompositeNode::subNodeRenamed()
+{
+  // one of our subnodes changed its name, the name index has to be
+  // redone from scratch (this is rare, so no need to be clever here)
+  IndexLock lock;
+  subNodeIndex.clear();
+  PHPointerListIterator<PHNode> nodeIter(subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter())) 
+    {
+      subNodeIndex[thisNode->getName()] = thisNode;
+    }
+  invalidateTreeIndex();
+}
+
+void
+PHCompositeNode::invalidateTreeIndex()
+{
+  // a change in our sub tree is also a change in the sub tree
+  // of all our parents
+  PHCompositeNode *node = this;
+  while (node)
+    {
+      node->treeIndexValid = false;
+      node = static_cast<PHCompositeNode*>(node->getParent());
+    }
+}
+
+void
+PHCompositeNode::buildTreeIndex(PHCompositeNode *startNode)
+{
+  // same order as the recursive walk in PHNodeIterator::findFirst
+  PHPointerListIterator<PHNode> nodeIter(startNode->subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter())) 
+    {
+      treeIndex[thisNode->getName()].push_back(thisNode);
+      if (thisNode->getType() == "PHCompositeNode")
+	{
+	  buildTreeIndex(static_cast<PHCompositeNode*>(thisNode));
+	}
+    }
+}
+
+void
+PHCompositeNode::updateIndex()
+{
+  IndexLock lock;
+  updateIndexLocked();
+}
+
+void
+PHCompositeNode::updateIndexLocked()
+{
+  if (!treeIndexValid)
+    {
+      treeIndex.clear();
+      buildTreeIndex(this);
+      treeIndexValid = true;
+    }
+  PHPointerListIterator<PHNode> nodeIter(subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter())) 
+    {
+      if (thisNode->getType() == "PHCompositeNode")
+	{
+	  static_cast<PHCompositeNode*>(thisNode)->updateIndexLocked();
+	}
+    }
+}
+
+PHNode*
+PHCompositeNode::findSubNode(const string &name) const
+{
+  IndexLock lock;
+  boost::unordered_map<string, PHNode*>::const_iterator iter = subNodeIndex.find(name);
+  if (iter != subNodeIndex.end())
+    {
+      return iter->second;
+    }
+  return 0;
+}
+
+const vector<PHNode*>*
+PHCompositeNode::findInTreeIndex(const string &name)
+{
+  if (!treeIndexValid)
+    {
+      treeIndex.clear();
+      buildTreeIndex(this);
+      treeIndexValid = true;
+    }
+  boost::unordered_map<string, vector<PHNode*> >::const_iterator iter = treeIndex.find(name);
+  if (iter != treeIndex.end())
+    {
+      return &(iter->second);
+    }
+  return 0;
+}
+
+PHNode*
+PHCompositeNode::findInTree(const string &name)
+{
+  IndexLock lock;
+  const vector<PHNode*> *nodes = findInTreeIndex(name);
+  if (nodes)
+    {
+      return nodes->front();
+    }
+  return 0;
+}
+
+PHNode*
+PHCompositeNode::findInTree(const string &type, const string &name)
+{
+  IndexLock lock;
+  const vector<PHNode*> *nodes = findInTreeIndex(name);
+  if (!nodes)
+    {
+      return 0;
+    }
+  // pick the first node with the right type (usually there is only
+  // one node with a given name)
+  for (vector<PHNode*>::const_iterator iter = nodes->begin(); iter != nodes->end(); ++iter)
+    {
+      if ((*iter)->getType() == type)
+	{
+	  return *iter;
+	}
+    }
+  return 0;
+}
+
 bool
 PHCompositeNode::write(PHIOManager * IOManager, const std::string &path)
 {
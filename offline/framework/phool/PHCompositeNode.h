@@ -8,11 +8,19 @@
 #include "PHNode.h"
 #include "PHPointerList.h"
 
+#ifndef __CINT__
+#include <boost/unordered_map.hpp>
+#endif
+
+#include <string>
+#include <vector>
+
 class PHIOManager;
 class PHNodeIterator;
 
 class PHCompositeNode : public PHNode { 
 
+   friend class PHNode;
    friend class PHNodeIterator;
    
 public: 
@@ -31,6 +39,28 @@ public:
    //
    virtual void prune();
 
+   //
+   // Name lookups using the node indices. findSubNode only looks at the
+   // direct subnodes, findInTree searches the whole sub tree and returns
+   // the same node as a depth first walk (PHNodeIterator::findFirst) would.
+   //
+   PHNode* findSubNode(const std::string &name) const;
+   PHNode* findInTree(const std::string &name);
+   PHNode* findInTree(const std::string &type, const std::string &name);
+
+   //
+   // Rebuild all outdated indices in this sub tree. Calling this before
+   // modules run in parallel keeps the rebuild out of their lookups.
+   //
+   void updateIndex();
+
+   //
+   // Serialize all index accesses by one lock. Only needed (and only to
+   // be switched) while no other thread touches the node tree, i.e.
+   // around the parallel processing of the modules.
+   //
+   static void LockIndex(const bool yesno);
+
    //
    // I/O functions
    //
@@ -39,9 +69,24 @@ public:
 
 protected:
    virtual void forgetMe(PHNode*);
+   void subNodeRenamed();
+   void invalidateTreeIndex();
+   void buildTreeIndex(PHCompositeNode *);
+   // the index functions below expect the caller to hold the index lock
+   void updateIndexLocked();
+   const std::vector<PHNode*>* findInTreeIndex(const std::string &name);
    PHPointerList<PHNode> subNodes;
    int deleteMe;
 
+#ifndef __CINT__
+   // name -> direct subnode, kept in sync by addNode/forgetMe/prune
+   boost::unordered_map<std::string, PHNode*> subNodeIndex;
+   // name -> all nodes of this name in the sub tree in depth first
+   // order, rebuilt on the first lookup after the sub tree changed
+   boost::unordered_map<std::string, std::vector<PHNode*> > treeIndex;
+#endif
+   bool treeIndexValid;
+
 private:
    PHCompositeNode();
 }; 
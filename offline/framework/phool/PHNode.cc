@@ -1,6 +1,7 @@
 //  Author: Matthias Messer
 
 #include "PHNode.h"
+#include "PHCompositeNode.h"
 
 #include <cstdlib>
 #include <iostream>
@@ -82,6 +83,17 @@ PHNode::operator=(const PHNode&)
   exit(1);
 }
 
+void
+PHNode::setName(const string &n)
+{
+  name = n;
+  // the parent keeps an index of its subnodes by name
+  if (parent)
+    {
+      static_cast<PHCompositeNode*>(parent)->subNodeRenamed();
+    }
+}
+
 void
 PHNode::setResetFlag(const int val)
 {
@@ -32,7 +32,7 @@ public:
   const std::string getName() const { return name; }
 
   void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) {name = n;}
+  void setName(const std::string &n);
   void setObjectType(const std::string &type) {objecttype = type;} 
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
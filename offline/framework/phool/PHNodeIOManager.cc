@@ -11,6 +11,7 @@
 
 #include <TFile.h>
 #include <TTree.h>
+#include <TTreeCacheUnzip.h>
 #include <TBranchObject.h>
 #include <TObject.h>
 #include <TLeafObject.h>
@@ -26,6 +27,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <sstream>
@@ -41,6 +43,17 @@ PHNodeIOManager::PHNodeIOManager ():
   split(0),
   accessMode(PHReadOnly),
   CompressionLevel(3),
+  CompressionAlgorithm(0),
+  ReadCacheSize(0),
+  PrefetchDepth(0),
+  AsyncUnzip(false),
+  readtimer("PHNodeIOManager read"),
+  AsyncWriteDepth(0),
+  eventpending(false),
+  writerrunning(false),
+  stopwriter(false),
+  writerbusy(false),
+  asyncbyteswritten(0),
   isFunctionalFlag(0)
 {}
 
@@ -49,7 +62,18 @@ PHNodeIOManager::PHNodeIOManager (const string& f,
   file(NULL),
   tree(NULL),
   TreeName("T"),
-  CompressionLevel(3)
+  CompressionLevel(3),
+  CompressionAlgorithm(0),
+  ReadCacheSize(0),
+  PrefetchDepth(0),
+  AsyncUnzip(false),
+  readtimer("PHNodeIOManager read"),
+  AsyncWriteDepth(0),
+  eventpending(false),
+  writerrunning(false),
+  stopwriter(false),
+  writerbusy(false),
+  asyncbyteswritten(0)
 {
   isFunctionalFlag = setFile(f, "titled by PHOOL", a) ? 1 : 0;
 }
@@ -59,7 +83,18 @@ PHNodeIOManager::PHNodeIOManager (const string& f, const string& title,
   file(NULL),
   tree(NULL),
   TreeName("T"),
-  CompressionLevel(3)
+  CompressionLevel(3),
+  CompressionAlgorithm(0),
+  ReadCacheSize(0),
+  PrefetchDepth(0),
+  AsyncUnzip(false),
+  readtimer("PHNodeIOManager read"),
+  AsyncWriteDepth(0),
+  eventpending(false),
+  writerrunning(false),
+  stopwriter(false),
+  writerbusy(false),
+  asyncbyteswritten(0)
 {
   isFunctionalFlag = setFile(f, title , a) ? 1 : 0;
 }
@@ -69,7 +104,18 @@ PHNodeIOManager::PHNodeIOManager (const string& f, const PHAccessType a,
   file(NULL),
   tree(NULL),
   TreeName("T"),
-  CompressionLevel(3)
+  CompressionLevel(3),
+  CompressionAlgorithm(0),
+  ReadCacheSize(0),
+  PrefetchDepth(0),
+  AsyncUnzip(false),
+  readtimer("PHNodeIOManager read"),
+  AsyncWriteDepth(0),
+  eventpending(false),
+  writerrunning(false),
+  stopwriter(false),
+  writerbusy(false),
+  asyncbyteswritten(0)
 {
   if (treeindex != PHEventTree)
     {
@@ -93,6 +139,14 @@ PHNodeIOManager::~PHNodeIOManager ()
 void
 PHNodeIOManager::closeFile ()
 {
+  // an event which was written but not handed over yet goes out as
+  // a copy, the node objects may still be in use
+  if (eventpending)
+    {
+      QueueEvent(false);
+    }
+  // the background writer has to be done before the file is written
+  StopWriter();
   if (file)
     {
       if (accessMode == PHWrite || accessMode == PHUpdate)
@@ -131,6 +185,7 @@ PHNodeIOManager::setFile (const string& f, const string& title,
           return False;
         }
       file ->SetCompressionLevel(CompressionLevel);
+      SetCompressionAlgorithm(CompressionAlgorithm);
       tree = new TTree(TreeName.c_str(), title.c_str());
       tree->SetMaxTreeSize(900000000000LL); // set max size to ~900 GB
       gROOT->cd(currdir.c_str());
@@ -154,6 +209,7 @@ PHNodeIOManager::setFile (const string& f, const string& title,
           return False;
         }
       file ->SetCompressionLevel(CompressionLevel);
+      SetCompressionAlgorithm(CompressionAlgorithm);
       tree = new TTree(TreeName.c_str(), title.c_str());
       gROOT->cd(currdir.c_str());
       return True;
@@ -170,6 +226,30 @@ PHNodeIOManager::write(PHCompositeNode* topNode)
   // recursively call the write functions of its subnodes, thus
   // constructing the path-string which is then stored as name of the
   // Root-branch corresponding to the data of each PHRootIODataNode.
+  if (AsyncWriteDepth > 0 && file && tree)
+    {
+      // only note the persistent objects here, other output managers
+      // may still write them. HandOverEvent() passes them on to the
+      // background writer
+      if (!writerrunning)
+	{
+	  StartWriter();
+	}
+      // StartWriter falls back to synchronous writing if the thread
+      // could not be started
+      if (writerrunning)
+	{
+	  if (eventpending)
+	    {
+	      QueueEvent(false);
+	    }
+	  eventpending = true;
+	  topNode->write(this);
+	  eventNumber++;
+	  return True;
+	}
+    }
+
   topNode->write(this);
 
 
@@ -188,6 +268,26 @@ PHNodeIOManager::write(PHCompositeNode* topNode)
 
 PHBoolean
 PHNodeIOManager::write(TObject** data, const string& path)
+{
+  if (eventpending)
+    {
+      if (*data)
+	{
+	  PendingObject entry;
+	  entry.path = path;
+	  entry.slot = data;
+	  entry.object = *data;
+	  // the node name is the last part of the branch path
+	  entry.swap = (swapnodes.find(path.substr(path.rfind(phooldefs::branchpathdelim) + 1)) != swapnodes.end());
+	  pendingobjects.push_back(entry);
+	}
+      return True;
+    }
+  return WriteBranch(data, path);
+}
+
+PHBoolean
+PHNodeIOManager::WriteBranch(TObject** data, const string& path)
 {
   if (file && tree)
     {
@@ -339,9 +439,12 @@ PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   // to cd() in the current file before trying to fetch any event,
   // otherwise mixing of reading 2.25/03 DST with writing some
   // 3.01/05 trees will fail.
-  string currdir = gDirectory->GetPath();
+  // Keep the pointer, looking up the directory by its path
+  // for every event is not for free
+  TDirectory *currdir = gDirectory;
   TFile* file_ptr = gFile; // save current gFile
   file->cd();
+  readtimer.restart();
 
   if (requestedEvent)
     {
@@ -355,9 +458,10 @@ PHNodeIOManager::readEventFromFile(size_t requestedEvent)
       bytesRead = tree->GetEvent(eventNumber++);
     }
 
+  readtimer.stop();
   gFile = file_ptr; // recover gFile
-  gROOT->cd(currdir.c_str());
-   
+  currdir->cd();
+
   if (!bytesRead)
     {
       return False;
@@ -440,6 +544,10 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
 				static_cast<bool>(it->second));
 	}
     }
+  if (ReadCacheSize > 0 || PrefetchDepth > 0)
+    {
+      ConfigureReadCache();
+    }
   // The file contains a TTree with a list of the TBranchObjects
   // attached to it.
   TObjArray *branchArray = tree->GetListOfBranches();
@@ -600,13 +708,296 @@ PHNodeIOManager::SetCompressionLevel(const int level)
   return True;
 }
 
+PHBoolean
+PHNodeIOManager::SetCompressionAlgorithm(const int algorithm)
+{
+  if (algorithm < 0)
+    {
+      return False;
+    }
+  CompressionAlgorithm = algorithm;
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,12,0)
+  if (CompressionAlgorithm == 4)
+    {
+      cout << PHWHERE << " lz4 compression needs root 6.12, using zlib" << endl;
+      CompressionAlgorithm = 1;
+    }
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(5,30,0)
+  if (file && CompressionAlgorithm > 0)
+    {
+      file->SetCompressionAlgorithm(CompressionAlgorithm);
+    }
+#endif
+  return True;
+}
+
 double
 PHNodeIOManager::GetBytesWritten()
 {
+  if (writerrunning)
+    {
+      // the file is owned by the writer thread
+      pthread_mutex_lock(&writemutex);
+      double bytes = asyncbyteswritten;
+      pthread_mutex_unlock(&writemutex);
+      return bytes;
+    }
   if (file) return file->GetBytesWritten();
   return 0.;
 }
 
+void
+PHNodeIOManager::StartWriter()
+{
+  pthread_mutex_init(&writemutex, NULL);
+  pthread_cond_init(&writecond, NULL);
+  pthread_cond_init(&spacecond, NULL);
+  stopwriter = false;
+  writerbusy = false;
+  if (pthread_create(&writerthread, NULL, WriterThread, this))
+    {
+      cout << PHWHERE << " could not start writer thread, writing synchronously" << endl;
+      pthread_cond_destroy(&spacecond);
+      pthread_cond_destroy(&writecond);
+      pthread_mutex_destroy(&writemutex);
+      AsyncWriteDepth = 0;
+      return;
+    }
+  writerrunning = true;
+  return;
+}
+
+void
+PHNodeIOManager::FlushWrites()
+{
+  if (!writerrunning)
+    {
+      return;
+    }
+  pthread_mutex_lock(&writemutex);
+  while (!writequeue.empty() || writerbusy)
+    {
+      pthread_cond_wait(&spacecond, &writemutex);
+    }
+  pthread_mutex_unlock(&writemutex);
+  return;
+}
+
+void
+PHNodeIOManager::StopWriter()
+{
+  if (!writerrunning)
+    {
+      return;
+    }
+  pthread_mutex_lock(&writemutex);
+  stopwriter = true;
+  pthread_cond_signal(&writecond);
+  pthread_mutex_unlock(&writemutex);
+  // the writer empties the queue before it exits
+  pthread_join(writerthread, NULL);
+  writerrunning = false;
+  pthread_cond_destroy(&spacecond);
+  pthread_cond_destroy(&writecond);
+  pthread_mutex_destroy(&writemutex);
+  // the branch addresses are gone after this, but the file is
+  // written right after (and closed)
+  map<string, TObject *>::iterator iter;
+  for (iter = writeaddress.begin(); iter != writeaddress.end(); ++iter)
+    {
+      delete iter->second;
+    }
+  writeaddress.clear();
+  map<string, vector<TObject *> >::iterator spareiter;
+  for (spareiter = spareobjects.begin(); spareiter != spareobjects.end(); ++spareiter)
+    {
+      for (vector<TObject *>::iterator obj = spareiter->second.begin(); obj != spareiter->second.end(); ++obj)
+	{
+	  delete *obj;
+	}
+    }
+  spareobjects.clear();
+  return;
+}
+
+void
+PHNodeIOManager::HandOverEvent()
+{
+  if (eventpending)
+    {
+      QueueEvent(true);
+    }
+  return;
+}
+
+void
+PHNodeIOManager::QueueEvent(const bool swap)
+{
+  // objects the writer is done with, they replace the node objects
+  map<string, vector<TObject *> > spares;
+  if (swap)
+    {
+      pthread_mutex_lock(&writemutex);
+      spares.swap(spareobjects);
+      pthread_mutex_unlock(&writemutex);
+    }
+  WriteRecord *record = new WriteRecord();
+  vector<PendingObject>::const_iterator iter;
+  for (iter = pendingobjects.begin(); iter != pendingobjects.end(); ++iter)
+    {
+      if (!swap || !iter->swap || *(iter->slot) != iter->object)
+	{
+	  // no swapping (the default, modules may keep pointers to their
+	  // output objects), or another asynchronous output manager took
+	  // the node object already (it only reads it), write a copy
+	  record->push_back(make_pair(iter->path, iter->object->Clone()));
+	  continue;
+	}
+      // the writer gets the node object, the node gets a spare which is
+      // reset by the framework before the next event. Copies are only
+      // made until there are enough spares in circulation
+      vector<TObject *> &sparelist = spares[iter->path];
+      TObject *spare = NULL;
+      if (sparelist.empty())
+	{
+	  spare = iter->object->Clone();
+	}
+      else
+	{
+	  spare = sparelist.back();
+	  sparelist.pop_back();
+	}
+      *(iter->slot) = spare;
+      record->push_back(make_pair(iter->path, iter->object));
+    }
+  pendingobjects.clear();
+  eventpending = false;
+
+  pthread_mutex_lock(&writemutex);
+  // give back the spares which were not needed
+  map<string, vector<TObject *> >::iterator spareiter;
+  for (spareiter = spares.begin(); spareiter != spares.end(); ++spareiter)
+    {
+      vector<TObject *> &sparelist = spareobjects[spareiter->first];
+      sparelist.insert(sparelist.end(), spareiter->second.begin(), spareiter->second.end());
+    }
+  while (writequeue.size() >= (size_t) AsyncWriteDepth)
+    {
+      pthread_cond_wait(&spacecond, &writemutex);
+    }
+  writequeue.push_back(record);
+  pthread_cond_signal(&writecond);
+  pthread_mutex_unlock(&writemutex);
+  return;
+}
+
+void
+PHNodeIOManager::FillRecord(WriteRecord *record, WriteRecord &replaced)
+{
+  // the branches point to the entries of writeaddress, the previous
+  // object of a branch is kept until a new one replaces it, so a node
+  // which is missing in this event is written with its last content
+  // (as in the synchronous case where the node object is reused)
+  WriteRecord::iterator iter;
+  for (iter = record->begin(); iter != record->end(); ++iter)
+    {
+      TObject *&address = writeaddress[iter->first];
+      if (address)
+	{
+	  replaced.push_back(make_pair(iter->first, address));
+	}
+      address = iter->second;
+      WriteBranch(&address, iter->first);
+    }
+  tree->Fill();
+  delete record;
+  return;
+}
+
+void *
+PHNodeIOManager::WriterThread(void *arg)
+{
+  PHNodeIOManager *iomanager = static_cast<PHNodeIOManager *>(arg);
+  pthread_mutex_lock(&iomanager->writemutex);
+  while (true)
+    {
+      while (iomanager->writequeue.empty() && !iomanager->stopwriter)
+	{
+	  pthread_cond_wait(&iomanager->writecond, &iomanager->writemutex);
+	}
+      if (iomanager->writequeue.empty())
+	{
+	  break;
+	}
+      WriteRecord *record = iomanager->writequeue.front();
+      iomanager->writequeue.pop_front();
+      iomanager->writerbusy = true;
+      pthread_mutex_unlock(&iomanager->writemutex);
+
+      WriteRecord replaced;
+      iomanager->FillRecord(record, replaced);
+      double bytes = iomanager->file->GetBytesWritten();
+
+      pthread_mutex_lock(&iomanager->writemutex);
+      // the objects which are no branch address anymore become spares
+      for (WriteRecord::const_iterator iter = replaced.begin(); iter != replaced.end(); ++iter)
+	{
+	  iomanager->spareobjects[iter->first].push_back(iter->second);
+	}
+      iomanager->writerbusy = false;
+      iomanager->asyncbyteswritten = bytes;
+      pthread_cond_broadcast(&iomanager->spacecond);
+    }
+  pthread_mutex_unlock(&iomanager->writemutex);
+  return NULL;
+}
+
+void
+PHNodeIOManager::ConfigureReadCache()
+{
+  Long64_t cachesize = ReadCacheSize;
+  Long64_t nentries = tree->GetEntries();
+  if (PrefetchDepth > 0 && nentries > 0)
+    {
+      // average compressed size of an event (all branches, so this
+      // errs on the large side if only some branches are selected)
+      Long64_t eventsize = tree->GetZipBytes() / nentries + 1;
+      cachesize = max(cachesize, PrefetchDepth * eventsize);
+    }
+  if (AsyncUnzip)
+    {
+      // must be set before the cache is created
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+  // the cache learns the branches which are read during the first
+  // events, deselected branches are never read and stay out of it
+  tree->SetCacheSize(cachesize);
+  return;
+}
+
+double
+PHNodeIOManager::GetBytesRead() const
+{
+  if (file) return file->GetBytesRead();
+  return 0.;
+}
+
+void
+PHNodeIOManager::PrintReadStats() const
+{
+  cout << "PHNodeIOManager read statistics for " << filename << endl;
+  cout << "reads: " << readtimer.get_ncycle()
+       << ", time spent in reading (ms): " << readtimer.get_accumulated_time();
+  if (readtimer.get_ncycle())
+    {
+      cout << ", per read (ms): " << readtimer.get_time_per_cycle();
+    }
+  cout << endl;
+  cout << "bytes read from file: " << GetBytesRead() << endl;
+  return;
+}
+
 map<string, TBranch*> *
 PHNodeIOManager::GetBranchMap()
 {
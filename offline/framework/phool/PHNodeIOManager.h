@@ -6,8 +6,13 @@
 //  Author: Matthias Messer
 
 #include "PHIOManager.h"
+#include "PHTimer.h"
 #include <string>
 #include <map>
+#include <deque>
+#include <set>
+#include <vector>
+#include <pthread.h>
 
 
 class TObject;
@@ -36,15 +41,72 @@ public:
    PHBoolean isSelected(const char* objectName) ;
    int isFunctional() const {return isFunctionalFlag;}
    PHBoolean SetCompressionLevel(const int level);
+   // compression algorithm of the output file, one of root's
+   // ROOT::ECompressionAlgorithm values (1: zlib, 2: lzma, 4: lz4 which
+   // needs root 6.12 or later), 0 keeps the root default
+   PHBoolean SetCompressionAlgorithm(const int algorithm);
    double GetBytesWritten();
+
+   // asynchronous writing: write(PHCompositeNode *) notes the objects
+   // of the persistent nodes, HandOverEvent() gives copies of them to a
+   // background thread which does the TTree::Fill (streaming and
+   // compression). At most depth events are queued, 0 switches back to
+   // synchronous writing. Has to be set before the first event is
+   // written, it cannot be changed once the writer thread is running
+   void SetAsyncWrite(const int depth) {if (!writerrunning) AsyncWriteDepth = depth;}
+   // the object of this node is handed to the writer instead of a copy,
+   // the node gets a spare object of the same class (which held an
+   // earlier event and relies on Reset() to clear it). Only for nodes
+   // whose module looks up the object each event instead of keeping
+   // the pointer
+   void SwapNode(const std::string &nodename) {swapnodes.insert(nodename);}
+   // pass the objects of the event written last to the background
+   // writer, call after all output is done and before the nodes are reset
+   void HandOverEvent();
+   // wait until the background thread wrote all queued events
+   void FlushWrites();
    std::map<std::string,TBranch*> *GetBranchMap();
 
+   // read ahead settings, have to be set before the first event is read.
+   // The TTreeCache only picks up the branches which are actually read
+   // (so it follows selectObjectToRead), its size is the larger of the
+   // given size and the size needed to hold prefetchdepth events.
+   // With asyncunzip the cached baskets are decompressed in a
+   // background thread while the current event is processed
+   void SetReadCacheSize(const long long bytes) {ReadCacheSize = bytes;}
+   void SetPrefetchDepth(const int nevents) {PrefetchDepth = nevents;}
+   void SetAsyncUnzip(const bool flag) {AsyncUnzip = flag;}
+   // time spent waiting for reads (in ms) and number of reads
+   double GetReadTime() const {return readtimer.get_accumulated_time();}
+   unsigned int GetReadCalls() const {return readtimer.get_ncycle();}
+   double GetBytesRead() const;
+   void PrintReadStats() const;
+
 public:
    PHBoolean write(TObject**, const std::string&);
 private:
+   // the objects of one event for the background writer
+   typedef std::vector<std::pair<std::string, TObject *> > WriteRecord;
+   // a persistent object noted by write(), slot is the object pointer
+   // of its node
+   struct PendingObject
+   {
+     std::string path;
+     TObject **slot;
+     TObject *object;
+     bool swap;
+   };
+
+   PHBoolean WriteBranch(TObject**, const std::string&);
+   void StartWriter();
+   void StopWriter();
+   void QueueEvent(const bool swap);
+   void FillRecord(WriteRecord *record, WriteRecord &replaced);
+   static void *WriterThread(void *arg);
    int FillBranchMap();
    PHCompositeNode * reconstructNodeTree(PHCompositeNode *);
    PHBoolean readEventFromFile(size_t requestedEvent);
+   void ConfigureReadCache();
    std::string getBranchClassName(TBranch*) ;
 
   TFile *file;
@@ -54,8 +116,33 @@ private:
   int   split;
   int   accessMode;
   int   CompressionLevel;
+  int   CompressionAlgorithm;
   std::map<std::string,TBranch*> fBranches ;
   std::map<std::string,PHBoolean> objectToRead ;
+  long long ReadCacheSize;
+  int PrefetchDepth;
+  bool AsyncUnzip;
+  PHTimer readtimer;
+
+  int AsyncWriteDepth;
+  bool eventpending;
+  std::vector<PendingObject> pendingobjects;
+  std::set<std::string> swapnodes;
+  std::deque<WriteRecord *> writequeue;
+  // branch addresses of the background writer, they keep the last
+  // object written for each branch
+  std::map<std::string, TObject *> writeaddress;
+  // objects the writer is done with, handed to the nodes in exchange
+  // for the next event's objects
+  std::map<std::string, std::vector<TObject *> > spareobjects;
+  bool writerrunning;
+  bool stopwriter;
+  bool writerbusy;
+  double asyncbyteswritten;
+  pthread_t writerthread;
+  pthread_mutex_t writemutex;
+  pthread_cond_t writecond;
+  pthread_cond_t spacecond;
 
   int isFunctionalFlag;  // flag to tell if that object initialized properly
 
@@ -49,52 +49,15 @@ PHNodeIterator::print()
 PHNode*
 PHNodeIterator::findFirst(const string& requiredType, const string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode *thisNode;
-  while ((thisNode = iter()))
-    {
-      if (thisNode->getType() == requiredType && thisNode->getName() == requiredName)
-        {
-          return thisNode;
-        }
-      else
-        {
-          if (thisNode->getType() == "PHCompositeNode")
-            {
-              PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-              PHNode *nodeFoundInSubTree = nodeIter.findFirst(requiredType.c_str(), requiredName.c_str());
-              if (nodeFoundInSubTree) return nodeFoundInSubTree;
-            }
-        }
-    }
-  return 0;
+  // the composite node keeps a name index of its sub tree which gives
+  // the same result as a recursive depth first search
+  return currentNode->findInTree(requiredType, requiredName);
 }
 
 PHNode*
 PHNodeIterator::findFirst(const string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode *thisNode;
-  while ((thisNode = iter()))
-    {
-      if (thisNode->getName() == requiredName)
-        {
-          return thisNode;
-        }
-      else
-        {
-          if (thisNode->getType() == "PHCompositeNode")
-            {
-              PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-              PHNode *nodeFoundInSubTree = nodeIter.findFirst(requiredName.c_str());
-              if (nodeFoundInSubTree)
-                {
-                  return nodeFoundInSubTree;
-                }
-            }
-        }
-    }
-  return 0;
+  return currentNode->findInTree(requiredName);
 }
 
 PHBoolean
@@ -131,15 +94,12 @@ PHNodeIterator::cd(const string &pathString)
             }
           else
             {
-              PHPointerListIterator<PHNode> subNodeIter(currentNode->subNodes);
               pathFound = False;
-              while ((subNode = subNodeIter()))
+              subNode = currentNode->findSubNode(*iter);
+              if (subNode && subNode->getType() == "PHCompositeNode")
                 {
-                  if (subNode->getType() == "PHCompositeNode" && subNode->getName() == *iter)
-                    {
-                      currentNode = static_cast<PHCompositeNode*>(subNode);
-                      pathFound = True;
-                    }
+                  currentNode = static_cast<PHCompositeNode*>(subNode);
+                  pathFound = True;
                 }
               if (!pathFound)
                 {
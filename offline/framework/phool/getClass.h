@@ -15,10 +15,8 @@ class PHCompositeNode;
 namespace findNode
 {
   template <class T>
-    T* getClass(PHCompositeNode *top, const std::string &name)
+    T* getData(PHNode *FoundNode)
     {
-      PHNodeIterator iter(top);
-      PHNode *FoundNode = iter.findFirst(name.c_str()); // returns pointer to PHNode
       if (!FoundNode)
 	{
 	  return NULL;
@@ -55,6 +53,70 @@ namespace findNode
 
     return NULL;
   }
+
+  template <class T>
+    T* getClass(PHCompositeNode *top, const std::string &name)
+    {
+      PHNodeIterator iter(top);
+      PHNode *FoundNode = iter.findFirst(name.c_str()); // returns pointer to PHNode
+      return getData<T>(FoundNode);
+    }
+
+  /*! Typed handle to a node, look it up once in InitRun with
+      attach(topNode, name) and use get() in process_event. get()
+      does not search the node tree, the cast is only redone if the
+      node got a new data object (e.g. when reading a DST).
+      The node must not be deleted while the handle is in use.
+  */
+  template <class T>
+    class Handle
+    {
+    public:
+      Handle(): node(NULL), data(NULL), object(NULL) {}
+      Handle(PHCompositeNode *top, const std::string &name):
+        node(NULL), data(NULL), object(NULL)
+	{
+	  attach(top, name);
+	}
+
+      bool attach(PHCompositeNode *top, const std::string &name)
+      {
+	PHNodeIterator iter(top);
+	node = iter.findFirst(name);
+	if (node && node->getType() == "PHCompositeNode")
+	  {
+	    node = NULL;
+	  }
+	data = NULL;
+	object = NULL;
+	return (get() != NULL);
+      }
+
+      T* get()
+      {
+	if (!node)
+	  {
+	    return NULL;
+	  }
+	// all data nodes hold a pointer at the same place, compare
+	// the raw pointer to see if the data object was replaced
+	void *current = static_cast<PHDataNode<TObject>*>(node)->getData();
+	if (current != data)
+	  {
+	    data = current;
+	    object = getData<T>(node);
+	  }
+	return object;
+      }
+
+      T* operator->() {return get();}
+      bool isValid() {return (get() != NULL);}
+
+    private:
+      PHNode *node;
+      void *data;
+      T *object;
+    };
 }
 
 #endif /* GETCLASS_H */
@@ -5,6 +5,7 @@
 #include "HelixRange.h"
 #include "HelixResolution.h"
 #include "SimpleHit3D.h"
+#include "HitColumns.h"
 #include "SimpleTrack3D.h"
 #include "HelixKalmanState.h"
 #include <xmmintrin.h>
@@ -139,6 +140,16 @@ class HelixHough
     static void dzdlRange_sse(float* x_a, float* y_a, float* z_a, float cosphi1, float sinphi1, float cosphi2, float sinphi2, float min_k, float max_k, float min_d, float max_d, float* min_z0, float* max_z0, float* min_dzdl_a, float* max_dzdl_a);
     static void phiRange_sse(float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi, float* max_phi, float* min_phi_2, float* max_phi_2, float hel, __m128& phi_3_out, __m128& phi_4_out, float* hit_x_2, float* hit_y_2, __m128& phi_3_out_2, __m128& phi_4_out_2);
     static void phiRange_sse(float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi, float* max_phi, float* min_phi_2, float* max_phi_2, float hel, __m128& phi_3, __m128& phi_4, __m128& phi_3_out, __m128& phi_4_out, float* hit_x_2, float* hit_y_2, __m128& phi_3_2, __m128& phi_4_2, __m128& phi_3_out_2, __m128& phi_4_out_2);
+    // 8 hit versions, only to be called if HelixHoughISA::level() >= HelixHoughISA::AVX
+    static void dzdlRange_avx(float* x_a, float* y_a, float* z_a, float cosphi1, float sinphi1, float cosphi2, float sinphi2, float min_k, float max_k, float min_d, float max_d, float* min_z0, float* max_z0, float* min_dzdl_a, float* max_dzdl_a) __attribute__((target("avx")));
+    static void phiRange_avx(float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi_1, float* max_phi_1, float* min_phi_2, float* max_phi_2) __attribute__((target("avx")));
+    static void allButKappaRange_sse(float* x1_a,float* x2_a,float* y1_a,float* y2_a,float* z1_a,float* z2_a, float* min_k_a,float* max_k_a, float* min_phi_1_a,float* max_phi_1_a,float* min_phi_2_a,float* max_phi_2_a, float* min_d_1_a,float* max_d_1_a,float* min_d_2_a,float* max_d_2_a, float* min_dzdl_a,float* max_dzdl_a, float* min_z0_1_a,float* max_z0_1_a,float* min_z0_2_a,float* max_z0_2_a);
+    // 8 pair version, also only to be called if HelixHoughISA::level() >= HelixHoughISA::AVX
+    static void allButKappaRange_avx(float* x1_a,float* x2_a,float* y1_a,float* y2_a,float* z1_a,float* z2_a, float* min_k_a,float* max_k_a, float* min_phi_1_a,float* max_phi_1_a,float* min_phi_2_a,float* max_phi_2_a, float* min_d_1_a,float* max_d_1_a,float* min_d_2_a,float* max_d_2_a, float* min_dzdl_a,float* max_dzdl_a, float* min_z0_1_a,float* max_z0_1_a,float* min_z0_2_a,float* max_z0_2_a) __attribute__((target("avx")));
+    // scalar references of the range kernels for n hits or pairs
+    static void phiRange_scalar(unsigned int n, float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi_1, float* max_phi_1, float* min_phi_2, float* max_phi_2);
+    static void allButKappaRange_scalar(unsigned int n, float* x1_a,float* x2_a,float* y1_a,float* y2_a,float* z1_a,float* z2_a, float* min_k_a,float* max_k_a, float* min_phi_1_a,float* max_phi_1_a,float* min_phi_2_a,float* max_phi_2_a, float* min_d_1_a,float* max_d_1_a,float* min_d_2_a,float* max_d_2_a, float* min_dzdl_a,float* max_dzdl_a, float* min_z0_1_a,float* max_z0_1_a,float* min_z0_2_a,float* max_z0_2_a);
+    static void dzdlRange_scalar(unsigned int n, float* x_a, float* y_a, float* z_a, float cosphi1, float sinphi1, float cosphi2, float sinphi2, float min_k, float max_k, float min_d, float max_d, float* min_z0, float* max_z0, float* min_dzdl_a, float* max_dzdl_a);
     
     void setPrintTimings(bool pt){print_timings=pt;}
     
@@ -196,6 +207,12 @@ class HelixHough
     void setCullInputHits( bool cih ){ cull_input_hits = cih; }
     void setIterateClustering( bool icl ){ iterate_clustering = icl; }
     
+    // bins of the start zoom level which would be zoomed into again and
+    // have more than nhits hits are not searched but copied to ranges and
+    // hits, so they can be searched separately (by another thread).
+    // NULL turns this off.
+    void setDeferBins(unsigned int nhits, std::vector<HelixRange>* ranges, std::vector<std::vector<SimpleHit3D> >* hits){defer_min_hits = nhits; defer_ranges = ranges; defer_hits = hits;}
+    
   protected:
     bool remove_hits;
     std::vector<unsigned int>* hit_used;
@@ -212,6 +229,8 @@ class HelixHough
     std::vector<SimpleHit3D>* base_hits;
     // vector of hits used for isolating hits in a single zoom level
     std::vector<std::vector<SimpleHit3D>* > hits_vec;
+    // aligned columns of the hits of the zoom level being voted on
+    HitColumns hit_columns;
     // for each zoomlevel, a vector of pair indexes, with the index mapping to the entry position in hits_vec
     std::vector<std::vector<std::pair<unsigned int,unsigned int> >* > pairs_vec;
     // stores external index values
@@ -256,10 +275,7 @@ class HelixHough
     unsigned int start_zoom; // top-level zoomlevel : defaults to zero
     
     
-    static void allButKappaRange_sse(float* x1_a,float* x2_a,float* y1_a,float* y2_a,float* z1_a,float* z2_a, float* min_k_a,float* max_k_a, float* min_phi_1_a,float* max_phi_1_a,float* min_phi_2_a,float* max_phi_2_a, float* min_d_1_a,float* max_d_1_a,float* min_d_2_a,float* max_d_2_a, float* min_dzdl_a,float* max_dzdl_a, float* min_z0_1_a,float* max_z0_1_a,float* min_z0_2_a,float* max_z0_2_a);
-    
-    
-    void fillBins(unsigned int total_bins, unsigned int hit_counter, float* min_phi_a, float* max_phi_a, std::vector<SimpleHit3D>& four_hits, fastvec2d& z_bins, unsigned int n_d, unsigned int n_k, unsigned int n_dzdl, unsigned int n_z0, unsigned int d_bin, unsigned int k_bin, unsigned int n_phi, unsigned int zoomlevel, float low_phi, float high_phi, float inv_phi_range, fastvec& vote_array);
+    void fillBins(unsigned int total_bins, unsigned int hit_counter, float* min_phi_a, float* max_phi_a, unsigned int first_hit, fastvec2d& z_bins, unsigned int n_d, unsigned int n_k, unsigned int n_dzdl, unsigned int n_z0, unsigned int d_bin, unsigned int k_bin, unsigned int n_phi, unsigned int zoomlevel, float low_phi, float high_phi, float inv_phi_range, fastvec& vote_array);
     
     void makeClusters(unsigned int zoomlevel, unsigned int MAX, unsigned int n_phi, unsigned int n_d, unsigned int n_k, unsigned int n_dzdl, unsigned int n_z0, unsigned int min_hits, std::vector<ParameterCluster>& clusters, bool& use_clusters, bool& is_super_bin);
     
@@ -273,6 +289,7 @@ class HelixHough
     void fillBins(unsigned int total_bins, unsigned int pair_counter, unsigned int* pair_index, float* min_phi, float* max_phi, float* min_d, float* max_d, float* min_dzdl, float* max_dzdl, float* min_z0, float* max_z0, std::vector<std::vector<SimpleHit3D> > & four_pairs, unsigned int n_d, unsigned int n_k, unsigned int n_dzdl, unsigned int n_z0, unsigned int k_bin, unsigned int n_phi, unsigned int zoomlevel, float low_phi, float high_phi, float low_d, float high_d, float low_z0, float high_z0, float low_dzdl, float high_dzdl, float inv_phi_range, float inv_d_range, float inv_z0_range, float inv_dzdl_range, fastvec& vote_array);
     void findHelicesByPairsBegin(unsigned int min_hits, unsigned int max_hits, std::vector<SimpleTrack3D>& tracks, unsigned int maxtracks, unsigned int zoomlevel);
     void findHelicesByPairs(unsigned int min_hits, unsigned int max_hits, std::vector<SimpleTrack3D>& tracks, unsigned int maxtracks, unsigned int zoomlevel);
+    bool deferBin(unsigned int zoomlevel);
     
     unsigned int max_hits_pairs;
     
@@ -294,6 +311,10 @@ class HelixHough
     bool smooth_back;
     bool cull_input_hits;
     bool iterate_clustering;
+    
+    unsigned int defer_min_hits;
+    std::vector<HelixRange>* defer_ranges;
+    std::vector<std::vector<SimpleHit3D> >* defer_hits;
 };
 
 #endif
@@ -0,0 +1,79 @@
+#include "HelixHoughISA.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+
+static HelixHoughISA::Level detectLevel()
+{
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f")){return HelixHoughISA::AVX512;}
+  if(__builtin_cpu_supports("avx2")){return HelixHoughISA::AVX2;}
+  if(__builtin_cpu_supports("avx")){return HelixHoughISA::AVX;}
+  return HelixHoughISA::SSE2;
+}
+
+
+static HelixHoughISA::Level initialLevel()
+{
+  HelixHoughISA::Level l = HelixHoughISA::detected();
+  const char* env = getenv("HELIXHOUGH_ISA");
+  if(env == NULL){return l;}
+  for(int i=HelixHoughISA::SSE2;i<=HelixHoughISA::AVX512;++i)
+  {
+    if(strcmp(env, HelixHoughISA::name((HelixHoughISA::Level)i)) == 0)
+    {
+      if(i < l){l = (HelixHoughISA::Level)i;}
+      break;
+    }
+  }
+  return l;
+}
+
+
+static HelixHoughISA::Level& currentLevel()
+{
+  static HelixHoughISA::Level current = initialLevel();
+  return current;
+}
+
+
+HelixHoughISA::Level HelixHoughISA::detected()
+{
+  static Level cpu = detectLevel();
+  return cpu;
+}
+
+
+HelixHoughISA::Level HelixHoughISA::level()
+{
+  return currentLevel();
+}
+
+
+void HelixHoughISA::setLevel(Level l)
+{
+  if(l > detected()){l = detected();}
+  currentLevel() = l;
+}
+
+
+HelixHoughISA::Level HelixHoughISA::kernels()
+{
+  if(level() >= AVX){return AVX;}
+  return SSE2;
+}
+
+
+const char* HelixHoughISA::name(Level l)
+{
+  switch(l)
+  {
+    case SSE2: return "sse2";
+    case AVX: return "avx";
+    case AVX2: return "avx2";
+    case AVX512: return "avx512";
+  }
+  return "unknown";
+}
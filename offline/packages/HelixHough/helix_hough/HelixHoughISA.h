@@ -0,0 +1,31 @@
+#ifndef __HELIXHOUGHISA__
+#define __HELIXHOUGHISA__
+
+
+// instruction set used by the SIMD kernels, chosen at run time from cpuid.
+// The library itself is built for SSE2; the 8 wide AVX kernels
+// (phiRange_avx, dzdlRange_avx, allButKappaRange_avx,
+// calculateKappaTangents_avx) are compiled with a
+// function level target attribute and only called when level() allows it.
+// AVX2 and AVX-512 nodes run the AVX kernels.
+// The environment variable HELIXHOUGH_ISA (sse2, avx, avx2, avx512) lowers
+// the level, e.g. to compare results between nodes.
+class HelixHoughISA
+{
+  public:
+    enum Level {SSE2=0, AVX=1, AVX2=2, AVX512=3};
+
+    // best level supported by the cpu and the operating system
+    static Level detected();
+    // level used by the kernels
+    static Level level();
+    // set the level used by the kernels, capped at detected()
+    static void setLevel(Level l);
+    // widest kernels run at level(), there are no AVX2 or AVX-512 kernels
+    static Level kernels();
+
+    static const char* name(Level l);
+};
+
+
+#endif
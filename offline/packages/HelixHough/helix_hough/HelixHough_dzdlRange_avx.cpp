@@ -0,0 +1,186 @@
+#include "vector_math_inline_avx.h"
+#include "HelixHough.h"
+#include <math.h>
+
+using namespace std;
+
+
+static const __m256 one_o_100_256 = {0.01,0.01,0.01,0.01,0.01,0.01,0.01,0.01};
+static const __m256 close_one_256 = {0.999,0.999,0.999,0.999,0.999,0.999,0.999,0.999};
+static const __m256 two_256 = {2., 2., 2., 2., 2., 2., 2., 2.};
+static const __m256 four_256 = {4., 4., 4., 4., 4., 4., 4., 4.};
+static const __m256 one_o_3_256 = {0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333, 0.3333333333333333333};
+static const __m256 _3_o_20_256 = {0.15, 0.15, 0.15, 0.15, 0.15, 0.15, 0.15, 0.15};
+static const __m256 _5_o_56_256 = {8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02, 8.92857142857142877e-02};
+static const __m256 SIGNMASK_256 = {-0., -0., -0., -0., -0., -0., -0., -0.};
+
+
+// 8 hit version of dzdlRange_sse, the operations are the same lane by lane
+void HelixHough::dzdlRange_avx(float* x_a, float* y_a, float* z_a, float cosphi1, float sinphi1, float cosphi2, float sinphi2, float min_k_val, float max_k_val, float min_d_val, float max_d_val, float* min_z0_val, float* max_z0_val, float* min_dzdl_a, float* max_dzdl_a)
+{
+  __m256 x = _mm256_load_ps(x_a);
+  __m256 y = _mm256_load_ps(y_a);
+  __m256 z = _mm256_load_ps(z_a);
+  
+  __m256 cosphi_min = _mm256_set1_ps(cosphi1);
+  __m256 cosphi_max = _mm256_set1_ps(cosphi2);
+  __m256 sinphi_min = _mm256_set1_ps(sinphi1);
+  __m256 sinphi_max = _mm256_set1_ps(sinphi2);
+  
+  __m256 min_k = _mm256_set1_ps(min_k_val);
+  __m256 max_k = _mm256_set1_ps(max_k_val);
+  __m256 min_d = _mm256_set1_ps(min_d_val);
+  __m256 max_d = _mm256_set1_ps(max_d_val);
+  __m256 min_z0 = _mm256_load_ps((min_z0_val));
+  __m256 max_z0 = _mm256_load_ps((max_z0_val));
+  
+  __m256 d = min_d;                                            __m256 d_2 = max_d;
+  __m256 k = min_k;                                            __m256 k_2 = max_k;
+  __m256 dx = _mm256_mul_ps(cosphi_min, d);                       __m256 dx_2 = _mm256_mul_ps(cosphi_max,d_2);
+  __m256 dy = _mm256_mul_ps(sinphi_min,d);                        __m256 dy_2 = _mm256_mul_ps(sinphi_max,d_2);
+  __m256 D = _mm256_sub_ps(x, dx);                                __m256 D_2 = _mm256_sub_ps(x, dx_2);
+  D = _mm256_mul_ps(D, D);                                        D_2 = _mm256_mul_ps(D_2, D_2);
+  __m256 tmp1 = _mm256_sub_ps(y, dy);                             __m256 tmp1_2 = _mm256_sub_ps(y, dy_2);
+  tmp1 = _mm256_mul_ps(tmp1, tmp1);                               tmp1_2 = _mm256_mul_ps(tmp1_2, tmp1_2);
+  D = _mm256_add_ps(D, tmp1);                                     D_2 = _mm256_add_ps(D_2, tmp1_2);
+  D = _vec256_sqrt_ps(D);                                         D_2 = _vec256_sqrt_ps(D_2);
+  __m256 v = _mm256_mul_ps(one_o_2_256, k);                           __m256 v_2 = _mm256_mul_ps(one_o_2_256, k_2);
+  v = _mm256_mul_ps(v, D);                                        v_2 = _mm256_mul_ps(v_2, D_2);
+  //if(v > 0.999){v = 0.999;}                                  //if(v > 0.999){v = 0.999;}
+  tmp1 = _mm256_cmpgt_ps(v, close_one_256);                           tmp1_2 = _mm256_cmpgt_ps(v_2, close_one_256);
+  __m256 tmp2 = _mm256_and_ps(tmp1, close_one_256);                   __m256 tmp2_2 = _mm256_and_ps(tmp1_2, close_one_256);
+  __m256 tmp3 = _mm256_andnot_ps(tmp1, v);                        __m256 tmp3_2 = _mm256_andnot_ps(tmp1_2, v_2);
+  v = _mm256_xor_ps(tmp2, tmp3);                                  v_2 = _mm256_xor_ps(tmp2_2, tmp3_2);
+  __m256 one_o_v = _vec256_rec_ps(v);                          __m256 one_o_v_2 = _vec256_rec_ps(v_2);
+  //power series assuming v_v is small                         //power series assuming v_v is small
+  __m256 s = zero_256;                                             __m256 s_2 = zero_256;
+  __m256 temp1 = _mm256_mul_ps(v, v);                             __m256 temp1_2 = _mm256_mul_ps(v_2, v_2);
+  __m256 temp2 = _mm256_mul_ps(one_o_2_256, D);                       __m256 temp2_2 = _mm256_mul_ps(one_o_2_256, D_2);
+  tmp1 = _mm256_mul_ps(two_256, temp2);                               tmp1_2 = _mm256_mul_ps(two_256, temp2_2);
+  s = _mm256_add_ps(s, tmp1);                                     s_2 = _mm256_add_ps(s_2, tmp1_2);
+  temp2 = _mm256_mul_ps(temp2, temp1);                            temp2_2 = _mm256_mul_ps(temp2_2, temp1_2);
+  tmp1 = _mm256_mul_ps(temp2, one_o_3_256);                           tmp1_2 = _mm256_mul_ps(temp2_2, one_o_3_256);
+  s = _mm256_add_ps(s, tmp1);                                     s_2 = _mm256_add_ps(s_2, tmp1_2);
+  temp2 = _mm256_mul_ps(temp2, temp1);                            temp2_2 = _mm256_mul_ps(temp2_2, temp1_2);
+  tmp1 = _mm256_mul_ps(temp2, _3_o_20_256);                           tmp1_2 = _mm256_mul_ps(temp2_2, _3_o_20_256);
+  s = _mm256_add_ps(s, tmp1);                                     s_2 = _mm256_add_ps(s_2, tmp1_2);
+  temp2 = _mm256_mul_ps(temp2, temp1);                            temp2_2 = _mm256_mul_ps(temp2_2, temp1_2);
+  tmp1 = _mm256_mul_ps(temp2, _5_o_56_256);                           tmp1_2 = _mm256_mul_ps(temp2_2, _5_o_56_256);
+  s = _mm256_add_ps(s, tmp1);                                     s_2 = _mm256_add_ps(s_2, tmp1_2);
+  ////////////////////////////////////                         ////////////////////////////////////
+  //otherwise we calculate an arcsin                           //otherwise we calculate an arcsin
+  //asin(x) = 2*atan( x/( 1 + sqrt( 1 - x*x ) ) )              //asin(x) = 2*atan( x/( 1 + sqrt( 1 - x*x ) ) )
+  //s = 2*asin(v)/k                                            //s = 2*asin(v)/k
+  tmp1 = _mm256_mul_ps(v, v);                                     tmp1_2 = _mm256_mul_ps(v_2, v_2);
+  tmp1 = _mm256_sub_ps(one_256, tmp1);                                tmp1_2 = _mm256_sub_ps(one_256, tmp1_2);
+  tmp1 = _vec256_sqrt_ps(tmp1);                                   tmp1_2 = _vec256_sqrt_ps(tmp1_2);
+  tmp1 = _mm256_add_ps(one_256, tmp1);                                tmp1_2 = _mm256_add_ps(one_256, tmp1_2);
+  tmp1 = _mm256_mul_ps(tmp1, one_o_v);                            tmp1_2 = _mm256_mul_ps(tmp1_2, one_o_v_2);
+  tmp2 = _vec256_atan_ps(tmp1);                                   tmp2_2 = _vec256_atan_ps(tmp1_2);
+  tmp2 = _mm256_sub_ps(pi_over_two_256, tmp2);                        tmp2_2 = _mm256_sub_ps(pi_over_two_256, tmp2_2);
+  tmp2 = _mm256_mul_ps(four_256, tmp2);                               tmp2_2 = _mm256_mul_ps(four_256, tmp2_2);
+  tmp2 = _mm256_mul_ps(tmp2, one_o_v);                            tmp2_2 = _mm256_mul_ps(tmp2_2, one_o_v_2);
+  tmp2 = _mm256_mul_ps(tmp2, D);                                  tmp2_2 = _mm256_mul_ps(tmp2_2, D_2);
+  tmp2 = _mm256_mul_ps(tmp2, one_o_2_256);                            tmp2_2 = _mm256_mul_ps(tmp2_2, one_o_2_256);
+  ////////////////////////////////////                         ////////////////////////////////////
+  //choose between the two_256 methods to calculate s              //choose between the two_256 methods to calculate s
+  tmp1 = _mm256_cmpgt_ps(v, one_o_100_256);                           tmp1_2 = _mm256_cmpgt_ps(v_2, one_o_100_256);
+  tmp3 = _mm256_and_ps(tmp1, tmp2);                               tmp3_2 = _mm256_and_ps(tmp1_2, tmp2_2);
+  tmp2 = _mm256_andnot_ps(tmp1, s);                               tmp2_2 = _mm256_andnot_ps(tmp1_2, s_2);
+  __m256 s1 = _mm256_xor_ps(tmp3, tmp2);                          __m256 s2 = _mm256_xor_ps(tmp3_2, tmp2_2);
+  
+  
+  
+  
+  ////////////////////////////////////
+  __m256 dz2 = _mm256_sub_ps(z, max_z0);
+  dz2 = _mm256_mul_ps(dz2, dz2);
+  tmp1 = _mm256_mul_ps(s1, s1);
+  tmp1 = _mm256_add_ps(tmp1, dz2);
+  __m256 dzdl_1 = _mm256_div_ps(dz2, tmp1);
+  dzdl_1 = _vec256_sqrt_ps(dzdl_1);
+  //if z < max_z0, dzdl = -dzdl_1
+  tmp1 = _mm256_cmplt_ps(z, max_z0);
+  tmp2 = _mm256_xor_ps(dzdl_1, SIGNMASK_256);
+  tmp3 = _mm256_and_ps(tmp1, tmp2);
+  dzdl_1 = _mm256_andnot_ps(tmp1, dzdl_1);
+  dzdl_1 = _mm256_xor_ps(dzdl_1, tmp3);
+  
+  ////////////////////////////////////
+  dz2 = _mm256_sub_ps(z, min_z0);
+  dz2 = _mm256_mul_ps(dz2, dz2);
+  tmp1 = _mm256_mul_ps(s1, s1);
+  tmp1 = _mm256_add_ps(tmp1, dz2);
+  __m256 dzdl_2 = _mm256_div_ps(dz2, tmp1);
+  dzdl_2 = _vec256_sqrt_ps(dzdl_2);
+  //if z < min_z0, dzdl = -dzdl_2
+  tmp1 = _mm256_cmplt_ps(z, min_z0);
+  tmp2 = _mm256_xor_ps(dzdl_2, SIGNMASK_256);
+  tmp3 = _mm256_and_ps(tmp1, tmp2);
+  dzdl_2 = _mm256_andnot_ps(tmp1, dzdl_2);
+  dzdl_2 = _mm256_xor_ps(dzdl_2, tmp3);
+  
+  ////////////////////////////////////
+  dz2 = _mm256_sub_ps(z, max_z0);
+  dz2 = _mm256_mul_ps(dz2, dz2);
+  tmp1 = _mm256_mul_ps(s2, s2);
+  tmp1 = _mm256_add_ps(tmp1, dz2);
+  __m256 dzdl_3 = _mm256_div_ps(dz2, tmp1);
+  dzdl_3 = _vec256_sqrt_ps(dzdl_3);
+  //if z < max_z0, dzdl = -dzdl_3
+  tmp1 = _mm256_cmplt_ps(z, max_z0);
+  tmp2 = _mm256_xor_ps(dzdl_3, SIGNMASK_256);
+  tmp3 = _mm256_and_ps(tmp1, tmp2);
+  dzdl_3 = _mm256_andnot_ps(tmp1, dzdl_3);
+  dzdl_3 = _mm256_xor_ps(dzdl_3, tmp3);
+  
+  ////////////////////////////////////
+  dz2 = _mm256_sub_ps(z, min_z0);
+  dz2 = _mm256_mul_ps(dz2, dz2);
+  tmp1 = _mm256_mul_ps(s2, s2);
+  tmp1 = _mm256_add_ps(tmp1, dz2);
+  __m256 dzdl_4 = _mm256_div_ps(dz2, tmp1);
+  dzdl_4 = _vec256_sqrt_ps(dzdl_4);
+  //if z < min_z0, dzdl = -dzdl_4
+  tmp1 = _mm256_cmplt_ps(z, min_z0);
+  tmp2 = _mm256_xor_ps(dzdl_4, SIGNMASK_256);
+  tmp3 = _mm256_and_ps(tmp1, tmp2);
+  dzdl_4 = _mm256_andnot_ps(tmp1, dzdl_4);
+  dzdl_4 = _mm256_xor_ps(dzdl_4, tmp3);
+  
+  
+  
+  
+  __m256 dzdl_max = dzdl_1;
+  tmp1 = _mm256_cmpgt_ps(dzdl_2, dzdl_max);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_2);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_max);
+  dzdl_max = _mm256_xor_ps(tmp2, tmp3);
+  tmp1 = _mm256_cmpgt_ps(dzdl_3, dzdl_max);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_3);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_max);
+  dzdl_max = _mm256_xor_ps(tmp2, tmp3);
+  tmp1 = _mm256_cmpgt_ps(dzdl_4, dzdl_max);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_4);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_max);
+  dzdl_max = _mm256_xor_ps(tmp2, tmp3);
+  
+  __m256 dzdl_min = dzdl_1;
+  tmp1 = _mm256_cmplt_ps(dzdl_2, dzdl_min);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_2);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_min);
+  dzdl_min = _mm256_xor_ps(tmp2, tmp3);
+  tmp1 = _mm256_cmplt_ps(dzdl_3, dzdl_min);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_3);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_min);
+  dzdl_min = _mm256_xor_ps(tmp2, tmp3);
+  tmp1 = _mm256_cmplt_ps(dzdl_4, dzdl_min);
+  tmp2 = _mm256_and_ps(tmp1, dzdl_4);
+  tmp3 = _mm256_andnot_ps(tmp1, dzdl_min);
+  dzdl_min = _mm256_xor_ps(tmp2, tmp3);
+  
+  
+  
+  _mm256_store_ps(min_dzdl_a, dzdl_min);
+  _mm256_store_ps(max_dzdl_a, dzdl_max);
+}
@@ -460,7 +460,7 @@ void HelixHough::findHelices(unsigned int min_hits, unsigned int max_hits, vecto
           {
             findHelicesByPairsBegin(min_hits, max_hits, tracks, maxtracks, zoomlevel+1);
           }
-          else
+          else if(deferBin(zoomlevel+1) == false)
           {
             findHelices(min_hits, max_hits, tracks, maxtracks, zoomlevel+1);
           }
@@ -520,7 +520,7 @@ void HelixHough::findHelices(unsigned int min_hits, unsigned int max_hits, vecto
       {
         findHelicesByPairsBegin(min_hits, max_hits, tracks, maxtracks, zoomlevel+1);
       }
-      else
+      else if(deferBin(zoomlevel+1) == false)
       {
         findHelices(min_hits, max_hits, tracks, maxtracks, zoomlevel+1);
       }
@@ -529,6 +529,23 @@ void HelixHough::findHelices(unsigned int min_hits, unsigned int max_hits, vecto
 }
 
 
+// hands the hits of the next zoom level out instead of searching them,
+// see setDeferBins
+bool HelixHough::deferBin(unsigned int zoomlevel)
+{
+  if( (defer_hits == NULL) || (zoomlevel != (start_zoom+1)) || (hits_vec[zoomlevel]->size() <= defer_min_hits) ){return false;}
+  
+  defer_ranges->push_back(zoomranges[zoomlevel]);
+  defer_hits->push_back(*(hits_vec[zoomlevel]));
+  vector<SimpleHit3D>& dhits = defer_hits->back();
+  for(unsigned int i=0;i<dhits.size();++i)
+  {
+    dhits[i].index = index_mapping[dhits[i].index];
+  }
+  return true;
+}
+
+
 void HelixHough::findSeededHelices(vector<SimpleTrack3D>& seeds, vector<SimpleHit3D>& hits, unsigned int min_hits, unsigned int max_hits, vector<SimpleTrack3D>& tracks, unsigned int maxtracks)
 {
   unsigned int n_layers_orig = n_layers;
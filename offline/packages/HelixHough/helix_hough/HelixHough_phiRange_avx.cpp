@@ -0,0 +1,452 @@
+#include "vector_math_inline_avx.h"
+#include "HelixHough.h"
+#include <cmath>
+
+using namespace std;
+
+
+static const __m256 two_256 = {2., 2., 2., 2., 2., 2., 2., 2.};
+static const __m256 three_pi_over_two_256 = {3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f, 3.*0x1.921fb54442d1846ap0f};
+
+// 8 hit version of phiRange_sse, the operations are the same lane by lane
+void HelixHough::phiRange_avx(float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi_1, float* max_phi_1, float* min_phi_2, float* max_phi_2)
+{
+  __m256 x = _mm256_load_ps(hit_x);
+  __m256 y = _mm256_load_ps(hit_y);
+  
+  __m256 hit_phi = _vec256_atan2_ps(y,x);
+  //if phi < 0, phi += 2*pi
+  __m256 tmp1 = _mm256_cmplt_ps(hit_phi, zero_256);
+  __m256 tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  hit_phi = _mm256_add_ps(hit_phi, tmp1);
+  
+  // min_d, min_k
+  __m256 d = _mm256_load_ps(min_d);
+  __m256 k = _mm256_load_ps(min_k);
+  __m256 D = _mm256_mul_ps(x,x);
+  tmp1 = _mm256_mul_ps(y,y);
+  D = _mm256_add_ps(D,tmp1);
+  D = _vec256_sqrt_ps(D);
+  __m256 D_inv = _vec256_rec_ps(D);
+  __m256 ak = d;
+  ak = _mm256_mul_ps(d, two_256);
+  tmp1 = _mm256_mul_ps(d,d);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  tmp1 = _mm256_mul_ps(D,D);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  ak = _mm256_mul_ps(ak, D_inv);
+  ak = _mm256_mul_ps(ak, one_o_2_256);
+  __m256 hk = _mm256_mul_ps(d,k);
+  hk = _mm256_add_ps(hk, one_256);
+  hk = _mm256_mul_ps(hk,hk);
+  tmp1 = _mm256_mul_ps(ak,ak);
+  hk = _mm256_sub_ps(hk, tmp1);
+  __m256 neg = _mm256_cmple_ps(hk, zero_256);
+  hk = _vec256_sqrt_ps(hk);
+  
+  __m256 xk1 = _mm256_mul_ps(ak, x);
+  tmp1 = _mm256_mul_ps(hk,y);
+  __m256 xk2 = _mm256_sub_ps(xk1, tmp1);
+  xk1 = _mm256_add_ps(xk1, tmp1);
+  xk1 = _mm256_mul_ps(xk1, D_inv);
+  xk2 = _mm256_mul_ps(xk2, D_inv);
+  
+  __m256 yk1 = _mm256_mul_ps(ak, y);
+  tmp1 = _mm256_mul_ps(hk,x);
+  __m256 yk2 = _mm256_add_ps(yk1, tmp1);
+  yk1 = _mm256_sub_ps(yk1, tmp1);
+  yk1 = _mm256_mul_ps(yk1, D_inv);
+  yk2 = _mm256_mul_ps(yk2, D_inv);
+  
+  __m256 phi_r_1 = _vec256_atan2_ps(yk1, xk1);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_r_1, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_r_1 = _mm256_add_ps(phi_r_1, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_r_1 = _mm256_andnot_ps(neg, phi_r_1);
+  phi_r_1 = _mm256_xor_ps(tmp1, phi_r_1);
+  
+  __m256 phi_l_1 = _vec256_atan2_ps(yk2, xk2);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_l_1, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_l_1 = _mm256_add_ps(phi_l_1, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_l_1 = _mm256_andnot_ps(neg, phi_l_1);
+  phi_l_1 = _mm256_xor_ps(tmp1, phi_l_1);
+  
+  
+  // min_d, max_k
+  d = _mm256_load_ps(min_d);
+  k = _mm256_load_ps(max_k);
+  D = _mm256_mul_ps(x,x);
+  tmp1 = _mm256_mul_ps(y,y);
+  D = _mm256_add_ps(D,tmp1);
+  D = _vec256_sqrt_ps(D);
+  D_inv = _vec256_rec_ps(D);
+  ak = d;
+  ak = _mm256_mul_ps(d, two_256);
+  tmp1 = _mm256_mul_ps(d,d);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  tmp1 = _mm256_mul_ps(D,D);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  ak = _mm256_mul_ps(ak, D_inv);
+  ak = _mm256_mul_ps(ak, one_o_2_256);
+  hk = _mm256_mul_ps(d,k);
+  hk = _mm256_add_ps(hk, one_256);
+  hk = _mm256_mul_ps(hk,hk);
+  tmp1 = _mm256_mul_ps(ak,ak);
+  hk = _mm256_sub_ps(hk, tmp1);
+  neg = _mm256_cmple_ps(hk, zero_256);
+  hk = _vec256_sqrt_ps(hk);
+  
+  xk1 = _mm256_mul_ps(ak, x);
+  tmp1 = _mm256_mul_ps(hk,y);
+  xk2 = _mm256_sub_ps(xk1, tmp1);
+  xk1 = _mm256_add_ps(xk1, tmp1);
+  xk1 = _mm256_mul_ps(xk1, D_inv);
+  xk2 = _mm256_mul_ps(xk2, D_inv);
+  
+  yk1 = _mm256_mul_ps(ak, y);
+  tmp1 = _mm256_mul_ps(hk,x);
+  yk2 = _mm256_add_ps(yk1, tmp1);
+  yk1 = _mm256_sub_ps(yk1, tmp1);
+  yk1 = _mm256_mul_ps(yk1, D_inv);
+  yk2 = _mm256_mul_ps(yk2, D_inv);
+  
+  __m256 phi_r_2 = _vec256_atan2_ps(yk1, xk1);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_r_2, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_r_2 = _mm256_add_ps(phi_r_2, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_r_2 = _mm256_andnot_ps(neg, phi_r_2);
+  phi_r_2 = _mm256_xor_ps(tmp1, phi_r_2);
+  
+  __m256 phi_l_2 = _vec256_atan2_ps(yk2, xk2);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_l_2, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_l_2 = _mm256_add_ps(phi_l_2, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_l_2 = _mm256_andnot_ps(neg, phi_l_2);
+  phi_l_2 = _mm256_xor_ps(tmp1, phi_l_2);
+  
+  // max_d, min_k
+  d = _mm256_load_ps(max_d);
+  k = _mm256_load_ps(max_k);
+  D = _mm256_mul_ps(x,x);
+  tmp1 = _mm256_mul_ps(y,y);
+  D = _mm256_add_ps(D,tmp1);
+  D = _vec256_sqrt_ps(D);
+  D_inv = _vec256_rec_ps(D);
+  ak = d;
+  ak = _mm256_mul_ps(d, two_256);
+  tmp1 = _mm256_mul_ps(d,d);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  tmp1 = _mm256_mul_ps(D,D);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  ak = _mm256_mul_ps(ak, D_inv);
+  ak = _mm256_mul_ps(ak, one_o_2_256);
+  hk = _mm256_mul_ps(d,k);
+  hk = _mm256_add_ps(hk, one_256);
+  hk = _mm256_mul_ps(hk,hk);
+  tmp1 = _mm256_mul_ps(ak,ak);
+  hk = _mm256_sub_ps(hk, tmp1);
+  neg = _mm256_cmple_ps(hk, zero_256);
+  hk = _vec256_sqrt_ps(hk);
+  
+  xk1 = _mm256_mul_ps(ak, x);
+  tmp1 = _mm256_mul_ps(hk,y);
+  xk2 = _mm256_sub_ps(xk1, tmp1);
+  xk1 = _mm256_add_ps(xk1, tmp1);
+  xk1 = _mm256_mul_ps(xk1, D_inv);
+  xk2 = _mm256_mul_ps(xk2, D_inv);
+  
+  yk1 = _mm256_mul_ps(ak, y);
+  tmp1 = _mm256_mul_ps(hk,x);
+  yk2 = _mm256_add_ps(yk1, tmp1);
+  yk1 = _mm256_sub_ps(yk1, tmp1);
+  yk1 = _mm256_mul_ps(yk1, D_inv);
+  yk2 = _mm256_mul_ps(yk2, D_inv);
+  
+  __m256 phi_r_3 = _vec256_atan2_ps(yk1, xk1);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_r_3, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_r_3 = _mm256_add_ps(phi_r_3, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_r_3 = _mm256_andnot_ps(neg, phi_r_3);
+  phi_r_3 = _mm256_xor_ps(tmp1, phi_r_3);
+  
+  __m256 phi_l_3 = _vec256_atan2_ps(yk2, xk2);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_l_3, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_l_3 = _mm256_add_ps(phi_l_3, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_l_3 = _mm256_andnot_ps(neg, phi_l_3);
+  phi_l_3 = _mm256_xor_ps(tmp1, phi_l_3);
+  
+  // max_d, max_k
+  d = _mm256_load_ps(max_d);
+  k = _mm256_load_ps(max_k);
+  D = _mm256_mul_ps(x,x);
+  tmp1 = _mm256_mul_ps(y,y);
+  D = _mm256_add_ps(D,tmp1);
+  D = _vec256_sqrt_ps(D);
+  D_inv = _vec256_rec_ps(D);
+  ak = d;
+  ak = _mm256_mul_ps(d, two_256);
+  tmp1 = _mm256_mul_ps(d,d);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  tmp1 = _mm256_mul_ps(D,D);
+  tmp1 = _mm256_mul_ps(tmp1, k);
+  ak = _mm256_add_ps(ak, tmp1);
+  ak = _mm256_mul_ps(ak, D_inv);
+  ak = _mm256_mul_ps(ak, one_o_2_256);
+  hk = _mm256_mul_ps(d,k);
+  hk = _mm256_add_ps(hk, one_256);
+  hk = _mm256_mul_ps(hk,hk);
+  tmp1 = _mm256_mul_ps(ak,ak);
+  hk = _mm256_sub_ps(hk, tmp1);
+  neg = _mm256_cmple_ps(hk, zero_256);
+  hk = _vec256_sqrt_ps(hk);
+  
+  xk1 = _mm256_mul_ps(ak, x);
+  tmp1 = _mm256_mul_ps(hk,y);
+  xk2 = _mm256_sub_ps(xk1, tmp1);
+  xk1 = _mm256_add_ps(xk1, tmp1);
+  xk1 = _mm256_mul_ps(xk1, D_inv);
+  xk2 = _mm256_mul_ps(xk2, D_inv);
+  
+  yk1 = _mm256_mul_ps(ak, y);
+  tmp1 = _mm256_mul_ps(hk,x);
+  yk2 = _mm256_add_ps(yk1, tmp1);
+  yk1 = _mm256_sub_ps(yk1, tmp1);
+  yk1 = _mm256_mul_ps(yk1, D_inv);
+  yk2 = _mm256_mul_ps(yk2, D_inv);
+  
+  __m256 phi_r_4 = _vec256_atan2_ps(yk1, xk1);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_r_4, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_r_4 = _mm256_add_ps(phi_r_4, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_r_4 = _mm256_andnot_ps(neg, phi_r_4);
+  phi_r_4 = _mm256_xor_ps(tmp1, phi_r_4);
+  
+  __m256 phi_l_4 = _vec256_atan2_ps(yk2, xk2);
+  //if phi < 0, phi += 2*pi
+  tmp1 = _mm256_cmplt_ps(phi_l_4, zero_256);
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp1 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp1 = _mm256_xor_ps(tmp1, tmp2);
+  phi_l_4 = _mm256_add_ps(phi_l_4, tmp1);
+  // if neg==true, phi = hit_phi
+  tmp1 = _mm256_and_ps(neg, hit_phi);
+  phi_l_4 = _mm256_andnot_ps(neg, phi_l_4);
+  phi_l_4 = _mm256_xor_ps(tmp1, phi_l_4);
+  
+  ////////////////////////////////////////////////////////////////
+  
+  // check if phi_r overlaps the 0,2pi jump
+  tmp1 = _mm256_cmplt_ps(phi_r_1, pi_over_two_256);
+  tmp2 = _mm256_cmplt_ps(phi_r_2, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  tmp2 = _mm256_cmplt_ps(phi_r_3, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  tmp2 = _mm256_cmplt_ps(phi_r_4, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  
+  tmp2 = _mm256_cmpgt_ps(phi_r_1, three_pi_over_two_256);
+  __m256 tmp3 = _mm256_cmpgt_ps(phi_r_2, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  tmp3 = _mm256_cmpgt_ps(phi_r_3, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  tmp3 = _mm256_cmpgt_ps(phi_r_4, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  
+  tmp1 = _mm256_and_ps(tmp1, tmp2);
+  
+  // tmp1 is now all ones if phi_r overlaps the jump, all zeros otherwise
+  // if tmp1 is true, then subtract 2*pi from all of the phi_r values > 3*pi/2
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp3 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp2 = _mm256_xor_ps(tmp2, tmp3);
+  
+  __m256 tmp4 = _mm256_cmpgt_ps(phi_r_1, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  __m256 tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_r_1 = _mm256_sub_ps(phi_r_1, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_r_2, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_r_2 = _mm256_sub_ps(phi_r_2, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_r_3, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_r_3 = _mm256_sub_ps(phi_r_3, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_r_4, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_r_4 = _mm256_sub_ps(phi_r_4, tmp3);
+  
+  
+  // find the minimum phi_r
+  __m256 phi_r_min = phi_r_1;
+  tmp2 = _mm256_cmplt_ps(phi_r_2, phi_r_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_2);
+  phi_r_min = _mm256_andnot_ps(tmp2, phi_r_min);
+  phi_r_min = _mm256_xor_ps(phi_r_min, tmp3);
+  tmp2 = _mm256_cmplt_ps(phi_r_3, phi_r_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_3);
+  phi_r_min = _mm256_andnot_ps(tmp2, phi_r_min);
+  phi_r_min = _mm256_xor_ps(phi_r_min, tmp3);
+  tmp2 = _mm256_cmplt_ps(phi_r_4, phi_r_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_4);
+  phi_r_min = _mm256_andnot_ps(tmp2, phi_r_min);
+  phi_r_min = _mm256_xor_ps(phi_r_min, tmp3);
+  
+  // find the maximum phi_r
+  __m256 phi_r_max = phi_r_1;
+  tmp2 = _mm256_cmpgt_ps(phi_r_2, phi_r_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_2);
+  phi_r_max = _mm256_andnot_ps(tmp2, phi_r_max);
+  phi_r_max = _mm256_xor_ps(phi_r_max, tmp3);
+  tmp2 = _mm256_cmpgt_ps(phi_r_3, phi_r_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_3);
+  phi_r_max = _mm256_andnot_ps(tmp2, phi_r_max);
+  phi_r_max = _mm256_xor_ps(phi_r_max, tmp3);
+  tmp2 = _mm256_cmpgt_ps(phi_r_4, phi_r_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_r_4);
+  phi_r_max = _mm256_andnot_ps(tmp2, phi_r_max);
+  phi_r_max = _mm256_xor_ps(phi_r_max, tmp3);
+  
+  _mm256_store_ps(min_phi_1, phi_r_min);
+  _mm256_store_ps(max_phi_1, phi_r_max);
+  
+  
+  
+  // check if phi_l overlaps the 0,2pi jump
+  tmp1 = _mm256_cmplt_ps(phi_l_1, pi_over_two_256);
+  tmp2 = _mm256_cmplt_ps(phi_l_2, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  tmp2 = _mm256_cmplt_ps(phi_l_3, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  tmp2 = _mm256_cmplt_ps(phi_l_4, pi_over_two_256);
+  tmp1 = _mm256_or_ps(tmp1, tmp2);
+  
+  tmp2 = _mm256_cmpgt_ps(phi_l_1, three_pi_over_two_256);
+  tmp3 = _mm256_cmpgt_ps(phi_l_2, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  tmp3 = _mm256_cmpgt_ps(phi_l_3, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  tmp3 = _mm256_cmpgt_ps(phi_l_4, three_pi_over_two_256);
+  tmp2 = _mm256_or_ps(tmp2, tmp3);
+  
+  tmp1 = _mm256_and_ps(tmp1, tmp2);
+  
+  // tmp1 is now all ones if phi_l overlaps the jump, all zeros otherwise
+  // if tmp1 is true, then subtract 2*pi from all of the phi_l values > 3*pi/2
+  tmp2 = _mm256_and_ps(tmp1, twopi_256);
+  tmp3 = _mm256_andnot_ps(tmp1, zero_256);
+  tmp2 = _mm256_xor_ps(tmp2, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_l_1, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_l_1 = _mm256_sub_ps(phi_l_1, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_l_2, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_l_2 = _mm256_sub_ps(phi_l_2, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_l_3, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_l_3 = _mm256_sub_ps(phi_l_3, tmp3);
+  
+  tmp4 = _mm256_cmpgt_ps(phi_l_4, three_pi_over_two_256);
+  tmp3 = _mm256_and_ps(tmp4, tmp2);
+  tmp5 = _mm256_andnot_ps(tmp4, zero_256);
+  tmp3 = _mm256_xor_ps(tmp3, tmp5);
+  phi_l_4 = _mm256_sub_ps(phi_l_4, tmp3);
+  
+  
+  // find the minimum phi_l
+  __m256 phi_l_min = phi_l_1;
+  tmp2 = _mm256_cmplt_ps(phi_l_2, phi_l_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_2);
+  phi_l_min = _mm256_andnot_ps(tmp2, phi_l_min);
+  phi_l_min = _mm256_xor_ps(phi_l_min, tmp3);
+  tmp2 = _mm256_cmplt_ps(phi_l_3, phi_l_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_3);
+  phi_l_min = _mm256_andnot_ps(tmp2, phi_l_min);
+  phi_l_min = _mm256_xor_ps(phi_l_min, tmp3);
+  tmp2 = _mm256_cmplt_ps(phi_l_4, phi_l_min);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_4);
+  phi_l_min = _mm256_andnot_ps(tmp2, phi_l_min);
+  phi_l_min = _mm256_xor_ps(phi_l_min, tmp3);
+  
+  // find the maximum phi_l
+  __m256 phi_l_max = phi_l_1;
+  tmp2 = _mm256_cmpgt_ps(phi_l_2, phi_l_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_2);
+  phi_l_max = _mm256_andnot_ps(tmp2, phi_l_max);
+  phi_l_max = _mm256_xor_ps(phi_l_max, tmp3);
+  tmp2 = _mm256_cmpgt_ps(phi_l_3, phi_l_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_3);
+  phi_l_max = _mm256_andnot_ps(tmp2, phi_l_max);
+  phi_l_max = _mm256_xor_ps(phi_l_max, tmp3);
+  tmp2 = _mm256_cmpgt_ps(phi_l_4, phi_l_max);
+  tmp3 = _mm256_and_ps(tmp2, phi_l_4);
+  phi_l_max = _mm256_andnot_ps(tmp2, phi_l_max);
+  phi_l_max = _mm256_xor_ps(phi_l_max, tmp3);
+  
+  _mm256_store_ps(min_phi_2, phi_l_min);
+  _mm256_store_ps(max_phi_2, phi_l_max);
+  
+}
@@ -0,0 +1,193 @@
+#include "HelixHough.h"
+#include <cmath>
+
+using namespace std;
+
+
+// plain C++ versions of phiRange_sse, dzdlRange_sse and
+// allButKappaRange_sse for n hits or pairs, using
+// the libm functions instead of the SIMD approximations.  They are not
+// called by the vote, they are the reference the SIMD kernels are
+// validated against.
+
+
+static float phiWrap(float phi)
+{
+  if(phi < 0.){phi += 2.*M_PI;}
+  return phi;
+}
+
+
+// phi of the tangent of a helix through the origin at distance d and
+// curvature k with the hit at (x,y), for both directions of the helix
+static void phiCorner(float x, float y, float d, float k, float& phi_r, float& phi_l)
+{
+  float hit_phi = phiWrap(atan2(y, x));
+  float D = sqrt(x*x + y*y);
+  float ak = 0.5*(2.*d + d*d*k + D*D*k)/D;
+  float hk = (d*k + 1.)*(d*k + 1.) - ak*ak;
+  if(hk <= 0.)
+  {
+    phi_r = hit_phi;
+    phi_l = hit_phi;
+    return;
+  }
+  hk = sqrt(hk);
+  phi_r = phiWrap(atan2((ak*y - hk*x)/D, (ak*x + hk*y)/D));
+  phi_l = phiWrap(atan2((ak*y + hk*x)/D, (ak*x - hk*y)/D));
+}
+
+
+// min and max of n angles, moving the ones above 3pi/2 down by 2pi if the
+// set straddles the 0,2pi jump
+static void phiMinMax(float* phi, unsigned int n, float& min_phi, float& max_phi)
+{
+  bool low = false;
+  bool high = false;
+  for(unsigned int c=0;c<n;++c)
+  {
+    if(phi[c] < 0.5*M_PI){low = true;}
+    if(phi[c] > 1.5*M_PI){high = true;}
+  }
+  if(low && high)
+  {
+    for(unsigned int c=0;c<n;++c)
+    {
+      if(phi[c] > 1.5*M_PI){phi[c] -= 2.*M_PI;}
+    }
+  }
+  min_phi = phi[0];
+  max_phi = phi[0];
+  for(unsigned int c=1;c<n;++c)
+  {
+    if(phi[c] < min_phi){min_phi = phi[c];}
+    if(phi[c] > max_phi){max_phi = phi[c];}
+  }
+}
+
+
+void HelixHough::phiRange_scalar(unsigned int n, float* hit_x, float* hit_y, float* min_d, float* max_d, float* min_k, float* max_k, float* min_phi_1, float* max_phi_1, float* min_phi_2, float* max_phi_2)
+{
+  for(unsigned int i=0;i<n;++i)
+  {
+    // the corners in the order of phiRange_sse, which uses (max_d, max_k)
+    // twice and never (max_d, min_k)
+    float d[4] = {min_d[i], min_d[i], max_d[i], max_d[i]};
+    float k[4] = {min_k[i], max_k[i], max_k[i], max_k[i]};
+    float phi_r[4];
+    float phi_l[4];
+    for(unsigned int c=0;c<4;++c)
+    {
+      phiCorner(hit_x[i], hit_y[i], d[c], k[c], phi_r[c], phi_l[c]);
+    }
+    phiMinMax(phi_r, 4, min_phi_1[i], max_phi_1[i]);
+    phiMinMax(phi_l, 4, min_phi_2[i], max_phi_2[i]);
+  }
+}
+
+
+// arc length in xy from the point of closest approach to the hit
+static float arcLength(float x, float y, float cosphi, float sinphi, float k, float d)
+{
+  float dx = x - d*cosphi;
+  float dy = y - d*sinphi;
+  float D = sqrt(dx*dx + dy*dy);
+  float v = 0.5*k*D;
+  if(v > 0.999){v = 0.999;}
+  if(v > 0.01){return D*asin(v)/v;}
+  float v2 = v*v;
+  return D*(1. + v2*(1./6. + v2*(3./40. + v2*5./112.)));
+}
+
+
+static float dzdlFromArc(float s, float z, float z0)
+{
+  float dz2 = (z - z0)*(z - z0);
+  float dzdl = sqrt(dz2/(s*s + dz2));
+  if(z < z0){dzdl = -dzdl;}
+  return dzdl;
+}
+
+
+void HelixHough::dzdlRange_scalar(unsigned int n, float* x_a, float* y_a, float* z_a, float cosphi1, float sinphi1, float cosphi2, float sinphi2, float min_k, float max_k, float min_d, float max_d, float* min_z0, float* max_z0, float* min_dzdl_a, float* max_dzdl_a)
+{
+  for(unsigned int i=0;i<n;++i)
+  {
+    float s1 = arcLength(x_a[i], y_a[i], cosphi1, sinphi1, min_k, min_d);
+    float s2 = arcLength(x_a[i], y_a[i], cosphi2, sinphi2, max_k, max_d);
+    float dzdl[4];
+    dzdl[0] = dzdlFromArc(s1, z_a[i], max_z0[i]);
+    dzdl[1] = dzdlFromArc(s1, z_a[i], min_z0[i]);
+    dzdl[2] = dzdlFromArc(s2, z_a[i], max_z0[i]);
+    dzdl[3] = dzdlFromArc(s2, z_a[i], min_z0[i]);
+    min_dzdl_a[i] = dzdl[0];
+    max_dzdl_a[i] = dzdl[0];
+    for(unsigned int c=1;c<4;++c)
+    {
+      if(dzdl[c] < min_dzdl_a[i]){min_dzdl_a[i] = dzdl[c];}
+      if(dzdl[c] > max_dzdl_a[i]){max_dzdl_a[i] = dzdl[c];}
+    }
+  }
+}
+
+
+static void minMax(float a, float b, float& min_val, float& max_val)
+{
+  min_val = (a < b) ? a : b;
+  max_val = (a < b) ? b : a;
+}
+
+
+void HelixHough::allButKappaRange_scalar(unsigned int n, float* x1_a,float* x2_a,float* y1_a,float* y2_a,float* z1_a,float* z2_a, float* min_k_a,float* max_k_a, float* min_phi_1_a,float* max_phi_1_a,float* min_phi_2_a,float* max_phi_2_a, float* min_d_1_a,float* max_d_1_a,float* min_d_2_a,float* max_d_2_a, float* min_dzdl_a,float* max_dzdl_a, float* min_z0_1_a,float* max_z0_1_a,float* min_z0_2_a,float* max_z0_2_a)
+{
+  for(unsigned int i=0;i<n;++i)
+  {
+    float x1 = x1_a[i];float y1 = y1_a[i];float z1 = z1_a[i];
+    float x2 = x2_a[i];float y2 = y2_a[i];float z2 = z2_a[i];
+    float x3 = 0.5*(x1 + x2);
+    float y3 = 0.5*(y1 + y2);
+    float Delta2 = (x2 - x1)*(x2 - x1) + (y2 - y1)*(y2 - y1);
+    float Delta = sqrt(Delta2);
+    float ux = (y2 - y1)/Delta;
+    float uy = (x1 - x2)/Delta;
+    // value of d when k = 0
+    float k0val = x3*ux + y3*uy;
+    
+    // index 0 for min_k, 1 for max_k
+    float phi_1[2], phi_2[2], d_1[2], d_2[2], dzdl[2], z0_1[2], z0_2[2];
+    float k[2] = {min_k_a[i], max_k_a[i]};
+    for(unsigned int c=0;c<2;++c)
+    {
+      float uscale2 = 1. - 0.25*Delta2*k[c]*k[c];
+      float uscale = sqrt(uscale2);
+      phi_1[c] = phiWrap(atan2(k[c]*y3 + uscale*uy, k[c]*x3 + uscale*ux));
+      phi_2[c] = phiWrap(atan2(k[c]*y3 - uscale*uy, k[c]*x3 - uscale*ux));
+      
+      // d = (sqrt(kd) - 1)/k, written without the cancellation at small k
+      // which the SIMD kernels have
+      float kd = k[c]*k[c]*(x3*x3 + y3*y3) + uscale2;
+      float kdk = 2.*k[c]*uscale*k0val;
+      float num = k[c]*(x3*x3 + y3*y3 - 0.25*Delta2);
+      d_1[c] = (num + 2.*uscale*k0val)/(sqrt(kd + kdk) + 1.);
+      d_2[c] = (num - 2.*uscale*k0val)/(sqrt(kd - kdk) + 1.);
+      
+      // arc length between the two hits
+      float s = arcLength(x2 - x1, y2 - y1, 1., 0., k[c], 0.);
+      dzdl[c] = dzdlFromArc(s, z2, z1);
+      
+      // z0 from the arc length between the point of closest approach and
+      // the first hit
+      float dzds = dzdl[c]/sqrt(1. - dzdl[c]*dzdl[c]);
+      z0_1[c] = z1 - dzds*arcLength(x1, y1, cos(phi_1[c]), sin(phi_1[c]), k[c], d_1[c]);
+      z0_2[c] = z1 - dzds*arcLength(x1, y1, cos(phi_2[c]), sin(phi_2[c]), k[c], d_2[c]);
+    }
+    
+    phiMinMax(phi_1, 2, min_phi_1_a[i], max_phi_1_a[i]);
+    phiMinMax(phi_2, 2, min_phi_2_a[i], max_phi_2_a[i]);
+    minMax(d_1[0], d_1[1], min_d_1_a[i], max_d_1_a[i]);
+    minMax(d_2[0], d_2[1], min_d_2_a[i], max_d_2_a[i]);
+    minMax(z0_1[0], z0_1[1], min_z0_1_a[i], max_z0_1_a[i]);
+    minMax(z0_2[0], z0_2[1], min_z0_2_a[i], max_z0_2_a[i]);
+    minMax(dzdl[0], dzdl[1], min_dzdl_a[i], max_dzdl_a[i]);
+  }
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sys/time.h>
 #include "vector_math_inline.h"
+#include "HelixHoughISA.h"
 
 using namespace std;
 
@@ -85,29 +86,34 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
   unsigned int pair_counter = 0;
   vector<vector<SimpleHit3D> > four_pairs;
   vector<SimpleHit3D> onepair;
-  unsigned int pair_index[4];
+  unsigned int pair_index[8];
   onepair.assign(2, SimpleHit3D(0.,0., 0.,0., 0.,0., 0, 0));
-  four_pairs.assign(4, onepair);
-  float x1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float y1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float z1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float x2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float y2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float z2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_phi_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_phi_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_phi_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_phi_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_d_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_d_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_d_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_d_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_dzdl_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_dzdl_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_z0_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_z0_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_z0_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_z0_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
+  four_pairs.assign(8, onepair);
+  // pairs go through allButKappaRange 8 at a time with AVX, 4 at a time
+  // otherwise.  The errors and bins are always done 4 pairs at a time, so
+  // the votes come out in the same order
+  unsigned int lanes = 4;
+  if(HelixHoughISA::level() >= HelixHoughISA::AVX){lanes = 8;}
+  float x1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float y1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float z1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float x2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float y2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float z2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_phi_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_phi_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_phi_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_phi_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_d_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_d_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_d_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_d_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_dzdl_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_dzdl_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_z0_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_z0_1_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_z0_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_z0_2_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
   float min_k = zoomranges[zoomlevel].min_k;
   float max_k = min_k + k_size;
   float error_scale = 2.;
@@ -121,8 +127,8 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
     max_kappa = avg + width*bin_scale;
     min_kappa = avg - width*bin_scale;
     
-    float min_k_a[4] __attribute__((aligned(16))) = {min_kappa,min_kappa,min_kappa,min_kappa};
-    float max_k_a[4] __attribute__((aligned(16))) = {max_kappa,max_kappa,max_kappa,max_kappa};
+    float min_k_a[8] __attribute__((aligned(32))) = {min_kappa,min_kappa,min_kappa,min_kappa,min_kappa,min_kappa,min_kappa,min_kappa};
+    float max_k_a[8] __attribute__((aligned(32))) = {max_kappa,max_kappa,max_kappa,max_kappa,max_kappa,max_kappa,max_kappa,max_kappa};
     
     pair_counter = 0;
     for(unsigned int i=0;i<pairs_vec[zoomlevel]->size();i++)
@@ -137,17 +143,96 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
       y2_a[pair_counter] = four_pairs[pair_counter][1].y;
       z2_a[pair_counter] = four_pairs[pair_counter][1].z;
       pair_counter+=1;
-      if(pair_counter == 4)
+      if(pair_counter == lanes)
       {
-        HelixHough::allButKappaRange_sse(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);
-        for(unsigned int h=0;h<pair_counter;++h)
+        if(lanes == 8){HelixHough::allButKappaRange_avx(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);}
+        else{HelixHough::allButKappaRange_sse(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);}
+        for(unsigned int g=0;g<pair_counter;g+=4)
+        {
+          unsigned int n = pair_counter - g;
+          if(n > 4){n = 4;}
+          for(unsigned int h=g;h<(g+n);++h)
+          {
+            float dr0 = sqrt(four_pairs[h][0].dx*four_pairs[h][0].dx + four_pairs[h][0].dy*four_pairs[h][0].dy);
+            float r0 = sqrt(four_pairs[h][0].x*four_pairs[h][0].x + four_pairs[h][0].y*four_pairs[h][0].y);
+            float dr1 = sqrt(four_pairs[h][1].dx*four_pairs[h][1].dx + four_pairs[h][1].dy*four_pairs[h][1].dy);
+            float r1 = sqrt(four_pairs[h][1].x*four_pairs[h][1].x + four_pairs[h][1].y*four_pairs[h][1].y);
+            float r1r0_inv = 1./(r1-r0);
+          
+            // phi error from hit error
+            float dphi = (dr0 + dr1)*r1r0_inv;
+            // phi error from m.s. or whatever else
+            float phi_scatt = phiError(four_pairs[h][1], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl, true);
+            dphi += phi_scatt;
+            dphi *= error_scale;
+            min_phi_1_a[h] -= dphi;
+            min_phi_2_a[h] -= dphi;
+            max_phi_1_a[h] += dphi;
+            max_phi_2_a[h] += dphi;
+          
+            // d error from hit error
+            float dd = r0*(dr0 + dr1)*r1r0_inv + dr0;
+            dd += phi_scatt*r1;
+            dd *= error_scale;
+            min_d_1_a[h] -= dd;
+            min_d_2_a[h] -= dd;
+            max_d_1_a[h] += dd;
+            max_d_2_a[h] += dd;
+          
+            // dzdl error from hit error
+            float ddzdl = (four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
+            // dzdl error from m.s. or whatever else
+            float dzdl_scatt = dzdlError(four_pairs[h][1], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl, true);
+            ddzdl += dzdl_scatt;
+            ddzdl *= error_scale;
+            min_dzdl_a[h] -= ddzdl;
+            max_dzdl_a[h] += ddzdl;
+          
+            // z0 error from hit error
+            float dz0 = r0*(four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
+            dz0 += dzdl_scatt*r1;
+            dz0 *= error_scale;
+            min_z0_1_a[h] -= dz0;
+            min_z0_2_a[h] -= dz0;
+            max_z0_1_a[h] += dz0;
+            max_z0_2_a[h] += dz0;
+          }
+          if(separate_by_helicity==false)
+          {
+            fillBins(total_bins, n, pair_index + g, min_phi_1_a + g, max_phi_1_a + g, min_d_1_a + g, max_d_1_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_1_a + g, max_z0_1_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+            fillBins(total_bins, n, pair_index + g, min_phi_2_a + g, max_phi_2_a + g, min_d_2_a + g, max_d_2_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_2_a + g, max_z0_2_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+          }
+          else
+          {
+            if(helicity==false)
+            {
+              fillBins(total_bins, n, pair_index + g, min_phi_1_a + g, max_phi_1_a + g, min_d_1_a + g, max_d_1_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_1_a + g, max_z0_1_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+            }
+            else
+            {
+              fillBins(total_bins, n, pair_index + g, min_phi_2_a + g, max_phi_2_a + g, min_d_2_a + g, max_d_2_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_2_a + g, max_z0_2_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+            }
+          }
+        }
+        pair_counter = 0;
+      }
+    }
+    if(pair_counter != 0)
+    {
+      if(lanes == 8){HelixHough::allButKappaRange_avx(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);}
+      else{HelixHough::allButKappaRange_sse(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);}
+      for(unsigned int g=0;g<pair_counter;g+=4)
+      {
+        unsigned int n = pair_counter - g;
+        if(n > 4){n = 4;}
+        for(unsigned int h=g;h<(g+n);++h)
         {
           float dr0 = sqrt(four_pairs[h][0].dx*four_pairs[h][0].dx + four_pairs[h][0].dy*four_pairs[h][0].dy);
           float r0 = sqrt(four_pairs[h][0].x*four_pairs[h][0].x + four_pairs[h][0].y*four_pairs[h][0].y);
           float dr1 = sqrt(four_pairs[h][1].dx*four_pairs[h][1].dx + four_pairs[h][1].dy*four_pairs[h][1].dy);
           float r1 = sqrt(four_pairs[h][1].x*four_pairs[h][1].x + four_pairs[h][1].y*four_pairs[h][1].y);
           float r1r0_inv = 1./(r1-r0);
-          
+        
           // phi error from hit error
           float dphi = (dr0 + dr1)*r1r0_inv;
           // phi error from m.s. or whatever else
@@ -158,7 +243,7 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
           min_phi_2_a[h] -= dphi;
           max_phi_1_a[h] += dphi;
           max_phi_2_a[h] += dphi;
-          
+        
           // d error from hit error
           float dd = r0*(dr0 + dr1)*r1r0_inv + dr0;
           dd += phi_scatt*r1;
@@ -167,7 +252,7 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
           min_d_2_a[h] -= dd;
           max_d_1_a[h] += dd;
           max_d_2_a[h] += dd;
-          
+        
           // dzdl error from hit error
           float ddzdl = (four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
           // dzdl error from m.s. or whatever else
@@ -176,7 +261,7 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
           ddzdl *= error_scale;
           min_dzdl_a[h] -= ddzdl;
           max_dzdl_a[h] += ddzdl;
-          
+        
           // z0 error from hit error
           float dz0 = r0*(four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
           dz0 += dzdl_scatt*r1;
@@ -188,87 +273,20 @@ void HelixHough::vote_pairs(unsigned int zoomlevel)
         }
         if(separate_by_helicity==false)
         {
-          fillBins(total_bins, pair_counter, pair_index, min_phi_1_a, max_phi_1_a, min_d_1_a, max_d_1_a, min_dzdl_a, max_dzdl_a, min_z0_1_a, max_z0_1_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
-          fillBins(total_bins, pair_counter, pair_index, min_phi_2_a, max_phi_2_a, min_d_2_a, max_d_2_a, min_dzdl_a, max_dzdl_a, min_z0_2_a, max_z0_2_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+          fillBins(total_bins, n, pair_index + g, min_phi_1_a + g, max_phi_1_a + g, min_d_1_a + g, max_d_1_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_1_a + g, max_z0_1_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+          fillBins(total_bins, n, pair_index + g, min_phi_2_a + g, max_phi_2_a + g, min_d_2_a + g, max_d_2_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_2_a + g, max_z0_2_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
         }
         else
         {
           if(helicity==false)
           {
-            fillBins(total_bins, pair_counter, pair_index, min_phi_1_a, max_phi_1_a, min_d_1_a, max_d_1_a, min_dzdl_a, max_dzdl_a, min_z0_1_a, max_z0_1_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+            fillBins(total_bins, n, pair_index + g, min_phi_1_a + g, max_phi_1_a + g, min_d_1_a + g, max_d_1_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_1_a + g, max_z0_1_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
           }
           else
           {
-            fillBins(total_bins, pair_counter, pair_index, min_phi_2_a, max_phi_2_a, min_d_2_a, max_d_2_a, min_dzdl_a, max_dzdl_a, min_z0_2_a, max_z0_2_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
+            fillBins(total_bins, n, pair_index + g, min_phi_2_a + g, max_phi_2_a + g, min_d_2_a + g, max_d_2_a + g, min_dzdl_a + g, max_dzdl_a + g, min_z0_2_a + g, max_z0_2_a + g, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
           }
         }
-        pair_counter = 0;
-      }
-    }
-    if(pair_counter != 0)
-    {
-      HelixHough::allButKappaRange_sse(x1_a,x2_a,y1_a,y2_a,z1_a,z2_a, min_k_a,max_k_a, min_phi_1_a,max_phi_1_a,min_phi_2_a,max_phi_2_a, min_d_1_a,max_d_1_a,min_d_2_a,max_d_2_a, min_dzdl_a,max_dzdl_a, min_z0_1_a,max_z0_1_a,min_z0_2_a,max_z0_2_a);
-      for(unsigned int h=0;h<pair_counter;++h)
-      {
-        float dr0 = sqrt(four_pairs[h][0].dx*four_pairs[h][0].dx + four_pairs[h][0].dy*four_pairs[h][0].dy);
-        float r0 = sqrt(four_pairs[h][0].x*four_pairs[h][0].x + four_pairs[h][0].y*four_pairs[h][0].y);
-        float dr1 = sqrt(four_pairs[h][1].dx*four_pairs[h][1].dx + four_pairs[h][1].dy*four_pairs[h][1].dy);
-        float r1 = sqrt(four_pairs[h][1].x*four_pairs[h][1].x + four_pairs[h][1].y*four_pairs[h][1].y);
-        float r1r0_inv = 1./(r1-r0);
-        
-        // phi error from hit error
-        float dphi = (dr0 + dr1)*r1r0_inv;
-        // phi error from m.s. or whatever else
-        float phi_scatt = phiError(four_pairs[h][1], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl, true);
-        dphi += phi_scatt;
-        dphi *= error_scale;
-        min_phi_1_a[h] -= dphi;
-        min_phi_2_a[h] -= dphi;
-        max_phi_1_a[h] += dphi;
-        max_phi_2_a[h] += dphi;
-        
-        // d error from hit error
-        float dd = r0*(dr0 + dr1)*r1r0_inv + dr0;
-        dd += phi_scatt*r1;
-        dd *= error_scale;
-        min_d_1_a[h] -= dd;
-        min_d_2_a[h] -= dd;
-        max_d_1_a[h] += dd;
-        max_d_2_a[h] += dd;
-        
-        // dzdl error from hit error
-        float ddzdl = (four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
-        // dzdl error from m.s. or whatever else
-        float dzdl_scatt = dzdlError(four_pairs[h][1], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl, true);
-        ddzdl += dzdl_scatt;
-        ddzdl *= error_scale;
-        min_dzdl_a[h] -= ddzdl;
-        max_dzdl_a[h] += ddzdl;
-        
-        // z0 error from hit error
-        float dz0 = r0*(four_pairs[h][0].dz + four_pairs[h][1].dz)*r1r0_inv;
-        dz0 += dzdl_scatt*r1;
-        dz0 *= error_scale;
-        min_z0_1_a[h] -= dz0;
-        min_z0_2_a[h] -= dz0;
-        max_z0_1_a[h] += dz0;
-        max_z0_2_a[h] += dz0;
-      }
-      if(separate_by_helicity==false)
-      {
-        fillBins(total_bins, pair_counter, pair_index, min_phi_1_a, max_phi_1_a, min_d_1_a, max_d_1_a, min_dzdl_a, max_dzdl_a, min_z0_1_a, max_z0_1_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
-        fillBins(total_bins, pair_counter, pair_index, min_phi_2_a, max_phi_2_a, min_d_2_a, max_d_2_a, min_dzdl_a, max_dzdl_a, min_z0_2_a, max_z0_2_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
-      }
-      else
-      {
-        if(helicity==false)
-        {
-          fillBins(total_bins, pair_counter, pair_index, min_phi_1_a, max_phi_1_a, min_d_1_a, max_d_1_a, min_dzdl_a, max_dzdl_a, min_z0_1_a, max_z0_1_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
-        }
-        else
-        {
-          fillBins(total_bins, pair_counter, pair_index, min_phi_2_a, max_phi_2_a, min_d_2_a, max_d_2_a, min_dzdl_a, max_dzdl_a, min_z0_2_a, max_z0_2_a, four_pairs, n_d, n_k, n_dzdl, n_z0, k_bin, n_phi, zoomlevel, low_phi, high_phi, low_d, high_d, low_z0, high_z0, low_dzdl, high_dzdl, inv_phi_range, inv_d_range, inv_z0_range, inv_dzdl_range, vote_array);
-        }
       }
       pair_counter = 0;
     }
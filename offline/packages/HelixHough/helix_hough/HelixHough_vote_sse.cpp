@@ -1,4 +1,5 @@
 #include "HelixHough.h"
+#include "HelixHoughISA.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -234,7 +235,7 @@ void fillBins4_sse(float* min_phi_a, float* max_phi_a, float n_phi_val, float in
 
 
 void HelixHough::fillBins(unsigned int total_bins, unsigned int hit_counter, float*
-min_phi_a, float* max_phi_a, vector<SimpleHit3D>& four_hits,
+min_phi_a, float* max_phi_a, unsigned int first_hit,
 fastvec2d& z_bins, unsigned int n_d, unsigned int
 n_k, unsigned int n_dzdl, unsigned int n_z0, unsigned int d_bin, unsigned int
 k_bin, unsigned int n_phi, unsigned int zoomlevel, float low_phi, float
@@ -251,7 +252,7 @@ high_phi, float inv_phi_range, fastvec& vote_array)
   unsigned int phihi1[4] __attribute__((aligned(16))) = {0x00000000,0x00000000,0x00000000,0x00000000};
   unsigned int phihi2[4] __attribute__((aligned(16))) = {0x00000000,0x00000000,0x00000000,0x00000000};
   
-  z_bins.fetch(four_hits[0].index, four_hits[hit_counter-1].index, zbuffer, zbufnum);
+  z_bins.fetch(first_hit, first_hit + hit_counter - 1, zbuffer, zbufnum);
   
   unsigned int zoff = n_z0*n_dzdl*(k_bin + n_k*d_bin);
   unsigned int binprod = n_z0*n_dzdl*n_k*n_d;
@@ -274,7 +275,7 @@ high_phi, float inv_phi_range, fastvec& vote_array)
     
     for(unsigned int i=0;i<cur;++i)
     {
-      unsigned int index = four_hits[i+offset].index;
+      unsigned int index = first_hit + i + offset;
       
       unsigned int pos = (i+offset)*size2;
       for(unsigned int zbin=0;zbin<zbufnum[i+offset];++zbin)
@@ -340,30 +341,31 @@ n_k, unsigned int n_dzdl, unsigned int n_z0, fastvec2d& z_bins)
   float max_kappa = pow(zoomranges[zoomlevel].max_k, pwr);
   
   unsigned int hit_counter = 0;
-  float x_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float y_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float z_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_dzdl_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_dzdl_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float min_z0_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float max_z0_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float dz_a[4] = {0., 0., 0., 0.};
-  vector<SimpleHit3D> four_hits;
-  SimpleHit3D temphit(0.,0., 0.,0., 0.,0., 0, 0);
-  four_hits.assign(4, temphit);
-  unsigned int temp_zcount[4];
-  unsigned buffer[4][1<<8];
+  vector<SimpleHit3D>& hits = *(hits_vec[zoomlevel]);
+  unsigned int first = 0;
+  float* x_a = hit_columns.x;
+  float* y_a = hit_columns.y;
+  float* z_a = hit_columns.z;
+  float* dz_a = hit_columns.dz;
+  float min_dzdl_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_dzdl_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float min_z0_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  float max_z0_a[8] __attribute__((aligned(32))) = {0.,0.,0.,0.,0.,0.,0.,0.};
+  unsigned int temp_zcount[8];
+  unsigned buffer[8][1<<8];
+  // hits are voted 8 at a time with AVX, 4 at a time otherwise
+  unsigned int lanes = 4;
+  if(HelixHoughISA::level() >= HelixHoughISA::AVX){lanes = 8;}
   for(unsigned int i=0;i<hits_vec[zoomlevel]->size();i++)
   {
-    x_a[hit_counter] = (*(hits_vec[zoomlevel]))[i].x;
-    y_a[hit_counter] = (*(hits_vec[zoomlevel]))[i].y;
-    z_a[hit_counter] = (*(hits_vec[zoomlevel]))[i].z;
-    dz_a[hit_counter] = (*(hits_vec[zoomlevel]))[i].dz;
-    four_hits[hit_counter] = (*(hits_vec[zoomlevel]))[i];
-    
     hit_counter++;
+    first = i + 1 - hit_counter;
+    x_a = hit_columns.x + first;
+    y_a = hit_columns.y + first;
+    z_a = hit_columns.z + first;
+    dz_a = hit_columns.dz + first;
     
-    if(hit_counter==4)
+    if(hit_counter==lanes)
     {
       for(unsigned int h=0;h<hit_counter;++h)
       {
@@ -388,14 +390,15 @@ n_k, unsigned int n_dzdl, unsigned int n_z0, fastvec2d& z_bins)
         }
         
         
-        dzdlRange_sse(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);
+        if(lanes == 8){dzdlRange_avx(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);}
+        else{dzdlRange_sse(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);}
         
         unsigned int low_bin = 0;
         unsigned int high_bin = 0;
         
         for(unsigned int h=0;h<hit_counter;++h)
         {
-          float d_dzdl = dzdlError(four_hits[h], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0, max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+          float d_dzdl = dzdlError(hits[first+h], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0, max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
           
           float min_dzdl = min_dzdl_a[h] - d_dzdl;
           float max_dzdl = max_dzdl_a[h] + d_dzdl;
@@ -465,7 +468,8 @@ n_k, unsigned int n_dzdl, unsigned int n_z0, fastvec2d& z_bins)
         max_z0_a[h] = max_z0 + dz;
       }
       
-      dzdlRange_sse(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);
+      if(lanes == 8){dzdlRange_avx(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);}
+      else{dzdlRange_sse(x_a, y_a, z_a, min_cos, min_sin, max_cos, max_sin, min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0_a, max_z0_a, min_dzdl_a, max_dzdl_a);}
       
       unsigned int low_bin = 0;
       unsigned int high_bin = 0;
@@ -473,7 +477,7 @@ n_k, unsigned int n_dzdl, unsigned int n_z0, fastvec2d& z_bins)
       for(unsigned int h=0;h<hit_counter;++h)
       {
         
-        float d_dzdl = dzdlError(four_hits[h], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0, max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+        float d_dzdl = dzdlError(hits[first+h], min_kappa, max_kappa, zoomranges[zoomlevel].min_d, zoomranges[zoomlevel].max_d, min_z0, max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
         
         float min_dzdl = min_dzdl_a[h] - d_dzdl;
         float max_dzdl = max_dzdl_a[h] + d_dzdl;
@@ -546,6 +550,8 @@ void HelixHough::vote(unsigned int zoomlevel)
   float min_kappa = pow(zoomranges[zoomlevel].min_k, pwr);
   float max_kappa = pow(zoomranges[zoomlevel].max_k, pwr);
   
+  hit_columns.fill(*(hits_vec[zoomlevel]));
+  
   timeval t1,t2;
   double time1=0.;
   double time2=0.;
@@ -572,17 +578,13 @@ void HelixHough::vote(unsigned int zoomlevel)
   __m128 phi_3_out_2;
   __m128 phi_4_out_2;
   unsigned int hit_counter = 0;
-  float x_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float y_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float x_a_2[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  float y_a_2[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
-  vector<SimpleHit3D> four_hits;
-  SimpleHit3D temphit(0.,0., 0.,0., 0.,0., 0, 0);
-  four_hits.assign(4, temphit);
-  vector<SimpleHit3D> four_hits_2;
-  four_hits_2.assign(4, temphit);
-  vector<SimpleHit3D> eight_hits;
-  eight_hits.assign(8, temphit);
+  // groups of 4 or 8 hits are read straight from the columns
+  vector<SimpleHit3D>& hits = *(hits_vec[zoomlevel]);
+  unsigned int first = 0;
+  float* x_a = hit_columns.x;
+  float* y_a = hit_columns.y;
+  float* x_a_2 = hit_columns.x + 4;
+  float* y_a_2 = hit_columns.y + 4;
   float min_phi_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
   float max_phi_1_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
   float min_phi_2_a[4] __attribute__((aligned(16))) = {0.,0.,0.,0.};
@@ -632,26 +634,75 @@ void HelixHough::vote(unsigned int zoomlevel)
     min_d_array[d_bin] = avg - width*bin_scale;
   }
   
-  
-  for(unsigned int i=0;i<hits_vec[zoomlevel]->size();i++)
+  // without the helicity split, blocks of 8 hits go through phiRange_avx.
+  // The bins of the second 4 hits of a block are kept and filled after
+  // all the bins of the first 4, the order the groups of 4 are voted in
+  unsigned int n_avx = 0;
+  if((separate_by_helicity==false) && (HelixHoughISA::level() >= HelixHoughISA::AVX))
+  {
+    n_avx = hits.size() - hits.size()%8;
+  }
+  float min_phi_1_8[8] __attribute__((aligned(32)));
+  float max_phi_1_8[8] __attribute__((aligned(32)));
+  float min_phi_2_8[8] __attribute__((aligned(32)));
+  float max_phi_2_8[8] __attribute__((aligned(32)));
+  vector<float> later_phi;
+  if(n_avx != 0){later_phi.assign(16*n_d*n_k, 0.);}
+  for(unsigned int b=0;b<n_avx;b+=8)
   {
-    if(hit_counter < 4)
+    x_a = hit_columns.x + b;
+    y_a = hit_columns.y + b;
+    for(unsigned int d_bin=0;d_bin<n_d;++d_bin)
     {
-      four_hits[hit_counter] = ((*(hits_vec[zoomlevel]))[i]);
-      x_a[hit_counter] = four_hits[hit_counter].x;
-      y_a[hit_counter] = four_hits[hit_counter].y;
-      four_hits[hit_counter].index = i;
-      eight_hits[hit_counter] = four_hits[hit_counter];
+      float min_d_8[8] __attribute__((aligned(32))) = {min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin],min_d_array[d_bin]};
+      float max_d_8[8] __attribute__((aligned(32))) = {max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin],max_d_array[d_bin]};
+      
+      for(unsigned int k_bin=0;k_bin<n_k;++k_bin)
+      {
+        float min_k_8[8] __attribute__((aligned(32))) = {min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin],min_k_array[k_bin]};
+        float max_k_8[8] __attribute__((aligned(32))) = {max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin],max_k_array[k_bin]};
+        HelixHough::phiRange_avx(x_a, y_a, min_d_8, max_d_8, min_k_8, max_k_8, min_phi_1_8, max_phi_1_8, min_phi_2_8, max_phi_2_8);
+        for(unsigned int h=0;h<8;++h)
+        {
+          float dphi = sqrt((hit_columns.dx[b+h]*hit_columns.dx[b+h] + hit_columns.dy[b+h]*hit_columns.dy[b+h])/(hit_columns.x[b+h]*hit_columns.x[b+h] + hit_columns.y[b+h]*hit_columns.y[b+h]));
+          dphi += phiError(hits[b+h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+          
+          min_phi_1_8[h] -= dphi;
+          min_phi_2_8[h] -= dphi;
+          max_phi_1_8[h] += dphi;
+          max_phi_2_8[h] += dphi;
+        }
+        fillBins(total_bins, 4, min_phi_1_8, max_phi_1_8, b, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+        fillBins(total_bins, 4, min_phi_2_8, max_phi_2_8, b, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+        float* later = &(later_phi[16*(d_bin*n_k + k_bin)]);
+        for(unsigned int h=0;h<4;++h)
+        {
+          later[h] = min_phi_1_8[4+h];
+          later[4+h] = max_phi_1_8[4+h];
+          later[8+h] = min_phi_2_8[4+h];
+          later[12+h] = max_phi_2_8[4+h];
+        }
+      }
     }
-    else
+    for(unsigned int d_bin=0;d_bin<n_d;++d_bin)
     {
-      four_hits_2[hit_counter-4] = ((*(hits_vec[zoomlevel]))[i]);
-      x_a_2[hit_counter-4] = four_hits_2[hit_counter-4].x;
-      y_a_2[hit_counter-4] = four_hits_2[hit_counter-4].y;
-      four_hits_2[hit_counter-4].index = i;
-      eight_hits[hit_counter] = four_hits_2[hit_counter-4];
+      for(unsigned int k_bin=0;k_bin<n_k;++k_bin)
+      {
+        float* later = &(later_phi[16*(d_bin*n_k + k_bin)]);
+        fillBins(total_bins, 4, later, later + 4, b + 4, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+        fillBins(total_bins, 4, later + 8, later + 12, b + 4, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+      }
     }
+  }
+  
+  for(unsigned int i=n_avx;i<hits_vec[zoomlevel]->size();i++)
+  {
     hit_counter++;
+    first = i + 1 - hit_counter;
+    x_a = hit_columns.x + first;
+    y_a = hit_columns.y + first;
+    x_a_2 = x_a + 4;
+    y_a_2 = y_a + 4;
     if((hit_counter == 8) && (separate_by_helicity==true))
     {
       for(unsigned int d_bin=0;d_bin<n_d;++d_bin)
@@ -687,8 +738,8 @@ void HelixHough::vote(unsigned int zoomlevel)
           {
             if(h<4)
             {
-              float dphi = sqrt((four_hits[h].dx*four_hits[h].dx + four_hits[h].dy*four_hits[h].dy)/(four_hits[h].x*four_hits[h].x + four_hits[h].y*four_hits[h].y));
-              dphi += phiError(four_hits[h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+              float dphi = sqrt((hit_columns.dx[first+h]*hit_columns.dx[first+h] + hit_columns.dy[first+h]*hit_columns.dy[first+h])/(hit_columns.x[first+h]*hit_columns.x[first+h] + hit_columns.y[first+h]*hit_columns.y[first+h]));
+              dphi += phiError(hits[first+h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
               
               min_phi_1_a[h] -= dphi;
               max_phi_1_a[h] += dphi;
@@ -697,8 +748,10 @@ void HelixHough::vote(unsigned int zoomlevel)
             }
             else
             {
-              float dphi = sqrt((four_hits_2[h-4].dx*four_hits_2[h-4].dx + four_hits_2[h-4].dy*four_hits_2[h-4].dy)/(four_hits_2[h-4].x*four_hits_2[h-4].x + four_hits_2[h-4].y*four_hits_2[h-4].y));
-              dphi += phiError(four_hits[h-4], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+              float dphi = sqrt((hit_columns.dx[first+h]*hit_columns.dx[first+h] + hit_columns.dy[first+h]*hit_columns.dy[first+h])/(hit_columns.x[first+h]*hit_columns.x[first+h] + hit_columns.y[first+h]*hit_columns.y[first+h]));
+              // the error term is evaluated for the hit 4 places earlier,
+              // as it always has been
+              dphi += phiError(hits[first+h-4], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
               
               min_phi_2_a[h-4] -= dphi;
               max_phi_2_a[h-4] += dphi;
@@ -706,7 +759,7 @@ void HelixHough::vote(unsigned int zoomlevel)
               max_phi_8[h] = max_phi_2_a[h-4];
             }
           }
-          fillBins(total_bins, 8, min_phi_8, max_phi_8, eight_hits, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+          fillBins(total_bins, 8, min_phi_8, max_phi_8, first, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
         }
       }
       hit_counter = 0;
@@ -745,8 +798,8 @@ void HelixHough::vote(unsigned int zoomlevel)
           }
           for(unsigned int h=0;h<hit_counter;++h)
           {
-            float dphi = sqrt((four_hits[h].dx*four_hits[h].dx + four_hits[h].dy*four_hits[h].dy)/(four_hits[h].x*four_hits[h].x + four_hits[h].y*four_hits[h].y));
-            dphi += phiError(four_hits[h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+            float dphi = sqrt((hit_columns.dx[first+h]*hit_columns.dx[first+h] + hit_columns.dy[first+h]*hit_columns.dy[first+h])/(hit_columns.x[first+h]*hit_columns.x[first+h] + hit_columns.y[first+h]*hit_columns.y[first+h]));
+            dphi += phiError(hits[first+h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
             
             min_phi_1_a[h] -= dphi;
             min_phi_2_a[h] -= dphi;
@@ -755,12 +808,12 @@ void HelixHough::vote(unsigned int zoomlevel)
           }
           if(separate_by_helicity==true)
           {
-            fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, four_hits, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+            fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, first, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
           }
           else
           {
-            fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, four_hits, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
-            fillBins(total_bins, hit_counter, min_phi_2_a, max_phi_2_a, four_hits, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+            fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, first, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+            fillBins(total_bins, hit_counter, min_phi_2_a, max_phi_2_a, first, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
           }
         }
       }
@@ -802,8 +855,8 @@ void HelixHough::vote(unsigned int zoomlevel)
         }
         for(unsigned int h=0;h<hit_counter;++h)
         {
-          float dphi = sqrt((four_hits[h].dx*four_hits[h].dx + four_hits[h].dy*four_hits[h].dy)/(four_hits[h].x*four_hits[h].x + four_hits[h].y*four_hits[h].y));
-          dphi += phiError(four_hits[h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
+          float dphi = sqrt((hit_columns.dx[first+h]*hit_columns.dx[first+h] + hit_columns.dy[first+h]*hit_columns.dy[first+h])/(hit_columns.x[first+h]*hit_columns.x[first+h] + hit_columns.y[first+h]*hit_columns.y[first+h]));
+          dphi += phiError(hits[first+h], min_kappa, max_kappa, min_d_array[d_bin], max_d_array[d_bin], zoomranges[zoomlevel].min_z0, zoomranges[zoomlevel].max_z0, zoomranges[zoomlevel].min_dzdl, zoomranges[zoomlevel].max_dzdl);
           
           min_phi_1_a[h] -= dphi;
           min_phi_2_a[h] -= dphi;
@@ -812,12 +865,12 @@ void HelixHough::vote(unsigned int zoomlevel)
         }
         if(separate_by_helicity==true)
         {
-          fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, four_hits, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+          fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, first, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
         }
         else
         {
-          fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, four_hits, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
-          fillBins(total_bins, hit_counter, min_phi_2_a, max_phi_2_a, four_hits, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+          fillBins(total_bins, hit_counter, min_phi_1_a, max_phi_1_a, first, z_bins,  n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
+          fillBins(total_bins, hit_counter, min_phi_2_a, max_phi_2_a, first, z_bins, n_d, n_k, n_dzdl, n_z0, d_bin, k_bin, n_phi, zoomlevel, low_phi, high_phi, inv_phi_range, vote_array);
         }
       }
     }
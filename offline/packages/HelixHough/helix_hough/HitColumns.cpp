@@ -0,0 +1,68 @@
+#include "HitColumns.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+
+HitColumns::HitColumns() : x(NULL), y(NULL), z(NULL), dx(NULL), dy(NULL), dz(NULL), layer(NULL), nhits(0), capacity(0), buffer(NULL)
+{
+
+}
+
+
+HitColumns::~HitColumns()
+{
+  free(buffer);
+}
+
+
+// one block for all columns, each one a multiple of 8 entries long
+void HitColumns::reserve(unsigned int n)
+{
+  if(n <= capacity){return;}
+  unsigned int cap = ((n + 7)/8)*8;
+  if(cap < 64){cap = 64;}
+  free(buffer);
+  buffer = NULL;
+  if(posix_memalign(&buffer, 32, 7*cap*sizeof(float)) != 0)
+  {
+    buffer = NULL;
+    capacity = 0;
+    return;
+  }
+  capacity = cap;
+  float* col = (float*)buffer;
+  x = col;col += cap;
+  y = col;col += cap;
+  z = col;col += cap;
+  dx = col;col += cap;
+  dy = col;col += cap;
+  dz = col;col += cap;
+  layer = (int*)col;
+}
+
+
+void HitColumns::fill(const vector<SimpleHit3D>& hits)
+{
+  reserve(hits.size() + 8);
+  nhits = hits.size();
+  for(unsigned int i=0;i<nhits;++i)
+  {
+    x[i] = hits[i].x;
+    y[i] = hits[i].y;
+    z[i] = hits[i].z;
+    dx[i] = hits[i].dx;
+    dy[i] = hits[i].dy;
+    dz[i] = hits[i].dz;
+    layer[i] = hits[i].layer;
+  }
+  unsigned int pad = ((nhits + 7)/8)*8 - nhits;
+  memset(x + nhits, 0, pad*sizeof(float));
+  memset(y + nhits, 0, pad*sizeof(float));
+  memset(z + nhits, 0, pad*sizeof(float));
+  memset(dx + nhits, 0, pad*sizeof(float));
+  memset(dy + nhits, 0, pad*sizeof(float));
+  memset(dz + nhits, 0, pad*sizeof(float));
+  memset(layer + nhits, 0, pad*sizeof(int));
+}
@@ -0,0 +1,41 @@
+#ifndef __HITCOLUMNS__
+#define __HITCOLUMNS__
+
+#include "SimpleHit3D.h"
+#include <vector>
+
+
+// structure-of-arrays copy of the hits of one zoom level for the SIMD
+// voting.  Every column is 32 byte aligned and padded with zeros to a
+// multiple of 8 entries, so any 4 (8) hits starting at a multiple of 4 (8)
+// can be loaded with _mm_load_ps (_mm256_load_ps).  The memory is kept
+// between fills.
+class HitColumns
+{
+  public:
+    HitColumns();
+    ~HitColumns();
+
+    void fill(const std::vector<SimpleHit3D>& hits);
+    unsigned int size() const {return nhits;}
+
+    float* x;
+    float* y;
+    float* z;
+    float* dx;
+    float* dy;
+    float* dz;
+    int* layer;
+
+  private:
+    HitColumns(const HitColumns&);
+    HitColumns& operator=(const HitColumns&);
+
+    void reserve(unsigned int n);
+
+    unsigned int nhits;
+    unsigned int capacity;
+    void* buffer;
+};
+
+#endif
@@ -376,21 +376,28 @@ void CylinderKalman::calculateProjections(SimpleHit3D& hit, HelixKalmanState& st
 }
 
 
-void CylinderKalman::calculateMeasurements(SimpleHit3D& hit, Matrix<float,2,1>& m, Matrix<float,2,2>& G)
+// the measured phi and z of the hit, and their variances
+void CylinderKalman::calculateMeasurements(SimpleHit3D& hit, Matrix<float,2,1>& m, float& var_phi, float& var_z)
 {
-  Matrix<float,2,2> V = Matrix<float,2,2>::Zero(2, 2);
-  V(0,0) = 3.33333333333333426e-01*((hit.dx)*(hit.dx) + (hit.dy)*(hit.dy))/((hit.x)*(hit.x) + (hit.y)*(hit.y));
-  V(1,1) = 3.33333333333333426e-01*(hit.dz)*(hit.dz);
-  
-  G = V.fullPivLu().inverse();
+  var_phi = 3.33333333333333426e-01*((hit.dx)*(hit.dx) + (hit.dy)*(hit.dy))/((hit.x)*(hit.x) + (hit.y)*(hit.y));
+  var_z = 3.33333333333333426e-01*(hit.dz)*(hit.dz);
   
-  m = Matrix<float,2,1>::Zero(2,1);
   m(0) = atan2(hit.y, hit.x);
   if(m(0) < 0.){m(0) += 2.*M_PI;}
   m(1) = hit.z;
 }
 
 
+void CylinderKalman::calculateMeasurements(SimpleHit3D& hit, Matrix<float,2,1>& m, Matrix<float,2,2>& G)
+{
+  Matrix<float,2,2> V = Matrix<float,2,2>::Zero(2, 2);
+  m = Matrix<float,2,1>::Zero(2,1);
+  calculateMeasurements(hit, m, V(0,0), V(1,1));
+  
+  G = V.fullPivLu().inverse();
+}
+
+
 void CylinderKalman::updateIntersection(HelixKalmanState& state, int layer)
 {
   float phi = state.phi;
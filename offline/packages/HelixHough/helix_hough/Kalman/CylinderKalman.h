@@ -5,6 +5,7 @@
 #include <vector>
 
 class HelixKalmanState;
+class HelixKalmanStatePack;
 class SimpleHit3D;
 
 
@@ -14,6 +15,12 @@ class CylinderKalman : public HelixKalman
     CylinderKalman(std::vector<float>& detector_radii, std::vector<float>& detector_material, float B);
     virtual ~CylinderKalman();
     
+    // adds hits[i] to the track in lane i of the pack, lanes with a NULL hit
+    // are left unchanged.  The same filter as addHit, with the covariance
+    // update done for all lanes at once in the gain form, so only 2x2
+    // matrices are inverted
+    void addHits(SimpleHit3D* hits[], HelixKalmanStatePack& states);
+    
   protected:
     void calculateProjections(SimpleHit3D& hit, HelixKalmanState& state, Eigen::Matrix<float,2,5>& H, Eigen::Matrix<float,2,1>& ha);
     void calculateMeasurements(SimpleHit3D& hit, Eigen::Matrix<float,2,1>& m, Eigen::Matrix<float,2,2>& G);
@@ -23,6 +30,7 @@ class CylinderKalman : public HelixKalman
     
   private:
     void calculate_dxda(SimpleHit3D& hit, HelixKalmanState& state, Eigen::Matrix<float,3,5>& dxda, float& x, float& y, float& z);
+    void calculateMeasurements(SimpleHit3D& hit, Eigen::Matrix<float,2,1>& m, float& var_phi, float& var_z);
     std::vector<float> det_rad;
     std::vector<float> det_scatter_variance;
     unsigned int nlayers;
@@ -0,0 +1,203 @@
+#include "CylinderKalman.h"
+#include "HelixKalmanState.h"
+#include "HelixKalmanStatePack.h"
+#include "SimpleHit3D.h"
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <cmath>
+
+using namespace std;
+using namespace Eigen;
+
+
+static const __m128 one = {1., 1., 1., 1.};
+static const __m128 two = {2., 2., 2., 2.};
+
+// position of C(i,j) in the upper triangle of HelixKalmanStatePack::C
+static const unsigned int sym[5][5] = {{0,1,2,3,4},{1,5,6,7,8},{2,6,9,10,11},{3,7,10,12,13},{4,8,11,13,14}};
+
+
+static void getLane(HelixKalmanStatePack& states, unsigned int lane, HelixKalmanState& state)
+{
+  state.phi = states.phi[lane];
+  state.d = states.d[lane];
+  state.kappa = states.kappa[lane];
+  state.nu = states.nu[lane];
+  state.z0 = states.z0[lane];
+  state.dzdl = states.dzdl[lane];
+  state.x_int = states.x_int[lane];
+  state.y_int = states.y_int[lane];
+  state.z_int = states.z_int[lane];
+  state.position = states.position[lane];
+}
+
+
+void CylinderKalman::addHits(SimpleHit3D* hits[], HelixKalmanStatePack& states)
+{
+  static const unsigned int W = HelixKalmanStatePack::width;
+
+  // per lane inputs of the update : the projection H, the residual r, the
+  // measurement variances V, and the scattering jacobian dA/dt with the
+  // variance of the scattering angles
+  float H_a[2][5][W] __attribute__((aligned(16)));
+  float r_a[2][W] __attribute__((aligned(16)));
+  float V_a[2][W] __attribute__((aligned(16)));
+  float dAdt_a[5][2][W] __attribute__((aligned(16)));
+  float var_a[W] __attribute__((aligned(16)));
+  float signk_a[W];
+  float add_a[5][W] __attribute__((aligned(16)));
+
+  HelixKalmanState state;
+  Matrix<float,2,5> H;
+  Matrix<float,2,1> ha;
+  Matrix<float,2,1> m;
+  Matrix<float,2,1> diff;
+  Matrix<float,5,2> dAdt;
+  for(unsigned int l=0;l<W;++l)
+  {
+    if(hits[l] == NULL)
+    {
+      // H = 0 and V = 1 make the update leave the lane as it is
+      for(unsigned int i=0;i<5;++i)
+      {
+        H_a[0][i][l] = 0.;H_a[1][i][l] = 0.;
+        dAdt_a[i][0][l] = 0.;dAdt_a[i][1][l] = 0.;
+      }
+      r_a[0][l] = 0.;r_a[1][l] = 0.;
+      V_a[0][l] = 1.;V_a[1][l] = 1.;
+      var_a[l] = 0.;
+      signk_a[l] = 0.;
+      continue;
+    }
+    SimpleHit3D& hit = *(hits[l]);
+    getLane(states, l, state);
+
+    H = Matrix<float,2,5>::Zero(2,5);
+    ha = Matrix<float,2,1>::Zero(2,1);
+    calculateProjections(hit, state, H, ha);
+    signk_a[l] = signk_store;
+
+    calculateMeasurements(hit, m, V_a[0][l], V_a[1][l]);
+    subtractProjections(m, ha, diff);
+
+    float var = 0.;
+    if(calculateMSJacobian(state, dAdt, var) == false){dAdt = Matrix<float,5,2>::Zero(5,2);var = 0.;}
+
+    for(unsigned int i=0;i<5;++i)
+    {
+      H_a[0][i][l] = H(0,i);H_a[1][i][l] = H(1,i);
+      dAdt_a[i][0][l] = dAdt(i,0);dAdt_a[i][1][l] = dAdt(i,1);
+    }
+    r_a[0][l] = diff(0,0);r_a[1][l] = diff(1,0);
+    var_a[l] = var;
+  }
+
+  // C_proj = C + Q , Q = var*(dA/dt)(dA/dt)^T
+  __m128 var = _mm_load_ps(var_a);
+  __m128 A[5][2];
+  for(unsigned int i=0;i<5;++i)
+  {
+    A[i][0] = _mm_load_ps(dAdt_a[i][0]);
+    A[i][1] = _mm_load_ps(dAdt_a[i][1]);
+  }
+  __m128 Cp[15];
+  for(unsigned int i=0;i<5;++i)
+  {
+    for(unsigned int j=i;j<5;++j)
+    {
+      __m128 q = _mm_add_ps(_mm_mul_ps(A[i][0], A[j][0]), _mm_mul_ps(A[i][1], A[j][1]));
+      Cp[sym[i][j]] = _mm_add_ps(_mm_load_ps(states.C[sym[i][j]]), _mm_mul_ps(q, var));
+    }
+  }
+
+  // HC = H*C_proj , P = H*C_proj*H^T
+  __m128 Hm[2][5];
+  for(unsigned int i=0;i<5;++i)
+  {
+    Hm[0][i] = _mm_load_ps(H_a[0][i]);
+    Hm[1][i] = _mm_load_ps(H_a[1][i]);
+  }
+  __m128 HC[2][5];
+  for(unsigned int r=0;r<2;++r)
+  {
+    for(unsigned int j=0;j<5;++j)
+    {
+      __m128 sum = _mm_mul_ps(Hm[r][0], Cp[sym[0][j]]);
+      for(unsigned int i=1;i<5;++i){sum = _mm_add_ps(sum, _mm_mul_ps(Hm[r][i], Cp[sym[i][j]]));}
+      HC[r][j] = sum;
+    }
+  }
+  __m128 P00 = _mm_mul_ps(HC[0][0], Hm[0][0]);
+  __m128 P01 = _mm_mul_ps(HC[0][0], Hm[1][0]);
+  __m128 P11 = _mm_mul_ps(HC[1][0], Hm[1][0]);
+  for(unsigned int j=1;j<5;++j)
+  {
+    P00 = _mm_add_ps(P00, _mm_mul_ps(HC[0][j], Hm[0][j]));
+    P01 = _mm_add_ps(P01, _mm_mul_ps(HC[0][j], Hm[1][j]));
+    P11 = _mm_add_ps(P11, _mm_mul_ps(HC[1][j], Hm[1][j]));
+  }
+
+  // S = V + P and its inverse
+  __m128 S00 = _mm_add_ps(_mm_load_ps(V_a[0]), P00);
+  __m128 S11 = _mm_add_ps(_mm_load_ps(V_a[1]), P11);
+  __m128 det_inv = _mm_div_ps(one, _mm_sub_ps(_mm_mul_ps(S00, S11), _mm_mul_ps(P01, P01)));
+  __m128 Si00 = _mm_mul_ps(S11, det_inv);
+  __m128 Si01 = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(P01, det_inv));
+  __m128 Si11 = _mm_mul_ps(S00, det_inv);
+
+  // gain K = (HC)^T*S^-1 , state change K*r , and C = C_proj - K*HC
+  __m128 r0 = _mm_load_ps(r_a[0]);
+  __m128 r1 = _mm_load_ps(r_a[1]);
+  __m128 K[5][2];
+  for(unsigned int i=0;i<5;++i)
+  {
+    K[i][0] = _mm_add_ps(_mm_mul_ps(HC[0][i], Si00), _mm_mul_ps(HC[1][i], Si01));
+    K[i][1] = _mm_add_ps(_mm_mul_ps(HC[0][i], Si01), _mm_mul_ps(HC[1][i], Si11));
+    _mm_store_ps(add_a[i], _mm_add_ps(_mm_mul_ps(K[i][0], r0), _mm_mul_ps(K[i][1], r1)));
+  }
+  for(unsigned int i=0;i<5;++i)
+  {
+    for(unsigned int j=i;j<5;++j)
+    {
+      __m128 kh = _mm_add_ps(_mm_mul_ps(K[i][0], HC[0][j]), _mm_mul_ps(K[i][1], HC[1][j]));
+      _mm_store_ps(states.C[sym[i][j]], _mm_sub_ps(Cp[sym[i][j]], kh));
+    }
+  }
+
+  // the chi2 of the state change with respect to C_proj is w^T*P*w , w = S^-1*r
+  __m128 w0 = _mm_add_ps(_mm_mul_ps(Si00, r0), _mm_mul_ps(Si01, r1));
+  __m128 w1 = _mm_add_ps(_mm_mul_ps(Si01, r0), _mm_mul_ps(Si11, r1));
+  __m128 chi2 = _mm_mul_ps(_mm_mul_ps(w0, w0), P00);
+  chi2 = _mm_add_ps(chi2, _mm_mul_ps(_mm_mul_ps(two, _mm_mul_ps(w0, w1)), P01));
+  chi2 = _mm_add_ps(chi2, _mm_mul_ps(_mm_mul_ps(w1, w1), P11));
+  _mm_store_ps(states.chi2, _mm_add_ps(_mm_load_ps(states.chi2), chi2));
+
+  for(unsigned int l=0;l<W;++l)
+  {
+    if(hits[l] == NULL){continue;}
+    getLane(states, l, state);
+    state.phi += add_a[0][l];
+    state.d += add_a[1][l];
+    state.nu += add_a[2][l];
+    state.kappa = state.nu * state.nu;
+    state.z0 += add_a[3][l];
+    state.dzdl += add_a[4][l];
+
+    // calculateProjections set both of these for the last lane only
+    SimpleHit3D& hit = *(hits[l]);
+    det_rad[hit.layer] = sqrt(hit.x*hit.x + hit.y*hit.y);
+    signk_store = signk_a[l];
+    updateIntersection(state, hit.layer);
+
+    states.phi[l] = state.phi;
+    states.d[l] = state.d;
+    states.kappa[l] = state.kappa;
+    states.nu[l] = state.nu;
+    states.z0[l] = state.z0;
+    states.dzdl[l] = state.dzdl;
+    states.x_int[l] = state.x_int;
+    states.y_int[l] = state.y_int;
+    states.z_int[l] = state.z_int;
+    states.position[l] = state.position;
+  }
+}
@@ -441,15 +441,16 @@ void HelixKalman::calculate_dbdt(Matrix<float,3,2>& dbdt_out)
 }
 
 
-void HelixKalman::calculateMSCovariance(HelixKalmanState& state, Matrix<float,5,5>& Q)
+// dA/dt , the change of the helix parameters A with the two scattering angles t, and the variance of the angles
+bool HelixKalman::calculateMSJacobian(HelixKalmanState& state, Matrix<float,5,2>& dAdt, float& var)
 {
   Matrix<float,5,3> dAdAp = Matrix<float,5,3>::Zero(5,3);
   float phi_p = 0.;
   float cosphi_p = 0.;
   float sinphi_p = 0.;
   
-  float var=0.;
-  if(calculateScatteringVariance(state, var) == false){return;}
+  var=0.;
+  if(calculateScatteringVariance(state, var) == false){return false;}
   
   calculate_dAdAp(state, dAdAp, phi_p, cosphi_p, sinphi_p);
   
@@ -463,7 +464,17 @@ void HelixKalman::calculateMSCovariance(HelixKalmanState& state, Matrix<float,5,
   Matrix<float,3,2> dbdt = Matrix<float,3,2>::Zero(3,2);
   calculate_dbdt(dbdt);
   
-  Matrix<float,5,2> dAdt = dAdAp*dApdp*dpdb*dbdt;
+  dAdt = dAdAp*dApdp*dpdb*dbdt;
+  
+  return true;
+}
+
+
+void HelixKalman::calculateMSCovariance(HelixKalmanState& state, Matrix<float,5,5>& Q)
+{
+  Matrix<float,5,2> dAdt;
+  float var=0.;
+  if(calculateMSJacobian(state, dAdt, var) == false){return;}
   
   for(unsigned int j=0;j<5;++j)
   {
@@ -24,6 +24,7 @@ class HelixKalman
     virtual void updateIntersection(HelixKalmanState& state, int layer) = 0;
     virtual void subtractProjections(Eigen::Matrix<float,2,1>& m, Eigen::Matrix<float,2,1>& ha, Eigen::Matrix<float,2,1>& diff);
     
+    bool calculateMSJacobian(HelixKalmanState& state, Eigen::Matrix<float,5,2>& dAdt, float& var);
     void calculateMSCovariance(HelixKalmanState& state, Eigen::Matrix<float,5,5>& Q);
     void calculate_dbdt(Eigen::Matrix<float,3,2>& dbdt_out);
     void calculate_dpdb(Eigen::Vector3f& p, Eigen::Matrix<float,3,3>& dpdb);
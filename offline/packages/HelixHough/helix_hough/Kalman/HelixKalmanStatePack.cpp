@@ -0,0 +1,68 @@
+#include "HelixKalmanStatePack.h"
+#include "HelixKalmanState.h"
+#include <cstring>
+
+using namespace std;
+
+
+HelixKalmanStatePack::HelixKalmanStatePack()
+{
+  memset(this, 0, sizeof(HelixKalmanStatePack));
+}
+
+
+HelixKalmanStatePack::~HelixKalmanStatePack()
+{
+
+}
+
+
+void HelixKalmanStatePack::set(unsigned int lane, const HelixKalmanState& state)
+{
+  phi[lane] = state.phi;
+  d[lane] = state.d;
+  kappa[lane] = state.kappa;
+  nu[lane] = state.nu;
+  z0[lane] = state.z0;
+  dzdl[lane] = state.dzdl;
+  x_int[lane] = state.x_int;
+  y_int[lane] = state.y_int;
+  z_int[lane] = state.z_int;
+  chi2[lane] = state.chi2;
+  position[lane] = state.position;
+  unsigned int n = 0;
+  for(unsigned int i=0;i<5;++i)
+  {
+    for(unsigned int j=i;j<5;++j)
+    {
+      C[n][lane] = state.C(i,j);
+      n += 1;
+    }
+  }
+}
+
+
+void HelixKalmanStatePack::get(unsigned int lane, HelixKalmanState& state) const
+{
+  state.phi = phi[lane];
+  state.d = d[lane];
+  state.kappa = kappa[lane];
+  state.nu = nu[lane];
+  state.z0 = z0[lane];
+  state.dzdl = dzdl[lane];
+  state.x_int = x_int[lane];
+  state.y_int = y_int[lane];
+  state.z_int = z_int[lane];
+  state.chi2 = chi2[lane];
+  state.position = position[lane];
+  unsigned int n = 0;
+  for(unsigned int i=0;i<5;++i)
+  {
+    for(unsigned int j=i;j<5;++j)
+    {
+      state.C(i,j) = C[n][lane];
+      state.C(j,i) = C[n][lane];
+      n += 1;
+    }
+  }
+}
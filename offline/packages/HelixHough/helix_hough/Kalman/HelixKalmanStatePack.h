@@ -0,0 +1,35 @@
+#ifndef __HELIXKALMANSTATEPACK__
+#define __HELIXKALMANSTATEPACK__
+
+class HelixKalmanState;
+
+
+// the states of width tracks side by side, for the batched update in
+// CylinderKalman::addHits.  Each member holds one entry per lane, and the
+// covariance is kept as the 15 entries of its upper triangle, row by row.
+class HelixKalmanStatePack
+{
+  public:
+    static const unsigned int width = 4;
+
+    HelixKalmanStatePack();
+    ~HelixKalmanStatePack();
+
+    void set(unsigned int lane, const HelixKalmanState& state);
+    void get(unsigned int lane, HelixKalmanState& state) const;
+
+    float phi[width] __attribute__((aligned(16)));
+    float d[width] __attribute__((aligned(16)));
+    float kappa[width] __attribute__((aligned(16)));
+    float nu[width] __attribute__((aligned(16)));
+    float z0[width] __attribute__((aligned(16)));
+    float dzdl[width] __attribute__((aligned(16)));
+    float x_int[width] __attribute__((aligned(16)));
+    float y_int[width] __attribute__((aligned(16)));
+    float z_int[width] __attribute__((aligned(16)));
+    float chi2[width] __attribute__((aligned(16)));
+    float C[15][width] __attribute__((aligned(16)));
+    unsigned int position[width];
+};
+
+#endif
@@ -12,9 +12,6 @@ public:
 	      float yy=0., float dyy=0.,
 	      float zz=0., float dzz=0.,
 	      unsigned int ind=0, int lyr=-1);
-  SimpleHit3D(const SimpleHit3D &hit);
-  SimpleHit3D& operator=(const SimpleHit3D &hit);
-  virtual ~SimpleHit3D();
 
   float x, dx;
   float y, dy;
@@ -29,7 +26,11 @@ public:
   
 private:
 
-  float* _err[3]; //< error covariance matrix (x,y,z) (jagged array) 
+  unsigned int covar_index(int i, int j) const;
+
+  // kept inline (no heap, no vtable) so the hit vectors of the zoom
+  // levels are copied with plain memory copies
+  float _err[6]; //< error covariance matrix (x,y,z) (packed storage)
 };
 
 #endif // __SIMPLEHIT3D__
@@ -1,4 +1,6 @@
 #include "sPHENIXTracker.h"
+#include "HelixHoughISA.h"
+#include "HelixKalmanStatePack.h"
 #include <cmath>
 #include <iostream>
 #include <algorithm>
@@ -145,6 +147,10 @@ sPHENIXTracker::sPHENIXTracker(unsigned int n_phi,
     prev_max_dzdl(0.),
     prev_p_inv(0.),
     seed_layer(0),
+    queue_mutexes(NULL),
+    pending_tasks(0),
+    pushed_tasks(0),
+    split_threshold(0),
     ca_chi2_cut(2.0),
     cosang_cut(0.985)
 {
@@ -212,6 +218,10 @@ sPHENIXTracker::sPHENIXTracker(vector<vector<unsigned int> >& zoom_profile,
     nthreads(num_threads),
     vssp(NULL),
     pins(NULL),
+    queue_mutexes(NULL),
+    pending_tasks(0),
+    pushed_tasks(0),
+    split_threshold(0),
     is_parallel(parallel),
     is_thread(false),
     ca_chi2_cut(2.0),
@@ -256,6 +266,14 @@ sPHENIXTracker::sPHENIXTracker(vector<vector<unsigned int> >& zoom_profile,
     
     pins = new Pincushion<sPHENIXTracker>(this, vssp);
     
+    queue_mutexes = new pthread_mutex_t[nthreads];
+    for(unsigned int i=0;i<nthreads;++i)
+    {
+      pthread_mutex_init(&(queue_mutexes[i]), NULL);
+    }
+    pthread_mutex_init(&pending_mutex, NULL);
+    pthread_cond_init(&pending_cond, NULL);
+    
     vector<vector<unsigned int> > zoom_profile_new;
     for(unsigned int i=1;i<zoom_profile.size();++i)
     {
@@ -267,9 +285,8 @@ sPHENIXTracker::sPHENIXTracker(vector<vector<unsigned int> >& zoom_profile,
       thread_trackers.push_back(new sPHENIXTracker(zoom_profile, minzoom, range, material, radius, Bfield) );
       thread_trackers.back()->setThread();
       thread_trackers.back()->setStartZoom(1);
-      thread_tracks.push_back(vector<SimpleTrack3D>());
-      thread_ranges.push_back(HelixRange());
-      thread_hits.push_back(vector<SimpleHit3D>());
+      task_queues.push_back(deque<HoughTask*>());
+      done_tasks.push_back(vector<HoughTask*>());
       split_output_hits.push_back(new vector<vector<SimpleHit3D> >());
       split_ranges.push_back(new vector<HelixRange>());
       split_input_hits.push_back(vector<SimpleHit3D>());
@@ -294,6 +311,16 @@ sPHENIXTracker::~sPHENIXTracker()
   
   if ( pins != NULL ) delete pins;
   if ( vssp != NULL ) delete vssp;
+  if ( queue_mutexes != NULL )
+  {
+    for(unsigned int i=0;i<nthreads;++i)
+    {
+      pthread_mutex_destroy(&(queue_mutexes[i]));
+    }
+    delete [] queue_mutexes;
+    pthread_mutex_destroy(&pending_mutex);
+    pthread_cond_destroy(&pending_cond);
+  }
 }
 
 float sPHENIXTracker::kappaToPt(float kappa) {  
@@ -436,43 +463,71 @@ void sPHENIXTracker::finalize(vector<SimpleTrack3D>& input, vector<SimpleTrack3D
   track_states = states_new;
   if(smooth_back == true)
   {
-    for(unsigned int i=0;i<output.size();++i)
+    if(n_layers < 20)
     {
-      
-      if(n_layers < 20)
+      // refit from the outside in, HelixKalmanStatePack::width tracks at a time
+      static const unsigned int W = HelixKalmanStatePack::width;
+      HelixKalmanStatePack pack;
+      SimpleHit3D pack_hits[W];
+      SimpleHit3D* pack_hit_ptrs[W];
+      float pack_chi2[W];
+      for(unsigned int i=0;i<output.size();i+=W)
       {
-        HelixKalmanState state = track_states[i];
-        
-        track_states[i].C *= 3.;
-        track_states[i].chi2 = 0.;
-        track_states[i].x_int = 0.;
-        track_states[i].y_int = 0.;
-        track_states[i].z_int = 0.;
-        //       track_states[i].position = output[i].hits.size();
-        track_states[i].position = 0;
-        for(int h=(output[i].hits.size() - 1);h>=0;--h)
+        unsigned int n = output.size() - i;
+        if(n > W){n = W;}
+        unsigned int max_hits = 0;
+        for(unsigned int c=0;c<n;++c)
         {
-          SimpleHit3D hit = output[i].hits[h];
-          float err_scale = 1.;
-          int layer = hit.layer;
-          if( (layer >= 0) && (layer < (int)(hit_error_scale.size()) ) ){err_scale = hit_error_scale[layer];}
-          err_scale *= 3.0;//fudge factor, like needed due to non-gaussian errors
-          hit.dx *= err_scale;hit.dy *= err_scale;hit.dz *= err_scale;
-          kalman->addHit(hit, track_states[i]);
-          track_states[i].position = h;
+          HelixKalmanState& state = track_states[i+c];
+          pack_chi2[c] = state.chi2;
+          state.C *= 3.;
+          state.chi2 = 0.;
+          state.x_int = 0.;
+          state.y_int = 0.;
+          state.z_int = 0.;
+          state.position = 0;
+          pack.set(c, state);
+          if(output[i+c].hits.size() > max_hits){max_hits = output[i+c].hits.size();}
+        }
+        for(unsigned int s=0;s<max_hits;++s)
+        {
+          for(unsigned int c=0;c<W;++c)
+          {
+            pack_hit_ptrs[c] = NULL;
+            if( (c >= n) || (s >= output[i+c].hits.size()) ){continue;}
+            SimpleHit3D& hit = pack_hits[c];
+            hit = output[i+c].hits[output[i+c].hits.size() - 1 - s];
+            float err_scale = 1.;
+            int layer = hit.layer;
+            if( (layer >= 0) && (layer < (int)(hit_error_scale.size()) ) ){err_scale = hit_error_scale[layer];}
+            err_scale *= 3.0;//fudge factor, like needed due to non-gaussian errors
+            hit.dx *= err_scale;hit.dy *= err_scale;hit.dz *= err_scale;
+            pack_hit_ptrs[c] = &hit;
+          }
+          kalman->addHits(pack_hit_ptrs, pack);
+          for(unsigned int c=0;c<n;++c)
+          {
+            if(pack_hit_ptrs[c] != NULL){pack.position[c] = output[i+c].hits.size() - 1 - s;}
+          }
+        }
+        for(unsigned int c=0;c<n;++c)
+        {
+          HelixKalmanState& state = track_states[i+c];
+          pack.get(c, state);
+          state.chi2 = pack_chi2[c];
+          state.C *= 2./3.;
+          
+          output[i+c].phi = state.phi;
+          output[i+c].d = state.d;
+          output[i+c].kappa = state.kappa;
+          output[i+c].z0 = state.z0;
+          output[i+c].dzdl = state.dzdl;
         }
-        
-        //       track_states[i].C = state.C;
-        track_states[i].chi2 = state.chi2;
-        track_states[i].C *= 2./3.;
-        
-        output[i].phi = track_states[i].phi;
-        output[i].d = track_states[i].d;
-        output[i].kappa = track_states[i].kappa;
-        output[i].z0 = track_states[i].z0;
-        output[i].dzdl = track_states[i].dzdl;
       }
-      else
+    }
+    else
+    {
+      for(unsigned int i=0;i<output.size();++i)
       {
         HelixKalmanState state = track_states[i];
         
@@ -524,7 +579,8 @@ void sPHENIXTracker::findTracks(vector<SimpleHit3D>& hits, vector<SimpleTrack3D>
 {
   findtracksiter += 1;
   #ifdef AVXHOUGH
-  findTracksBySegments_avx(hits,tracks,range);
+  if(HelixHoughISA::level() >= HelixHoughISA::AVX){findTracksBySegments_avx(hits,tracks,range);}
+  else{findTracksBySegments(hits,tracks,range);}
   #else
   findTracksBySegments(hits,tracks,range);
   #endif
@@ -3,6 +3,7 @@
 
 #include "HelixHough.h"
 #include <vector>
+#include <deque>
 #include <set>
 #include <map>
 #include <string>
@@ -184,6 +185,22 @@ class TrackSegment {
   unsigned int n_hits;
 };
 
+// one Hough bin to be processed by a thread of the parallel tracker.
+// key is the path of bin numbers down to this bin, the tracks of all
+// tasks are merged in key order.
+class HoughTask {
+ public:
+  HoughTask() : zoomlevel(0) {}
+  ~HoughTask() {}
+
+  std::vector<unsigned int> key;
+  HelixRange range;
+  unsigned int zoomlevel;
+  std::vector<SimpleHit3D> hits;
+  std::vector<SimpleTrack3D> tracks;
+  std::vector<HelixKalmanState> states;
+};
+
 class sPHENIXTracker : public HelixHough {
  public:
   sPHENIXTracker(unsigned int n_phi, unsigned int n_d, unsigned int n_k,
@@ -325,6 +342,27 @@ class sPHENIXTracker : public HelixHough {
       float sinang_cut, float cosang_diff_inv, float* cur_kappa_a,
       float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a,
       float* chi2_a);
+  // 8 wide versions, only to be called if
+  // HelixHoughISA::level() >= HelixHoughISA::AVX
+  static void calculateKappaTangents_avx(
+      float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a,
+      float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a,
+      float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a,
+      float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a,
+      float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a,
+      float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a)
+      __attribute__((target("avx")));
+  static void calculateKappaTangents_avx(
+      float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a,
+      float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a,
+      float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a,
+      float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a,
+      float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a,
+      float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a,
+      float sinang_cut, float cosang_diff_inv, float* cur_kappa_a,
+      float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a,
+      float* chi2_a)
+      __attribute__((target("avx")));
   void projectToLayer(SimpleTrack3D& seed, unsigned int layer, float& x,
                       float& y, float& z);
   void findSeededTracksByProjection(std::vector<SimpleTrack3D>& seeds,
@@ -412,6 +450,9 @@ class sPHENIXTracker : public HelixHough {
     std::vector<SimpleHit3D> one_layer;
     layer_sorted.clear();
     layer_sorted.assign(n_layers, one_layer);
+    for (unsigned int i = 0; i < 4; ++i) {
+      layer_sorted_1[i].assign(n_layers, one_layer);
+    }
     temp_comb.assign(n_layers, 0);
     if (is_parallel == true) {
       for (unsigned int i = 0; i < thread_trackers.size(); ++i) {
@@ -479,6 +520,11 @@ class sPHENIXTracker : public HelixHough {
   void initSplitting(std::vector<SimpleHit3D>& hits, unsigned int min_hits,
                      unsigned int max_hits);
 
+  // in parallel mode the sub-bins of a bin which have more hits than this
+  // are queued as tasks of their own, which other threads can take.
+  // 0 (default) never splits a bin.
+  void setSplitThreshold(unsigned int nhits) { split_threshold = nhits; }
+
   void setHitErrorScale(unsigned int layer, float scale) {
     if (layer >= hit_error_scale.size()) {
       hit_error_scale.resize(layer + 1, 1.);
@@ -492,12 +538,20 @@ class sPHENIXTracker : public HelixHough {
 
   void findHelicesParallelThread(void* arg);
   void splitHitsParallelThread(void* arg);
+  void pushTask(unsigned int w, HoughTask* task);
+  HoughTask* popTask(unsigned int w);
+  void runTask(unsigned int w, HoughTask* task);
 
   void initDummyHits(std::vector<SimpleHit3D>& dummies, const HelixRange& range,
                      HelixKalmanState& init_state);
   void findTracksByCombinatorialKalman(std::vector<SimpleHit3D>& hits,
                                        std::vector<SimpleTrack3D>& tracks,
                                        const HelixRange& range);
+  // runs the Kalman filter over the first n candidates in the pack and
+  // keeps the ones passing the cuts, in order
+  void fitKalmanPack(std::vector<SimpleTrack3D>& candidates,
+                     HelixKalmanStatePack& states, unsigned int n,
+                     std::vector<SimpleTrack3D>& tracks);
 
   float fast_chi2_cut_par0;
   float fast_chi2_cut_par1;
@@ -547,9 +601,18 @@ class sPHENIXTracker : public HelixHough {
   std::vector<SeamStress::Seamstress> vss;
   SeamStress::Pincushion<sPHENIXTracker> *pins;
   std::vector<sPHENIXTracker*> thread_trackers;
-  std::vector<std::vector<SimpleTrack3D> > thread_tracks;
-  std::vector<HelixRange> thread_ranges;
-  std::vector<std::vector<SimpleHit3D> > thread_hits;
+  std::vector<SimpleTrack3D> thread_tracks;
+  std::vector<HelixKalmanState> thread_states;
+  std::vector<std::deque<HoughTask*> > task_queues;
+  std::vector<std::vector<HoughTask*> > done_tasks;
+  pthread_mutex_t* queue_mutexes;
+  pthread_mutex_t pending_mutex;
+  // signalled by pushTask, broadcast when pending_tasks drops to 0
+  pthread_cond_t pending_cond;
+  unsigned int pending_tasks;
+  // number of pushTask calls, lets an idle thread see a push it raced with
+  unsigned int pushed_tasks;
+  unsigned int split_threshold;
   std::vector<std::vector<SimpleHit3D> > split_input_hits;
   std::vector<std::vector<std::vector<SimpleHit3D> >* > split_output_hits;
   std::vector<std::vector<HelixRange>* > split_ranges;
@@ -1,4 +1,6 @@
 #include "sPHENIXTrackerTPC.h"
+#include "HelixHoughISA.h"
+#include "HelixKalmanStatePack.h"
 #include <cmath>
 #include <iostream>
 #include <algorithm>
@@ -439,43 +441,71 @@ void sPHENIXTrackerTPC::finalize(vector<SimpleTrack3D>& input, vector<SimpleTrac
   track_states = states_new;
   if(smooth_back == true)
   {
-    for(unsigned int i=0;i<output.size();++i)
+    if(n_layers < 20)
     {
-      
-      if(n_layers < 20)
+      // refit from the outside in, HelixKalmanStatePack::width tracks at a time
+      static const unsigned int W = HelixKalmanStatePack::width;
+      HelixKalmanStatePack pack;
+      SimpleHit3D pack_hits[W];
+      SimpleHit3D* pack_hit_ptrs[W];
+      float pack_chi2[W];
+      for(unsigned int i=0;i<output.size();i+=W)
       {
-        HelixKalmanState state = track_states[i];
-        
-        track_states[i].C *= 3.;
-        track_states[i].chi2 = 0.;
-        track_states[i].x_int = 0.;
-        track_states[i].y_int = 0.;
-        track_states[i].z_int = 0.;
-        //       track_states[i].position = output[i].hits.size();
-        track_states[i].position = 0;
-        for(int h=(output[i].hits.size() - 1);h>=0;--h)
+        unsigned int n = output.size() - i;
+        if(n > W){n = W;}
+        unsigned int max_hits = 0;
+        for(unsigned int c=0;c<n;++c)
         {
-          SimpleHit3D hit = output[i].hits[h];
-          float err_scale = 1.;
-          int layer = hit.layer;
-          if( (layer >= 0) && (layer < (int)(hit_error_scale.size()) ) ){err_scale = hit_error_scale[layer];}
-          err_scale *= 3.0;//fudge factor, like needed due to non-gaussian errors
-          hit.dx *= err_scale;hit.dy *= err_scale;hit.dz *= err_scale;
-          kalman->addHit(hit, track_states[i]);
-          track_states[i].position = h;
+          HelixKalmanState& state = track_states[i+c];
+          pack_chi2[c] = state.chi2;
+          state.C *= 3.;
+          state.chi2 = 0.;
+          state.x_int = 0.;
+          state.y_int = 0.;
+          state.z_int = 0.;
+          state.position = 0;
+          pack.set(c, state);
+          if(output[i+c].hits.size() > max_hits){max_hits = output[i+c].hits.size();}
+        }
+        for(unsigned int s=0;s<max_hits;++s)
+        {
+          for(unsigned int c=0;c<W;++c)
+          {
+            pack_hit_ptrs[c] = NULL;
+            if( (c >= n) || (s >= output[i+c].hits.size()) ){continue;}
+            SimpleHit3D& hit = pack_hits[c];
+            hit = output[i+c].hits[output[i+c].hits.size() - 1 - s];
+            float err_scale = 1.;
+            int layer = hit.layer;
+            if( (layer >= 0) && (layer < (int)(hit_error_scale.size()) ) ){err_scale = hit_error_scale[layer];}
+            err_scale *= 3.0;//fudge factor, like needed due to non-gaussian errors
+            hit.dx *= err_scale;hit.dy *= err_scale;hit.dz *= err_scale;
+            pack_hit_ptrs[c] = &hit;
+          }
+          kalman->addHits(pack_hit_ptrs, pack);
+          for(unsigned int c=0;c<n;++c)
+          {
+            if(pack_hit_ptrs[c] != NULL){pack.position[c] = output[i+c].hits.size() - 1 - s;}
+          }
+        }
+        for(unsigned int c=0;c<n;++c)
+        {
+          HelixKalmanState& state = track_states[i+c];
+          pack.get(c, state);
+          state.chi2 = pack_chi2[c];
+          state.C *= 2./3.;
+          
+          output[i+c].phi = state.phi;
+          output[i+c].d = state.d;
+          output[i+c].kappa = state.kappa;
+          output[i+c].z0 = state.z0;
+          output[i+c].dzdl = state.dzdl;
         }
-        
-        //       track_states[i].C = state.C;
-        track_states[i].chi2 = state.chi2;
-        track_states[i].C *= 2./3.;
-        
-        output[i].phi = track_states[i].phi;
-        output[i].d = track_states[i].d;
-        output[i].kappa = track_states[i].kappa;
-        output[i].z0 = track_states[i].z0;
-        output[i].dzdl = track_states[i].dzdl;
       }
-      else
+    }
+    else
+    {
+      for(unsigned int i=0;i<output.size();++i)
       {
         // HelixKalmanState state = track_states[i];
         
@@ -607,7 +637,8 @@ void sPHENIXTrackerTPC::findTracks(vector<SimpleHit3D>& hits, vector<SimpleTrack
 {
   findtracksiter += 1;
   #ifdef AVXHOUGH
-  findTracksBySegments_avx(hits,tracks,range);
+  if(HelixHoughISA::level() >= HelixHoughISA::AVX){findTracksBySegments_avx(hits,tracks,range);}
+  else{findTracksBySegments(hits,tracks,range);}
   #else
   findTracksBySegments(hits,tracks,range);
   #endif
@@ -325,6 +325,27 @@ class sPHENIXTrackerTPC : public HelixHough {
       float sinang_cut, float cosang_diff_inv, float* cur_kappa_a,
       float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a,
       float* chi2_a);
+  // 8 wide versions, only to be called if
+  // HelixHoughISA::level() >= HelixHoughISA::AVX
+  static void calculateKappaTangents_avx(
+      float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a,
+      float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a,
+      float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a,
+      float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a,
+      float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a,
+      float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a)
+      __attribute__((target("avx")));
+  static void calculateKappaTangents_avx(
+      float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a,
+      float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a,
+      float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a,
+      float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a,
+      float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a,
+      float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a,
+      float sinang_cut, float cosang_diff_inv, float* cur_kappa_a,
+      float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a,
+      float* chi2_a)
+      __attribute__((target("avx")));
   void projectToLayer(SimpleTrack3D& seed, unsigned int layer, float& x,
                       float& y, float& z);
   void findSeededTracksByProjection(std::vector<SimpleTrack3D>& seeds,
@@ -412,6 +433,9 @@ class sPHENIXTrackerTPC : public HelixHough {
     std::vector<SimpleHit3D> one_layer;
     layer_sorted.clear();
     layer_sorted.assign(n_layers, one_layer);
+    for (unsigned int i = 0; i < 4; ++i) {
+      layer_sorted_1[i].assign(n_layers, one_layer);
+    }
     temp_comb.assign(n_layers, 0);
     if (is_parallel == true) {
       for (unsigned int i = 0; i < thread_trackers.size(); ++i) {
@@ -500,6 +524,11 @@ class sPHENIXTrackerTPC : public HelixHough {
   void findTracksByCombinatorialKalman(std::vector<SimpleHit3D>& hits,
                                        std::vector<SimpleTrack3D>& tracks,
                                        const HelixRange& range);
+  // runs the Kalman filter over the first n candidates in the pack and
+  // keeps the ones passing the cuts, in order
+  void fitKalmanPack(std::vector<SimpleTrack3D>& candidates,
+                     HelixKalmanStatePack& states, unsigned int n,
+                     std::vector<SimpleTrack3D>& tracks);
 
   float fast_chi2_cut_par0;
   float fast_chi2_cut_par1;
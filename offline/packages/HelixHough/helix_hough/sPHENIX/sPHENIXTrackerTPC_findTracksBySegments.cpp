@@ -1,5 +1,7 @@
 #include "vector_math_inline.h"
 #include "sPHENIXTrackerTPC.h"
+#include "HelixHoughISA.h"
+#include "HelixKalmanStatePack.h"
 #include <cmath>
 #include <iostream>
 #include <algorithm>
@@ -1176,49 +1178,52 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
   }
   
   unsigned int hit_counter = 0;
-  float x1_a[4] __attribute__((aligned(16)));
-  float x2_a[4] __attribute__((aligned(16)));
-  float x3_a[4] __attribute__((aligned(16)));
-  float y1_a[4] __attribute__((aligned(16)));
-  float y2_a[4] __attribute__((aligned(16)));
-  float y3_a[4] __attribute__((aligned(16)));
-  float z1_a[4] __attribute__((aligned(16)));
-  float z2_a[4] __attribute__((aligned(16)));
-  float z3_a[4] __attribute__((aligned(16)));
-  
-  float dx1_a[4] __attribute__((aligned(16)));
-  float dx2_a[4] __attribute__((aligned(16)));
-  float dx3_a[4] __attribute__((aligned(16)));
-  float dy1_a[4] __attribute__((aligned(16)));
-  float dy2_a[4] __attribute__((aligned(16)));
-  float dy3_a[4] __attribute__((aligned(16)));
-  float dz1_a[4] __attribute__((aligned(16)));
-  float dz2_a[4] __attribute__((aligned(16)));
-  float dz3_a[4] __attribute__((aligned(16)));
-  
-  float kappa_a[4] __attribute__((aligned(16)));
-  float dkappa_a[4] __attribute__((aligned(16)));
-  
-  float ux_mid_a[4] __attribute__((aligned(16)));
-  float uy_mid_a[4] __attribute__((aligned(16)));
-  float ux_end_a[4] __attribute__((aligned(16)));
-  float uy_end_a[4] __attribute__((aligned(16)));
-  
-  float dzdl_1_a[4] __attribute__((aligned(16)));
-  float dzdl_2_a[4] __attribute__((aligned(16)));
-  float ddzdl_1_a[4] __attribute__((aligned(16)));
-  float ddzdl_2_a[4] __attribute__((aligned(16)));
-  
-  float cur_kappa_a[4] __attribute__((aligned(16)));
-  float cur_dkappa_a[4] __attribute__((aligned(16)));
-  float cur_ux_a[4] __attribute__((aligned(16)));
-  float cur_uy_a[4] __attribute__((aligned(16)));
-  float cur_chi2_a[4] __attribute__((aligned(16)));
-  float chi2_a[4] __attribute__((aligned(16)));
-  
-  unsigned int hit1[4];
-  unsigned int hit2[4];
-  unsigned int hit3[4];
+  // segments are fitted 8 at a time with AVX, 4 at a time otherwise
+  unsigned int lanes = 4;
+  if(HelixHoughISA::level() >= HelixHoughISA::AVX){lanes = 8;}
+  float x1_a[8] __attribute__((aligned(32)));
+  float x2_a[8] __attribute__((aligned(32)));
+  float x3_a[8] __attribute__((aligned(32)));
+  float y1_a[8] __attribute__((aligned(32)));
+  float y2_a[8] __attribute__((aligned(32)));
+  float y3_a[8] __attribute__((aligned(32)));
+  float z1_a[8] __attribute__((aligned(32)));
+  float z2_a[8] __attribute__((aligned(32)));
+  float z3_a[8] __attribute__((aligned(32)));
+  
+  float dx1_a[8] __attribute__((aligned(32)));
+  float dx2_a[8] __attribute__((aligned(32)));
+  float dx3_a[8] __attribute__((aligned(32)));
+  float dy1_a[8] __attribute__((aligned(32)));
+  float dy2_a[8] __attribute__((aligned(32)));
+  float dy3_a[8] __attribute__((aligned(32)));
+  float dz1_a[8] __attribute__((aligned(32)));
+  float dz2_a[8] __attribute__((aligned(32)));
+  float dz3_a[8] __attribute__((aligned(32)));
+  
+  float kappa_a[8] __attribute__((aligned(32)));
+  float dkappa_a[8] __attribute__((aligned(32)));
+  
+  float ux_mid_a[8] __attribute__((aligned(32)));
+  float uy_mid_a[8] __attribute__((aligned(32)));
+  float ux_end_a[8] __attribute__((aligned(32)));
+  float uy_end_a[8] __attribute__((aligned(32)));
+  
+  float dzdl_1_a[8] __attribute__((aligned(32)));
+  float dzdl_2_a[8] __attribute__((aligned(32)));
+  float ddzdl_1_a[8] __attribute__((aligned(32)));
+  float ddzdl_2_a[8] __attribute__((aligned(32)));
+  
+  float cur_kappa_a[8] __attribute__((aligned(32)));
+  float cur_dkappa_a[8] __attribute__((aligned(32)));
+  float cur_ux_a[8] __attribute__((aligned(32)));
+  float cur_uy_a[8] __attribute__((aligned(32)));
+  float cur_chi2_a[8] __attribute__((aligned(32)));
+  float chi2_a[8] __attribute__((aligned(32)));
+  
+  unsigned int hit1[8];
+  unsigned int hit2[8];
+  unsigned int hit3[8];
   
   TrackSegment temp_segment;temp_segment.hits.assign(n_layers, 0);
   // make segments out of first 3 layers
@@ -1257,9 +1262,10 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
         
         hit_counter += 1;
         
-        if(hit_counter == 4)
+        if(hit_counter == lanes)
         {
-          calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);
+          if(lanes == 8){calculateKappaTangents_avx(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);}
+          else{calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);}
           
           for(unsigned int h=0;h<hit_counter;++h)
           {
@@ -1289,7 +1295,8 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
   }
   if(hit_counter != 0)
   {
-    calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);
+    if(lanes == 8){calculateKappaTangents_avx(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);}
+    else{calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a);}
     
     for(unsigned int h=0;h<hit_counter;++h)
     {
@@ -1320,7 +1327,7 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
   
   
   // add hits to segments layer-by-layer, cutting out bad segments
-  unsigned int whichseg[4];
+  unsigned int whichseg[8];
   for(unsigned int l=3;l<n_layers;++l)
   {
     if(l == (n_layers-1)){easy_chi2_cut*=0.25;}
@@ -1361,9 +1368,10 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
         hit1[hit_counter] = j;
         
         hit_counter += 1;
-        if(hit_counter == 4)
+        if(hit_counter == lanes)
         {
-          calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);
+          if(lanes == 8){calculateKappaTangents_avx(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);}
+          else{calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);}
           
           for(unsigned int h=0;h<hit_counter;++h)
           {
@@ -1391,7 +1399,8 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
     }
     if(hit_counter != 0)
     {
-      calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);
+      if(lanes == 8){calculateKappaTangents_avx(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);}
+      else{calculateKappaTangents(x1_a, y1_a, z1_a, x2_a, y2_a, z2_a, x3_a, y3_a, z3_a, dx1_a, dy1_a, dz1_a, dx2_a, dy2_a, dz2_a, dx3_a, dy3_a, dz3_a, kappa_a, dkappa_a, ux_mid_a, uy_mid_a, ux_end_a, uy_end_a, dzdl_1_a, dzdl_2_a, ddzdl_1_a, ddzdl_2_a, sinang_cut, cosang_diff_inv, cur_kappa_a, cur_dkappa_a, cur_ux_a, cur_uy_a, cur_chi2_a, chi2_a);}
       
       for(unsigned int h=0;h<hit_counter;++h)
       {
@@ -1433,6 +1442,10 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
   SimpleTrack3D temp_track;
   temp_track.hits.assign(n_layers, SimpleHit3D());
   vector<SimpleHit3D> temp_hits;
+  // candidates passing the fast fit are filtered in packs
+  HelixKalmanStatePack kalman_pack;
+  vector<SimpleTrack3D> pack_tracks(HelixKalmanStatePack::width);
+  unsigned int npack = 0;
   for(unsigned int i=0,sizei=curseg_size;i<sizei;++i)
   {
     temp_track.hits.assign((*cur_seg)[i].n_hits, SimpleHit3D());
@@ -1492,19 +1505,58 @@ void sPHENIXTrackerTPC::findTracksBySegments(vector<SimpleHit3D>& hits, vector<S
     state.y_int = 0.;
     state.z_int = 0.;
         
-    for(unsigned int h=0;h<temp_track.hits.size();++h)
+    pack_tracks[npack] = temp_track;
+    kalman_pack.set(npack, state);
+    npack += 1;
+    if(npack == HelixKalmanStatePack::width)
     {
-      kalman->addHit(temp_track.hits[h], state);nfits+=1;
+      fitKalmanPack(pack_tracks, kalman_pack, npack, tracks);
+      npack = 0;
     }
     
-    // fudge factor for non-gaussian hit sizes
-    state.C *= 3.;
-    state.chi2 *= 6.;
-    
     gettimeofday(&t2, NULL);
     time1 = ((double)(t1.tv_sec) + (double)(t1.tv_usec)/1000000.);
     time2 = ((double)(t2.tv_sec) + (double)(t2.tv_usec)/1000000.);
     KALtime += (time2 - time1);
+  }
+  gettimeofday(&t1, NULL);
+  fitKalmanPack(pack_tracks, kalman_pack, npack, tracks);
+  gettimeofday(&t2, NULL);
+  time1 = ((double)(t1.tv_sec) + (double)(t1.tv_usec)/1000000.);
+  time2 = ((double)(t2.tv_sec) + (double)(t2.tv_usec)/1000000.);
+  KALtime += (time2 - time1);
+}
+
+
+void sPHENIXTrackerTPC::fitKalmanPack(vector<SimpleTrack3D>& candidates, HelixKalmanStatePack& states, unsigned int n, vector<SimpleTrack3D>& tracks)
+{
+  if(n == 0){return;}
+  
+  unsigned int max_hits = 0;
+  for(unsigned int c=0;c<n;++c)
+  {
+    if(candidates[c].hits.size() > max_hits){max_hits = candidates[c].hits.size();}
+  }
+  SimpleHit3D* pack_hits[HelixKalmanStatePack::width];
+  for(unsigned int h=0;h<max_hits;++h)
+  {
+    for(unsigned int c=0;c<HelixKalmanStatePack::width;++c)
+    {
+      pack_hits[c] = NULL;
+      if( (c < n) && (h < candidates[c].hits.size()) ){pack_hits[c] = &(candidates[c].hits[h]);nfits+=1;}
+    }
+    kalman->addHits(pack_hits, states);
+  }
+  
+  HelixKalmanState state;
+  for(unsigned int c=0;c<n;++c)
+  {
+    SimpleTrack3D& temp_track = candidates[c];
+    states.get(c, state);
+    
+    // fudge factor for non-gaussian hit sizes
+    state.C *= 3.;
+    state.chi2 *= 6.;
     
     if( !(temp_track.kappa == temp_track.kappa) ){continue;}
     if(temp_track.kappa > top_range.max_k){continue;}
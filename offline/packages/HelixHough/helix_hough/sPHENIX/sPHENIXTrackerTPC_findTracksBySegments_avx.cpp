@@ -1,5 +1,3 @@
-#ifdef AVXHOUGH
-
 #include "vector_math_inline_avx.h"
 #include "sPHENIXTrackerTPC.h"
 #include <cmath>
@@ -15,7 +13,7 @@ using namespace std;
 using namespace Eigen;
 
 
-static inline void __attribute__((always_inline)) calculateKappaTangents_avx(float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a, float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a, float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a, float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a, float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a, float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a)
+void sPHENIXTrackerTPC::calculateKappaTangents_avx(float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a, float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a, float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a, float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a, float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a, float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a)
 {
   static const __m256 two = {2., 2., 2., 2., 2., 2., 2., 2.};
   
@@ -161,7 +159,7 @@ static inline void __attribute__((always_inline)) calculateKappaTangents_avx(flo
 }
 
 
-static inline void __attribute__((always_inline)) calculateKappaTangents_avx(float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a, float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a, float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a, float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a, float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a, float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a, float sinang_cut, float cosang_diff_inv, float* cur_kappa_a, float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a, float* chi2_a)
+void sPHENIXTrackerTPC::calculateKappaTangents_avx(float* x1_a, float* y1_a, float* z1_a, float* x2_a, float* y2_a, float* z2_a, float* x3_a, float* y3_a, float* z3_a, float* dx1_a, float* dy1_a, float* dz1_a, float* dx2_a, float* dy2_a, float* dz2_a, float* dx3_a, float* dy3_a, float* dz3_a, float* kappa_a, float* dkappa_a, float* ux_mid_a, float* uy_mid_a, float* ux_end_a, float* uy_end_a, float* dzdl_1_a, float* dzdl_2_a, float* ddzdl_1_a, float* ddzdl_2_a, float sinang_cut, float cosang_diff_inv, float* cur_kappa_a, float* cur_dkappa_a, float* cur_ux_a, float* cur_uy_a, float* cur_chi2_a, float* chi2_a)
 {
   static const __m256 two = {2., 2., 2., 2., 2., 2., 2., 2.};
   
@@ -329,6 +327,9 @@ static inline void __attribute__((always_inline)) calculateKappaTangents_avx(flo
 }
 
 
+// batches the hits of 4 bins before building segments, selected at
+// build time with --enable-avx
+#ifdef AVXHOUGH
 void sPHENIXTrackerTPC::findTracksBySegments_avx(vector<SimpleHit3D>& hits, vector<SimpleTrack3D>& tracks, const HelixRange& range)
 {
   unsigned int allowed_missing = n_layers - req_layers;
@@ -10,6 +10,12 @@ using namespace Eigen;
 using namespace SeamStress;
 
 
+static bool task_order(const HoughTask* a, const HoughTask* b)
+{
+  return a->key < b->key;
+}
+
+
 void sPHENIXTracker::initSplitting(vector<SimpleHit3D>& hits, unsigned int min_hits, unsigned int max_hits)
 {
   initEvent(hits, min_hits);
@@ -45,24 +51,49 @@ void sPHENIXTracker::findHelicesParallelOneHelicity(vector<SimpleHit3D>& hits, u
     thread_trackers[i]->initSplitting(split_input_hits[i], thread_min_hits, thread_max_hits);
   }
   pins->sewStraight(&sPHENIXTracker::splitHitsParallelThread, nthreads);
-  thread_ranges.clear();
-  thread_hits.clear();
   
+  // every bin of the first zoom level becomes a task, dealt out round
+  // robin. Threads which run out of work steal from the others.
+  pending_tasks = 0;
   unsigned int nbins = split_output_hits[0]->size();
   for(unsigned int b=0;b<nbins;++b)
   {
-    thread_ranges.push_back( (*(split_ranges[0]))[b] );
-    thread_hits.push_back(vector<SimpleHit3D>());
+    HoughTask* task = new HoughTask();
+    task->key.push_back(b);
+    task->range = (*(split_ranges[0]))[b];
+    task->zoomlevel = 1;
     for(unsigned int i=0;i<nthreads;++i)
     {
       for(unsigned int j=0;j<(*(split_output_hits[i]))[b].size();++j)
       {
-        thread_hits.back().push_back( (*(split_output_hits[i]))[b][j] );
+        task->hits.push_back( (*(split_output_hits[i]))[b][j] );
       }
     }
+    if(task->hits.size() < min_hits)
+    {
+      delete task;
+      continue;
+    }
+    task_queues[pending_tasks % nthreads].push_back(task);
+    pending_tasks += 1;
   }
   
   pins->sewStraight(&sPHENIXTracker::findHelicesParallelThread, nthreads);
+  
+  // collect the output in bin order, independent of which thread ran what
+  vector<HoughTask*> tasks;
+  for(unsigned int i=0;i<nthreads;++i)
+  {
+    tasks.insert(tasks.end(), done_tasks[i].begin(), done_tasks[i].end());
+    done_tasks[i].clear();
+  }
+  sort(tasks.begin(), tasks.end(), task_order);
+  for(unsigned int t=0;t<tasks.size();++t)
+  {
+    thread_tracks.insert(thread_tracks.end(), tasks[t]->tracks.begin(), tasks[t]->tracks.end());
+    thread_states.insert(thread_states.end(), tasks[t]->states.begin(), tasks[t]->states.end());
+    delete tasks[t];
+  }
 }
 
 
@@ -71,9 +102,10 @@ void sPHENIXTracker::findHelicesParallel(vector<SimpleHit3D>& hits, unsigned int
   thread_min_hits = min_hits;
   thread_max_hits = max_hits;
   
+  thread_tracks.clear();
+  thread_states.clear();
   for(unsigned int i=0;i<nthreads;++i)
   {
-    thread_tracks[i].clear();
     thread_trackers[i]->clear();
     if(cluster_start_bin!=0){thread_trackers[i]->setClusterStartBin(cluster_start_bin-1);}
     else{thread_trackers[i]->setClusterStartBin(0);}
@@ -117,14 +149,10 @@ void sPHENIXTracker::findHelicesParallel(vector<SimpleHit3D>& hits, unsigned int
   }
   
   vector<SimpleTrack3D> temp_tracks;
-  for(unsigned int i=0;i<nthreads;++i)
+  for(unsigned int j=0;j<thread_tracks.size();++j)
   {
-    vector<HelixKalmanState>* states = &(thread_trackers[i]->getKalmanStates());
-    for(unsigned int j=0;j<thread_tracks[i].size();++j)
-    {
-      track_states.push_back((*states)[j]);
-      temp_tracks.push_back(thread_tracks[i][j]);
-    }
+    track_states.push_back(thread_states[j]);
+    temp_tracks.push_back(thread_tracks[j]);
   }
   finalize(temp_tracks, tracks);
 }
@@ -137,14 +165,121 @@ void sPHENIXTracker::splitHitsParallelThread(void* arg)
 }
 
 
+void sPHENIXTracker::pushTask(unsigned int w, HoughTask* task)
+{
+  pthread_mutex_lock(&(queue_mutexes[w]));
+  task_queues[w].push_back(task);
+  pthread_mutex_unlock(&(queue_mutexes[w]));
+  // wake one idle thread to steal it
+  pthread_mutex_lock(&pending_mutex);
+  pushed_tasks += 1;
+  pthread_cond_signal(&pending_cond);
+  pthread_mutex_unlock(&pending_mutex);
+}
+
+
+// newest task from our own queue, otherwise the oldest one of another
+// thread, which is the biggest piece of work it has left
+HoughTask* sPHENIXTracker::popTask(unsigned int w)
+{
+  HoughTask* task = NULL;
+  pthread_mutex_lock(&(queue_mutexes[w]));
+  if(task_queues[w].empty() == false)
+  {
+    task = task_queues[w].back();
+    task_queues[w].pop_back();
+  }
+  pthread_mutex_unlock(&(queue_mutexes[w]));
+  if(task != NULL){return task;}
+  
+  for(unsigned int i=1;i<nthreads;++i)
+  {
+    unsigned int v = (w + i)%nthreads;
+    pthread_mutex_lock(&(queue_mutexes[v]));
+    if(task_queues[v].empty() == false)
+    {
+      task = task_queues[v].front();
+      task_queues[v].pop_front();
+    }
+    pthread_mutex_unlock(&(queue_mutexes[v]));
+    if(task != NULL){return task;}
+  }
+  return NULL;
+}
+
+
+// search one bin.  With a split threshold the sub-bins with many hits
+// come back from findHelices unsearched and are queued as new tasks.
+// Hits used by a track are then not removed from those sub-bins, the
+// same as for the bins of the first zoom level.
+void sPHENIXTracker::runTask(unsigned int w, HoughTask* task)
+{
+  sPHENIXTracker* tracker = thread_trackers[w];
+  vector<HelixRange>& ranges = *(split_ranges[w]);
+  vector<vector<SimpleHit3D> >& bins = *(split_output_hits[w]);
+  ranges.clear();
+  bins.clear();
+  if(split_threshold != 0){tracker->setDeferBins(split_threshold, &ranges, &bins);}
+  else{tracker->setDeferBins(0, NULL, NULL);}
+  
+  vector<HelixKalmanState>& states = tracker->getKalmanStates();
+  unsigned int nstates = states.size();
+  tracker->setStartZoom(task->zoomlevel);
+  tracker->setTopRange(task->range);
+  tracker->findHelices(task->hits, thread_min_hits, thread_max_hits, task->tracks);
+  task->states.assign(states.begin() + nstates, states.end());
+  states.resize(nstates);
+  task->hits.clear();
+  
+  if(bins.empty() == false)
+  {
+    pthread_mutex_lock(&pending_mutex);
+    pending_tasks += bins.size();
+    pthread_mutex_unlock(&pending_mutex);
+    // queued back to front, so this thread takes them in order
+    for(unsigned int b=bins.size();b>0;--b)
+    {
+      HoughTask* sub = new HoughTask();
+      sub->key = task->key;
+      sub->key.push_back(b-1);
+      sub->range = ranges[b-1];
+      sub->zoomlevel = task->zoomlevel + 1;
+      sub->hits.swap(bins[b-1]);
+      pushTask(w, sub);
+    }
+  }
+  done_tasks[w].push_back(task);
+}
+
+
 void sPHENIXTracker::findHelicesParallelThread(void* arg)
 {
   unsigned long int w = (*((unsigned long int *)arg));
   
-  for(unsigned int i=w;i<thread_ranges.size();i+=nthreads)
+  while(true)
   {
-    if(thread_hits[i].size() == 0){continue;}
-    thread_trackers[w]->setTopRange(thread_ranges[i]);
-    thread_trackers[w]->findHelices(thread_hits[i], thread_min_hits, thread_max_hits, thread_tracks[w]);
+    pthread_mutex_lock(&pending_mutex);
+    unsigned int pushed = pushed_tasks;
+    pthread_mutex_unlock(&pending_mutex);
+    HoughTask* task = popTask(w);
+    if(task == NULL)
+    {
+      // a running task may still queue sub-bins, sleep until one is pushed
+      // after the queues were looked at or the last task is done
+      pthread_mutex_lock(&pending_mutex);
+      while((pending_tasks != 0) && (pushed_tasks == pushed))
+      {
+        pthread_cond_wait(&pending_cond, &pending_mutex);
+      }
+      unsigned int left = pending_tasks;
+      pthread_mutex_unlock(&pending_mutex);
+      if(left == 0){break;}
+      continue;
+    }
+    runTask(w, task);
+    pthread_mutex_lock(&pending_mutex);
+    pending_tasks -= 1;
+    if(pending_tasks == 0){pthread_cond_broadcast(&pending_cond);}
+    pthread_mutex_unlock(&pending_mutex);
   }
 }
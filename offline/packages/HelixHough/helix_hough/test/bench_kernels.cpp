@@ -0,0 +1,280 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <sys/time.h>
+#include "HelixHough.h"
+#include "HelixHoughISA.h"
+#include "sPHENIXTracker.h"
+
+using namespace std;
+
+
+// times the SIMD kernels of the vote and the segment fit for every
+// instruction set up to HelixHoughISA::level(), and checks them against
+// the scalar references (range kernels) or the SSE2 version (segment fit)
+//
+// usage: bench_kernels [repeats]
+
+
+static const unsigned int nhits = 4096;
+
+static float hit1_x[nhits] __attribute__((aligned(32)));
+static float hit1_y[nhits] __attribute__((aligned(32)));
+static float hit1_z[nhits] __attribute__((aligned(32)));
+static float hit2_x[nhits] __attribute__((aligned(32)));
+static float hit2_y[nhits] __attribute__((aligned(32)));
+static float hit2_z[nhits] __attribute__((aligned(32)));
+static float hit3_x[nhits] __attribute__((aligned(32)));
+static float hit3_y[nhits] __attribute__((aligned(32)));
+static float hit3_z[nhits] __attribute__((aligned(32)));
+static float dxy[nhits] __attribute__((aligned(32)));
+static float dz[nhits] __attribute__((aligned(32)));
+
+static float min_d[nhits] __attribute__((aligned(32)));
+static float max_d[nhits] __attribute__((aligned(32)));
+static float min_k[nhits] __attribute__((aligned(32)));
+static float max_k[nhits] __attribute__((aligned(32)));
+static float min_z0[nhits] __attribute__((aligned(32)));
+static float max_z0[nhits] __attribute__((aligned(32)));
+
+static float out[2][14][nhits] __attribute__((aligned(32)));
+
+
+static double now()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + 1.0e-6*t.tv_usec;
+}
+
+
+static float uniform(float lo, float hi)
+{
+  return lo + (hi - lo)*drand48();
+}
+
+
+// three hits at increasing radius on a helix from near the origin
+static void generate()
+{
+  float radius[3] = {2.3, 6.0, 12.0};
+  for(unsigned int i=0;i<nhits;++i)
+  {
+    float k = uniform(0.0005, 0.02);
+    float phi = uniform(0., 2.*M_PI);
+    float dzdl = uniform(-0.8, 0.8);
+    float z0 = uniform(-0.1, 0.1);
+    float* x[3] = {hit1_x, hit2_x, hit3_x};
+    float* y[3] = {hit1_y, hit2_y, hit3_y};
+    float* z[3] = {hit1_z, hit2_z, hit3_z};
+    for(unsigned int l=0;l<3;++l)
+    {
+      float s = 2.*asin(0.5*radius[l]*k)/k;
+      x[l][i] = (sin(phi + k*s) - sin(phi))/k + uniform(-0.001, 0.001);
+      y[l][i] = (cos(phi) - cos(phi + k*s))/k + uniform(-0.001, 0.001);
+      z[l][i] = z0 + s*dzdl/sqrt(1. - dzdl*dzdl) + uniform(-0.001, 0.001);
+    }
+    dxy[i] = 0.001;
+    dz[i] = 0.001;
+    min_d[i] = uniform(-0.1, 0.);
+    max_d[i] = min_d[i] + 0.02;
+    min_k[i] = uniform(0., 0.01);
+    max_k[i] = min_k[i] + 0.001;
+    min_z0[i] = uniform(-0.1, 0.08);
+    max_z0[i] = min_z0[i] + 0.02;
+  }
+}
+
+
+static float maxDeviation(unsigned int nout)
+{
+  float dev = 0.;
+  for(unsigned int o=0;o<nout;++o)
+  {
+    for(unsigned int i=0;i<nhits;++i)
+    {
+      float d = fabs(out[0][o][i] - out[1][o][i]);
+      if(d > dev){dev = d;}
+    }
+  }
+  return dev;
+}
+
+
+static void report(const char* kernel, const char* isa, double t, unsigned int repeats, float dev)
+{
+  printf("%-24s %-8s %8.2f ns/hit   max deviation %g\n", kernel, isa, 1.0e9*t/((double)repeats*nhits), dev);
+}
+
+
+static void benchPhiRange(unsigned int repeats)
+{
+  HelixHough::phiRange_scalar(nhits, hit2_x, hit2_y, min_d, max_d, min_k, max_k, out[0][0], out[0][1], out[0][2], out[0][3]);
+
+  double t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    HelixHough::phiRange_scalar(nhits, hit2_x, hit2_y, min_d, max_d, min_k, max_k, out[1][0], out[1][1], out[1][2], out[1][3]);
+  }
+  report("phiRange", "scalar", now() - t0, repeats, maxDeviation(4));
+
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=4)
+    {
+      HelixHough::phiRange_sse(hit2_x + i, hit2_y + i, min_d + i, max_d + i, min_k + i, max_k + i, out[1][0] + i, out[1][1] + i, out[1][2] + i, out[1][3] + i);
+    }
+  }
+  report("phiRange", "sse2", now() - t0, repeats, maxDeviation(4));
+
+  if(HelixHoughISA::level() < HelixHoughISA::AVX){return;}
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=8)
+    {
+      HelixHough::phiRange_avx(hit2_x + i, hit2_y + i, min_d + i, max_d + i, min_k + i, max_k + i, out[1][0] + i, out[1][1] + i, out[1][2] + i, out[1][3] + i);
+    }
+  }
+  report("phiRange", "avx", now() - t0, repeats, maxDeviation(4));
+}
+
+
+static void benchDzdlRange(unsigned int repeats)
+{
+  float phi = 0.3;
+  float cosphi1 = cos(phi);
+  float sinphi1 = sin(phi);
+  float cosphi2 = cos(phi + 0.01);
+  float sinphi2 = sin(phi + 0.01);
+  float k1 = 0.004;
+  float k2 = 0.005;
+  float d1 = -0.01;
+  float d2 = 0.01;
+
+  HelixHough::dzdlRange_scalar(nhits, hit2_x, hit2_y, hit2_z, cosphi1, sinphi1, cosphi2, sinphi2, k1, k2, d1, d2, min_z0, max_z0, out[0][0], out[0][1]);
+
+  double t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    HelixHough::dzdlRange_scalar(nhits, hit2_x, hit2_y, hit2_z, cosphi1, sinphi1, cosphi2, sinphi2, k1, k2, d1, d2, min_z0, max_z0, out[1][0], out[1][1]);
+  }
+  report("dzdlRange", "scalar", now() - t0, repeats, maxDeviation(2));
+
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=4)
+    {
+      HelixHough::dzdlRange_sse(hit2_x + i, hit2_y + i, hit2_z + i, cosphi1, sinphi1, cosphi2, sinphi2, k1, k2, d1, d2, min_z0 + i, max_z0 + i, out[1][0] + i, out[1][1] + i);
+    }
+  }
+  report("dzdlRange", "sse2", now() - t0, repeats, maxDeviation(2));
+
+  if(HelixHoughISA::level() < HelixHoughISA::AVX){return;}
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=8)
+    {
+      HelixHough::dzdlRange_avx(hit2_x + i, hit2_y + i, hit2_z + i, cosphi1, sinphi1, cosphi2, sinphi2, k1, k2, d1, d2, min_z0 + i, max_z0 + i, out[1][0] + i, out[1][1] + i);
+    }
+  }
+  report("dzdlRange", "avx", now() - t0, repeats, maxDeviation(2));
+}
+
+
+// the pairs are the first two hits of each helix
+static void benchAllButKappaRange(unsigned int repeats)
+{
+  float* o[2][14];
+  for(unsigned int s=0;s<2;++s)
+  {
+    for(unsigned int j=0;j<14;++j){o[s][j] = out[s][j];}
+  }
+
+  HelixHough::allButKappaRange_scalar(nhits, hit1_x, hit2_x, hit1_y, hit2_y, hit1_z, hit2_z, min_k, max_k, o[0][0], o[0][1], o[0][2], o[0][3], o[0][4], o[0][5], o[0][6], o[0][7], o[0][8], o[0][9], o[0][10], o[0][11], o[0][12], o[0][13]);
+
+  double t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    HelixHough::allButKappaRange_scalar(nhits, hit1_x, hit2_x, hit1_y, hit2_y, hit1_z, hit2_z, min_k, max_k, o[1][0], o[1][1], o[1][2], o[1][3], o[1][4], o[1][5], o[1][6], o[1][7], o[1][8], o[1][9], o[1][10], o[1][11], o[1][12], o[1][13]);
+  }
+  report("allButKappaRange", "scalar", now() - t0, repeats, maxDeviation(14));
+
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=4)
+    {
+      HelixHough::allButKappaRange_sse(hit1_x + i, hit2_x + i, hit1_y + i, hit2_y + i, hit1_z + i, hit2_z + i, min_k + i, max_k + i, o[1][0] + i, o[1][1] + i, o[1][2] + i, o[1][3] + i, o[1][4] + i, o[1][5] + i, o[1][6] + i, o[1][7] + i, o[1][8] + i, o[1][9] + i, o[1][10] + i, o[1][11] + i, o[1][12] + i, o[1][13] + i);
+    }
+  }
+  report("allButKappaRange", "sse2", now() - t0, repeats, maxDeviation(14));
+
+  if(HelixHoughISA::level() < HelixHoughISA::AVX){return;}
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=8)
+    {
+      HelixHough::allButKappaRange_avx(hit1_x + i, hit2_x + i, hit1_y + i, hit2_y + i, hit1_z + i, hit2_z + i, min_k + i, max_k + i, o[1][0] + i, o[1][1] + i, o[1][2] + i, o[1][3] + i, o[1][4] + i, o[1][5] + i, o[1][6] + i, o[1][7] + i, o[1][8] + i, o[1][9] + i, o[1][10] + i, o[1][11] + i, o[1][12] + i, o[1][13] + i);
+    }
+  }
+  report("allButKappaRange", "avx", now() - t0, repeats, maxDeviation(14));
+}
+
+
+// the AVX fit is compared to the SSE2 one, which it has to reproduce exactly
+static void benchKappaTangents(unsigned int repeats)
+{
+  float* o[2][8];
+  for(unsigned int s=0;s<2;++s)
+  {
+    for(unsigned int j=0;j<8;++j){o[s][j] = out[s][j];}
+  }
+  static float ddzdl_1[nhits] __attribute__((aligned(32)));
+  static float ddzdl_2[nhits] __attribute__((aligned(32)));
+
+  double t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=4)
+    {
+      sPHENIXTracker::calculateKappaTangents(hit1_x + i, hit1_y + i, hit1_z + i, hit2_x + i, hit2_y + i, hit2_z + i, hit3_x + i, hit3_y + i, hit3_z + i, dxy + i, dxy + i, dz + i, dxy + i, dxy + i, dz + i, dxy + i, dxy + i, dz + i, o[0][0] + i, o[0][1] + i, o[0][2] + i, o[0][3] + i, o[0][4] + i, o[0][5] + i, o[0][6] + i, o[0][7] + i, ddzdl_1 + i, ddzdl_2 + i);
+    }
+  }
+  report("calculateKappaTangents", "sse2", now() - t0, repeats, 0.);
+
+  if(HelixHoughISA::level() < HelixHoughISA::AVX){return;}
+  t0 = now();
+  for(unsigned int r=0;r<repeats;++r)
+  {
+    for(unsigned int i=0;i<nhits;i+=8)
+    {
+      sPHENIXTracker::calculateKappaTangents_avx(hit1_x + i, hit1_y + i, hit1_z + i, hit2_x + i, hit2_y + i, hit2_z + i, hit3_x + i, hit3_y + i, hit3_z + i, dxy + i, dxy + i, dz + i, dxy + i, dxy + i, dz + i, dxy + i, dxy + i, dz + i, o[1][0] + i, o[1][1] + i, o[1][2] + i, o[1][3] + i, o[1][4] + i, o[1][5] + i, o[1][6] + i, o[1][7] + i, ddzdl_1 + i, ddzdl_2 + i);
+    }
+  }
+  report("calculateKappaTangents", "avx", now() - t0, repeats, maxDeviation(8));
+}
+
+
+int main(int argc, char** argv)
+{
+  unsigned int repeats = 1000;
+  if(argc > 1){repeats = atoi(argv[1]);}
+
+  cout<<"cpu supports "<<HelixHoughISA::name(HelixHoughISA::detected())<<", level "<<HelixHoughISA::name(HelixHoughISA::level())<<", kernels use "<<HelixHoughISA::name(HelixHoughISA::kernels())<<endl;
+
+  srand48(1);
+  generate();
+
+  benchPhiRange(repeats);
+  benchDzdlRange(repeats);
+  benchAllButKappaRange(repeats);
+  benchKappaTangents(repeats);
+
+  return 0;
+}
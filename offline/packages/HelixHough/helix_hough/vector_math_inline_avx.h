@@ -1,8 +1,11 @@
-#ifdef AVXHOUGH
-
 #include <immintrin.h>
 
+// the functions are compiled for AVX whatever the flags of the including
+// file, they may only be called from functions with the same target
+
 
+static const __m256 pi_256 = {0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f, 0x3.243f6a8885a308d4p0f};
+static const __m256 twopi_256 = {0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f, 0x6.487ed5110b4611a8p0f};
 static const __m256 pi_over_two_256 = {0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f, 0x1.921fb54442d1846ap0f};
 static const __m256 pi_over_four_256 = {0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f, 0xc.90fdaa22168c2350p-4f};
 static const __m256 three_256 = {3., 3., 3., 3., 3., 3., 3., 3.};
@@ -20,36 +23,37 @@ static const __m256 sqrt2_plus_1_256 = {0x2.6a09e667f3bcc9080p0f, 0x2.6a09e667f3
 static const unsigned int sign_int_256[8] __attribute__((aligned(32))) = {0x80000000,0x80000000,0x80000000,0x80000000,0x80000000,0x80000000,0x80000000,0x80000000};
 
 
-static inline __m256  __attribute__((always_inline)) _mm256_cmplt_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
-static inline __m256  __attribute__((always_inline)) _mm256_cmpgt_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
-static inline __m256  __attribute__((always_inline)) _mm256_cmpeq_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+static inline __m256  __attribute__((always_inline, target("avx"))) _mm256_cmplt_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline __m256  __attribute__((always_inline, target("avx"))) _mm256_cmple_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+static inline __m256  __attribute__((always_inline, target("avx"))) _mm256_cmpgt_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline __m256  __attribute__((always_inline, target("avx"))) _mm256_cmpeq_ps(__m256 a, __m256 b){ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
 
 
-static inline __m256  __attribute__((always_inline)) _mm256_load1_ps(float x){ return _mm256_set_ps(x, x, x, x, x, x, x, x); }
+static inline __m256  __attribute__((always_inline, target("avx"))) _mm256_load1_ps(float x){ return _mm256_set_ps(x, x, x, x, x, x, x, x); }
 
 
-inline __m256 __attribute__((always_inline)) _vec256_rsqrt_ps(__m256 x)
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_rsqrt_ps(__m256 x)
 {
   __m256 x0 = _mm256_rsqrt_ps(x);
   return _mm256_mul_ps( one_o_2_256, _mm256_mul_ps( x0, _mm256_sub_ps( three_256, _mm256_mul_ps( x0, _mm256_mul_ps(x0, x) ) ) ) );
 }
 
 
-inline __m256 __attribute__((always_inline)) _vec256_sqrt_ps(__m256 x)
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_sqrt_ps(__m256 x)
 {
   __m256 x0 = _mm256_rsqrt_ps(x);
   return _mm256_mul_ps(_mm256_mul_ps( one_o_2_256, _mm256_mul_ps( x0, _mm256_sub_ps( three_256, _mm256_mul_ps( x0, _mm256_mul_ps(x0, x) ) ) ) ), x);
 }
 
 
-inline __m256 __attribute__((always_inline)) _vec256_rec_ps(__m256 x)
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_rec_ps(__m256 x)
 {
   __m256 a = _vec256_rsqrt_ps(x);
   return _mm256_mul_ps(a, a);
 }
 
 
-inline void __attribute__((always_inline)) _vec256_fabs_ps(__m256 &v)
+inline void __attribute__((always_inline, target("avx"))) _vec256_fabs_ps(__m256 &v)
 {
   __m256i vec_sgn = _mm256_load_si256((__m256i*)sign_int_256);
   v = _mm256_andnot_ps((__m256)vec_sgn, v);
@@ -58,7 +62,7 @@ inline void __attribute__((always_inline)) _vec256_fabs_ps(__m256 &v)
 
 
 
-inline __m256 __attribute__((always_inline)) _vec256_atan_ps(__m256 x)
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_atan_ps(__m256 x)
 {
   __m256i vec_sgn;
   __m256 x_sign;
@@ -113,4 +117,120 @@ inline __m256 __attribute__((always_inline)) _vec256_atan_ps(__m256 x)
 }
 
 
-#endif
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_atan2_ps(__m256 y, __m256 x)
+{
+  __m256 eq0 = _mm256_cmpeq_ps(x, zero_256);
+  __m256 ratio = _mm256_div_ps(y, x);
+  __m256 atanval = _vec256_atan_ps(ratio);
+  __m256 zero_pio2 = _mm256_and_ps(eq0, pi_over_two_256);
+  __m256i vec_sgn = _mm256_load_si256((__m256i*)sign_int_256);
+  __m256 y_sign = _mm256_and_ps((__m256)vec_sgn, y);
+  __m256 less0 = _mm256_cmplt_ps(x, zero_256);
+  zero_pio2 = _mm256_xor_ps(y_sign, zero_pio2);
+  __m256 zero_pi = _mm256_and_ps(less0, pi_256);
+  zero_pi = _mm256_xor_ps(y_sign, zero_pi);
+  atanval = _mm256_andnot_ps(eq0, atanval);
+  atanval = _mm256_add_ps(zero_pio2, atanval);
+  atanval = _mm256_add_ps(zero_pi, atanval);
+  
+  return atanval;
+}
+
+
+static const __m256 twoTo23_256 = {0x1.0p23f, 0x1.0p23f, 0x1.0p23f, 0x1.0p23f, 0x1.0p23f, 0x1.0p23f, 0x1.0p23f, 0x1.0p23f};
+
+
+// same steps as _vec_floor_ps, the integer shifts for fabs become a mask
+// since AVX has no 256 bit integer operations
+inline __m256 __attribute__((always_inline, target("avx"))) _vec256_floor_ps(__m256 v)
+{
+  // b = fabs(v)
+  __m256 b = _mm256_andnot_ps((__m256)_mm256_load_si256((__m256i*)sign_int_256), v);
+  // The essence of the floor routine
+  __m256 d = _mm256_sub_ps( _mm256_add_ps( _mm256_add_ps( _mm256_sub_ps( v, twoTo23_256 ), twoTo23_256 ), twoTo23_256 ), twoTo23_256 );
+  // ?1 if v >= 2**23
+  __m256 largeMaskE = _mm256_cmpgt_ps( b, twoTo23_256 );
+  // Check for possible off by one error
+  __m256 g = _mm256_cmplt_ps( v, d );
+  // Convert positive check result to -1.0, negative to 0.0
+  __m256 h = _mm256_cvtepi32_ps( (__m256i) g );
+  // Add in the error if there is one
+  __m256 t = _mm256_add_ps( d, h );
+  //Select between output result and input value based on v >= 2**23
+  v = _mm256_and_ps( v, largeMaskE );
+  t = _mm256_andnot_ps( largeMaskE, t );
+  return _mm256_or_ps( t, v );
+}
+
+
+static const __m256 one_over_twopi_256 = {0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f, 0x2.8be60db9391054ap-4f};
+
+static const __m256 fourth_256 = {0x0.4p0f, 0x0.4p0f, 0x0.4p0f, 0x0.4p0f, 0x0.4p0f, 0x0.4p0f, 0x0.4p0f, 0x0.4p0f};
+static const __m256 half_256 = {0x0.8p0f, 0x0.8p0f, 0x0.8p0f, 0x0.8p0f, 0x0.8p0f, 0x0.8p0f, 0x0.8p0f, 0x0.8p0f};
+
+static const __m256 sinC0_256 = {0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f, 0x6.487c58e5205cd791p0f};
+static const __m256 sinC1_256 = {-0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f, -0x2.955c385f44a6765fp4f};
+static const __m256 sinC2_256 = {0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f, 0x5.145d3f35fa67830ep4f};
+static const __m256 sinC3_256 = {-0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f, -0x4.65f4793b5cd9628fp4f};
+
+
+inline void __attribute__((always_inline, target("avx"))) _vec256_sin_cos_ps(__m256 x, __m256 &s, __m256 &c)
+{
+  //we will compute via a polynomial for sin(2*pi*x)
+  //sin(x) = sin(2*pi*(x/2*pi)), so first we divide x by 2*pi
+  x = _mm256_mul_ps(x, one_over_twopi_256);
+  //set x to the fractional part of x
+  x = _mm256_sub_ps(x, _vec256_floor_ps(x));
+  //subtract 1/2 from x if x>1/2
+  __m256 mod_half = _mm256_cmpgt_ps(x, half_256);
+  __m256 t1 = _mm256_andnot_ps(mod_half, zero_256);
+  __m256 t2 = _mm256_and_ps(mod_half, half_256);
+  t1 = _mm256_xor_ps(t1, t2);
+  x = _mm256_sub_ps(x, t1);
+  //subtract 1/4 from x if x>1/4
+  __m256 mod_fourth = _mm256_cmpgt_ps(x, fourth_256);
+  t1 = _mm256_andnot_ps(mod_fourth, zero_256);
+  t2 = _mm256_and_ps(mod_fourth, fourth_256);
+  t1 = _mm256_xor_ps(t1, t2);
+  x = _mm256_sub_ps(x, t1);
+  //z = 1/4 - x
+  __m256 z = _mm256_sub_ps(fourth_256, x);
+  //compute t1 = sin(x) from a Chebyshev polynomial (in monomial form) using Horner's scheme
+  //if we were using higher precision we would want to calculate sqrt(1 - [sin(x)]^2), but for this low precision we will just use the polynomial again
+  //compute k1 = sin(z) from a Chebyshev polynomial (in monomial form) using Horner's scheme
+  __m256 k1, k2, x2, z2;
+  x2 = _mm256_mul_ps(x, x);
+  z2 = _mm256_mul_ps(z, z);
+  t1 = _mm256_mul_ps(x2, sinC3_256);
+  k1 = _mm256_mul_ps(z2, sinC3_256);
+  t1 = _mm256_add_ps(t1, sinC2_256);
+  k1 = _mm256_add_ps(k1, sinC2_256);
+  t2 = _mm256_mul_ps(x2, t1);
+  k2 = _mm256_mul_ps(z2, k1);
+  t2 = _mm256_add_ps(t2, sinC1_256);
+  k2 = _mm256_add_ps(k2, sinC1_256);
+  t1 = _mm256_mul_ps(x2, t2);
+  k1 = _mm256_mul_ps(z2, k2);
+  t1 = _mm256_add_ps(t1, sinC0_256);
+  k1 = _mm256_add_ps(k1, sinC0_256);
+  t1 = _mm256_mul_ps(t1, x);
+  k1 = _mm256_mul_ps(k1, z);
+  
+  //set s and c to the appropriate magnitudes of sin and cosine
+  s = _mm256_andnot_ps(mod_fourth, t1);
+  t2 = _mm256_and_ps(mod_fourth, k1);
+  s = _mm256_xor_ps(s, t2);
+  
+  c = _mm256_andnot_ps(mod_fourth, k1);
+  k2 = _mm256_and_ps(mod_fourth, t1);
+  c = _mm256_xor_ps(c, k2);
+  
+  //set the appropriate signs of s and c
+  __m256i vec_sgn = _mm256_load_si256((__m256i*)sign_int_256);
+  __m256 x_sign = _mm256_and_ps(mod_half, (__m256)vec_sgn);
+  s = _mm256_xor_ps(s, x_sign);
+  
+  __m256 mod_cos = _mm256_xor_ps(mod_fourth, mod_half);
+  x_sign = _mm256_and_ps(mod_cos, (__m256)vec_sgn);
+  c = _mm256_xor_ps(c, x_sign);
+}
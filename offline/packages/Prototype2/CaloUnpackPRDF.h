@@ -29,11 +29,19 @@ class CaloUnpackPRDF : public SubsysReco
   
   void CreateNodeTree(PHCompositeNode *topNode);
 
+  //! fit the pulses right after unpacking and store peak and time in the
+  //! raw towers, method is one of PROTOTYPE2_FEM::enu_SampleFitMethod.
+  //! Default (-1) leaves the energy at NAN for CaloCalibration to fill
+  void set_fit_method(const int method) {_fit_method = method;}
+
  private:
 
+  void FitTowers(RawTowerContainer *towers);
+
   Event* _event;
   Packet_hbd_fpgashort* _packet;
   int _nevents; 
+  int _fit_method;
 
   // HCAL node
   PHCompositeNode * dst_node;
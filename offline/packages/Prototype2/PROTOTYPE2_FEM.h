@@ -49,6 +49,56 @@ namespace PROTOTYPE2_FEM
   double
   SignalShape_PowerLawExp(double *x, double *par);
 
+  //! Methods for fitting the power-law + exp pulse
+  enum enu_SampleFitMethod
+  {
+    //! Minuit fit with TF1 and TGraph, SampleFit_PowerLawExp. Slow, kept for validation
+    kSampleFit_ROOT = 0,
+
+    //! Levenberg-Marquardt fit with analytic derivatives, same shape,
+    //! start values and parameter limits as the Minuit fit
+    kSampleFit_Fast = 1,
+
+    //! power and decay fixed, only amplitude, start and pedestal are fit
+    kSampleFit_Template = 2
+  };
+
+  //! Same fit as SampleFit_PowerLawExp without ROOT objects
+  bool
+  SampleFit_PowerLawExp_Fast(//
+      const std::vector<double> & samples, //
+      double & peak,//
+      double & peak_sample,//
+      double & pedstal, //
+      const int verbosity = 0
+      );
+
+  //! Fit with a fixed pulse shape. For a given start sample the amplitude
+  //! and pedestal follow from a linear fit, the start sample is scanned.
+  bool
+  SampleFit_PowerLawExp_Template(//
+      const std::vector<double> & samples, //
+      double & peak,//
+      double & peak_sample,//
+      double & pedstal, //
+      const double power = 4., //
+      const double decay = 1.5, //
+      const int verbosity = 0
+      );
+
+  //! Fit all channels of an event with one call. The NSAMPLES samples of
+  //! channel i start at samples[i * NSAMPLES], results go to element i.
+  void
+  SampleFit_PowerLawExp_Batch(//
+      const int nchannel, //
+      const double * samples, //
+      double * peak,//
+      double * peak_sample,//
+      double * pedstal, //
+      const int method = kSampleFit_Fast, //
+      const int verbosity = 0
+      );
+
 }
 
 #endif
@@ -14,7 +14,7 @@ ClassImp(RawTower_Prototype2)
 
 RawTower_Prototype2::RawTower_Prototype2() :
     towerid(~0), // initialize all bits on
-    energy(0), time(NAN), HBD_channel(-1)
+    energy(0), time(NAN), HBD_channel(-1), pedstal(NAN)
 {
   for (int i=0; i<NSAMPLES; ++i  ) signal_samples[i] = -9999;
 }
@@ -25,17 +25,18 @@ RawTower_Prototype2::RawTower_Prototype2(const RawTower & tower)
   energy = (tower.get_energy());
   time = (tower.get_time());
   HBD_channel = -1;
+  pedstal = NAN;
   for (int i=0; i<NSAMPLES; ++i  ) signal_samples[i] = -9999;
 }
 
 RawTower_Prototype2::RawTower_Prototype2(RawTowerDefs::keytype id) :
-    towerid(id), energy(0), time(NAN), HBD_channel(-1)
+    towerid(id), energy(0), time(NAN), HBD_channel(-1), pedstal(NAN)
 {
   for (int i=0; i<NSAMPLES; ++i  ) signal_samples[i] = -9999;
 }
 
 RawTower_Prototype2::RawTower_Prototype2(const unsigned int icol, const unsigned int irow) :
-    towerid(0), energy(0), time(NAN), HBD_channel(-1)
+    towerid(0), energy(0), time(NAN), HBD_channel(-1), pedstal(NAN)
 {
   towerid = RawTowerDefs::encode_towerid(RawTowerDefs::NONE, icol, irow);
   for (int i=0; i<NSAMPLES; ++i  ) signal_samples[i] = -9999;
@@ -43,7 +44,7 @@ RawTower_Prototype2::RawTower_Prototype2(const unsigned int icol, const unsigned
 
 RawTower_Prototype2::RawTower_Prototype2(const RawTowerDefs::CalorimeterId caloid,
     const unsigned int ieta, const unsigned int iphi) :
-    towerid(0), energy(0), time(NAN), HBD_channel(-1)
+    towerid(0), energy(0), time(NAN), HBD_channel(-1), pedstal(NAN)
 {
   towerid = RawTowerDefs::encode_towerid(caloid, ieta, iphi);
   for (int i=0; i<NSAMPLES; ++i  ) signal_samples[i] = -9999;
@@ -58,6 +59,7 @@ RawTower_Prototype2::Reset()
 {
   energy = 0;
   time = NAN;
+  pedstal = NAN;
 }
 
 int
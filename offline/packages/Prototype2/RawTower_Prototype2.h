@@ -17,6 +17,8 @@ class RawTower_Prototype2 : public RawTower {
              const unsigned int iphi);
   virtual ~RawTower_Prototype2();
 
+  RawTower_Prototype2* clone() const { return new RawTower_Prototype2(*this); }
+
   void Reset();
   int isValid() const;
   void identify(std::ostream& os = std::cout) const;
@@ -46,6 +48,11 @@ class RawTower_Prototype2 : public RawTower {
     { HBD_channel=i; }
   int get_HBD_channel_number() const
     { return HBD_channel; }
+  //! pedestal of the fit which set energy and time, NAN if no fit ran in this job
+  void set_pedstal(const double p)
+    { pedstal = p; }
+  double get_pedstal() const
+    { return pedstal; }
 
   //---Fits------------------------------------------------------------
 
@@ -65,6 +72,8 @@ class RawTower_Prototype2 : public RawTower {
   //Signal samples from DATA
   signal_type signal_samples[NSAMPLES];  //Low Gain
   int HBD_channel;
+  //! not written to the DST, lets CaloCalibration reuse the fit of the unpacker
+  float pedstal; //!
 
   ClassDef(RawTower_Prototype2, 3)
 };
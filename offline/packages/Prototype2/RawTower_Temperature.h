@@ -14,6 +14,8 @@ class RawTower_Temperature : public RawTower {
   RawTower_Temperature(RawTowerDefs::keytype id);
   virtual ~RawTower_Temperature();
 
+  RawTower_Temperature* clone() const { return new RawTower_Temperature(*this); }
+
   //  void set_id(RawTowerDefs::keytype id) { towerid = id; }
 
   void Reset();
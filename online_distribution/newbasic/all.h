@@ -5,6 +5,7 @@
 //#include "fifo_mode.h"
 #include "etEventiterator.h"
 #include "fileEventiterator.h"
+#include "mmapEventiterator.h"
 #include "listEventiterator.h"
 #include "testEventiterator.h"
 #include "oncsetEventiterator.h"
@@ -7,6 +7,7 @@
 #pragma link C++ class Packet-!;
 #pragma link C++ class testEventiterator-!;
 #pragma link C++ class fileEventiterator-!;
+#pragma link C++ class mmapEventiterator-!;
 #pragma link C++ class listEventiterator-!;
 #pragma link C++ class oncsEventiterator-!;
 #pragma link C++ class rcdaqEventiterator-!;
@@ -0,0 +1,318 @@
+//
+// mmapEventiterator
+//
+// this iterator reads events from a data file which is mapped into
+// memory. Uncompressed buffers are handed to the buffer classes in place,
+// compressed ones are decoded into a single reused buffer.
+
+
+#include <stddef.h>
+#include <string.h>
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+
+#include "mmapEventiterator.h"
+#include "prdfBuffer.h"
+
+#include <zlib.h>
+#include <lzo/lzo1x.h>
+
+static int lzo_initialized = 0;
+
+mmapEventiterator::~mmapEventiterator()
+{
+  if (bptr != NULL ) delete bptr;
+  if (mapaddr != NULL) munmap(mapaddr, mapsize);
+  if (fd > 0) close (fd);
+  if (thefilename != NULL) delete [] thefilename;
+  if (decodebuffer != NULL) delete [] decodebuffer;
+}
+
+
+mmapEventiterator::mmapEventiterator(const char *filename)
+{
+  open_file ( filename);
+}
+
+mmapEventiterator::mmapEventiterator(const char *filename, int &status)
+{
+  status =  open_file ( filename);
+}
+
+
+int mmapEventiterator::open_file(const char *filename)
+{
+  fd  = open (filename, O_RDONLY | O_LARGEFILE);
+  mapaddr = 0;
+  mapsize = 0;
+  offset = 0;
+  buffer_start = 0;
+  buffer_length = 0;
+  decodebuffer = 0;
+  decodesize = 0;
+  bptr = 0;
+  thefilename = NULL;
+  events_so_far = 0;
+  verbosity=0;
+  _defunct = 0;
+  last_read_status = 1;
+
+  if (fd <= 0)
+    {
+      _defunct = 1;
+      return 1;
+    }
+
+  struct stat st;
+  if ( fstat(fd, &st) || st.st_size < BUFFERBLOCKSIZE)
+    {
+      _defunct = 1;
+      return 1;
+    }
+  mapsize = st.st_size;
+
+  // the mapping is private and writable since the buffer classes
+  // byte-swap foreign endian data in place. Pages which are not
+  // swapped are never copied.
+  void *addr = mmap(0, mapsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (addr == MAP_FAILED)
+    {
+      COUT << "mmapEventiterator: could not map " << filename << std::endl;
+      mapsize = 0;
+      _defunct = 1;
+      return 1;
+    }
+  mapaddr = (char *) addr;
+  madvise(mapaddr, mapsize, MADV_SEQUENTIAL);
+
+  thefilename = new char[strlen(filename)+1];
+  strcpy (thefilename, filename);
+  last_read_status = 0;
+  return 0;
+}
+
+
+
+void mmapEventiterator::identify (OSTREAM &os) const
+{
+  os << "mmapEventiterator reading from " << thefilename;
+  if ( _defunct ) os << " *** defunct";
+  os<< std::endl;
+
+};
+
+
+const char * mmapEventiterator::getCurrentFileName() const
+{
+  static char namestr[512];
+  if ( thefilename == NULL)
+    {
+      return " ";
+    }
+  else
+    {
+      strcpy (namestr, thefilename);
+      return namestr;
+    }
+};
+
+
+
+
+const char *  mmapEventiterator::getIdTag () const
+{
+  return "mmapEventiterator";
+};
+
+
+
+Event * mmapEventiterator::getNextEvent()
+{
+  if ( _defunct ) return 0;
+  Event *evt = 0;
+
+  // if we had a read error before, we just return
+  if (last_read_status) return NULL;
+
+  // see if we have a buffer to read
+  if (bptr == 0)
+    {
+      if ( (last_read_status = read_next_buffer()) !=0 )
+	{
+	  return NULL;
+	}
+    }
+
+  while (last_read_status == 0)
+    {
+      if (bptr) evt =  bptr->getEvent();
+      if (evt)
+	{
+	  events_so_far++;
+	  return evt;
+	}
+      last_read_status = read_next_buffer();
+    }
+
+  return NULL;
+
+}
+
+// -----------------------------------------------------
+// drop the buffer we are done with. The Event objects handed out
+// for it are stale now (same as in the fileEventiterator where the
+// memory gets overwritten by the next read), so the pages can go.
+
+void mmapEventiterator::release_buffer()
+{
+  if (bptr)
+    {
+      delete bptr;
+      bptr = 0;
+    }
+  if (buffer_start)
+    {
+      madvise(buffer_start, buffer_length, MADV_DONTNEED);
+      buffer_start = 0;
+      buffer_length = 0;
+    }
+}
+
+// -----------------------------------------------------
+// this is a private function to locate the next buffer
+// in the mapping
+
+int mmapEventiterator::read_next_buffer()
+{
+  release_buffer();
+  events_so_far = 0;
+
+  PHDWORD *bp = 0;
+  unsigned int buffer_size = 0;
+  unsigned int marker = 0;
+
+  // skip 8k records until we find a valid buffer marker
+  // (we usually find it right away).
+  while (buffer_size == 0 )
+    {
+      // error or EoF?
+      if ( offset + BUFFERBLOCKSIZE > mapsize)
+	{
+	  return -1;
+	}
+
+      bp = (PHDWORD *) (mapaddr + offset);
+      if (bp[1] == BUFFERMARKER || bp[1]== GZBUFFERMARKER
+	  ||  bp[1]== LZO1XBUFFERMARKER || bp[1]== ONCSBUFFERMARKER)
+	{
+	  marker = bp[1];
+	  buffer_size = bp[0];
+	}
+      else
+	{
+	  marker = buffer::u4swap(bp[1]);
+	  if (marker == BUFFERMARKER || marker == GZBUFFERMARKER || marker ==  LZO1XBUFFERMARKER || marker == ONCSBUFFERMARKER)
+	    {
+	      buffer_size = buffer::u4swap(bp[0]);
+	    }
+	}
+      if (buffer_size == 0) offset += BUFFERBLOCKSIZE;
+    }
+
+  unsigned long long length = (buffer_size +BUFFERBLOCKSIZE-1) /BUFFERBLOCKSIZE;
+  length *= BUFFERBLOCKSIZE;
+
+  int errorinread = 0;
+  if ( offset + length > mapsize)
+    {
+      COUT << "error in buffer, salvaging" << std::endl;
+      length = ((mapsize - offset) / BUFFERBLOCKSIZE) * BUFFERBLOCKSIZE;
+      errorinread = 1;
+    }
+
+  buffer_start = mapaddr + offset;
+  buffer_length = length;
+  offset += length;
+
+  if ( marker == GZBUFFERMARKER || marker == LZO1XBUFFERMARKER )
+    {
+      if (errorinread)
+	{
+	  return -3;
+	}
+      return decode_buffer(bp);
+    }
+
+  if (errorinread)
+    {
+      bp[0] = length;
+    }
+
+  return buffer::makeBuffer( bp, length/4, &bptr);
+
+}
+
+// -----------------------------------------------------
+// decompress a gzip or lzo buffer into the reused decode buffer
+// and wrap it in a plain prdfBuffer
+
+int mmapEventiterator::decode_buffer(PHDWORD *bp)
+{
+  int is_lzo = ( bp[1] == LZO1XBUFFERMARKER || buffer::u4swap(bp[1]) == LZO1XBUFFERMARKER );
+
+  unsigned int bytes;
+  unsigned int outputlength_in_bytes;
+  if (bp[1] == GZBUFFERMARKER || bp[1] == LZO1XBUFFERMARKER )
+    {
+      bytes = bp[0]-4*BUFFERHEADERLENGTH;
+      outputlength_in_bytes = bp[3];
+    }
+  else
+    {
+      bytes = buffer::i4swap(bp[0])-16;
+      outputlength_in_bytes = buffer::i4swap(bp[3]);
+    }
+
+  unsigned int outputlength =  (outputlength_in_bytes+3)/4;
+  if ( outputlength > decodesize)
+    {
+      if (decodebuffer) delete [] decodebuffer;
+      decodesize = outputlength;
+      decodebuffer = new PHDWORD[decodesize];
+    }
+
+  if (is_lzo)
+    {
+      if ( !  lzo_initialized )
+	{
+	  if (lzo_init() != LZO_E_OK)
+	    {
+	      COUT << "Could not initialize LZO" << std::endl;
+	      return -3;
+	    }
+	  lzo_initialized = 1;
+	}
+      lzo_uint olen = outputlength_in_bytes;
+      lzo1x_decompress_safe ( (lzo_byte *)  &bp[4], bytes,
+			      (lzo_byte *)  decodebuffer, &olen, NULL );
+      if (  olen != outputlength_in_bytes)
+	{
+	  COUT << __FILE__ << "  " << __LINE__ << " wrong-sized buffer:  " << olen << " should be " <<  outputlength_in_bytes << std::endl;
+	}
+    }
+  else
+    {
+      uLongf olen = outputlength_in_bytes;
+      if ( uncompress ( (Bytef*) decodebuffer, &olen,  (Bytef*) &bp[4], bytes) != Z_OK)
+	{
+	  COUT << __FILE__ << "  " << __LINE__ << " could not uncompress buffer" << std::endl;
+	}
+    }
+
+  bptr = new prdfBuffer(decodebuffer, outputlength);
+  return 0;
+}
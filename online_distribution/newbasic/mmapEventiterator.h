@@ -0,0 +1,95 @@
+// -*- c++ -*-
+#ifndef __MMAPEVENTITERATOR_H__
+#define __MMAPEVENTITERATOR_H__
+
+#include <stdio.h>
+
+#include "Eventiterator.h"
+#include "Event.h"
+
+#include "buffer.h"
+
+/**
+   The mmapEventiterator reads the event data from a data file on disk,
+   like the fileEventiterator, but maps the file into memory instead of
+   read()ing it block by block into a heap buffer.
+
+   The Event objects of uncompressed buffers point directly into the
+   mapping; compressed (gzip, lzo) buffers are decoded into a buffer
+   which is allocated once and reused for all following buffers.
+   As with the fileEventiterator, an Event is only valid until the
+   iterator moves on to the next buffer.
+*/
+#ifndef __CINT__
+class WINDOWSEXPORT mmapEventiterator : public Eventiterator {
+#else
+class  mmapEventiterator : public Eventiterator {
+#endif
+public:
+
+  virtual ~mmapEventiterator();
+
+  /// This simple constructor just needs the file name of the data file.
+  mmapEventiterator(const char *filename);
+
+  /**
+  This constructor gives you a status so you can learn that the creation
+  of the mmapEventiterator object was successful. If the status is not 0,
+  something went wrong and you should delete the object again.
+  */
+  mmapEventiterator(const char *filename, int &status);
+
+  const char * getIdTag() const;
+
+  virtual void identify(std::ostream& os = std::cout) const;
+
+  virtual const char * getCurrentFileName() const;
+
+/**
+   this member function returns a pointer to the Event object, or
+   NULL if there are no events left.
+*/
+  Event *getNextEvent();
+
+  int  setVerbosity(const int v)
+  {
+    verbosity=v;
+    return 0;
+  };
+
+  int  getVerbosity() const
+  {
+    return verbosity;
+  };
+
+
+private:
+  int open_file(const char *filename);
+  int read_next_buffer();
+  int decode_buffer(PHDWORD *bp);
+  void release_buffer();
+
+  char *thefilename;
+  int fd;
+
+  char *mapaddr;
+  unsigned long long mapsize;
+  unsigned long long offset;
+
+  // the part of the mapping the current buffer lives in
+  char *buffer_start;
+  unsigned long long buffer_length;
+
+  // reusable destination for decompressed buffers
+  PHDWORD *decodebuffer;
+  unsigned int decodesize;
+
+  int last_read_status;
+  buffer *bptr;
+
+  int events_so_far;
+  int verbosity;
+  int _defunct;
+};
+
+#endif /* __MMAPEVENTITERATOR_H__ */
@@ -0,0 +1,361 @@
+
+#include "oparallelBuffer.h"
+#include "BufferConstants.h"
+
+#include <zlib.h>
+#include <lzo/lzo1x.h>
+#include <lzo/lzoutil.h>
+
+#include <cstring>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+static int lzo_initialized = 0;
+
+static double wallclock()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+// the constructor first ----------------
+oparallelBuffer::oparallelBuffer (int fdin, PHDWORD * where,
+				  const int length,
+				  const int nthreads,
+				  const int algorithm,
+				  const int level,
+				  const int irun,
+				  const int iseq):
+  oBuffer(fdin,where,length,irun,iseq)
+{
+  compressionalgorithm = algorithm;
+  compressionlevel = level;
+  nworkers = (nthreads > 0) ? nthreads : 1;
+
+  if ( compressionalgorithm == LZO && ! lzo_initialized )
+    {
+      if (lzo_init() != LZO_E_OK)
+	{
+	  COUT << "Could not initialize LZO, using gzip" << std::endl;
+	  compressionalgorithm = GZIP;
+	}
+      else
+	{
+	  lzo_initialized = 1;
+	}
+    }
+
+  // one buffer per worker, one being filled and one being written
+  nslots = nworkers + 2;
+  outputarraylength = (int)(length *1.1) + 2048;
+  slots = new slot[nslots];
+  for (int i = 0; i < nslots; i++)
+    {
+      if ( i == 0)
+	{
+	  // the base class has set up the first buffer in there
+	  slots[i].in = (buffer_ptr) where;
+	  slots[i].owned = 0;
+	  slots[i].state = FILLING;
+	}
+      else
+	{
+	  slots[i].in = (buffer_ptr) new PHDWORD[length];
+	  slots[i].owned = 1;
+	  slots[i].state = FREE;
+	}
+      slots[i].out = new PHDWORD[outputarraylength];
+      slots[i].outbytes = 0;
+      slots[i].seq = 0;
+    }
+  fillslot = 0;
+
+  wrkmems = new void *[nworkers];
+  for (int i = 0; i < nworkers; i++)
+    {
+      wrkmems[i] = 0;
+      if ( compressionalgorithm == LZO)
+	{
+	  wrkmems[i] = lzo_malloc(LZO1X_1_12_MEM_COMPRESS);
+	  if (wrkmems[i])
+	    {
+	      memset(wrkmems[i], 0, LZO1X_1_12_MEM_COMPRESS);
+	    }
+	}
+    }
+
+  stopworkers = 0;
+  writing = 0;
+  nextseq = 0;
+  nextwrite = 0;
+  bytesin = 0;
+  starttime = 0;
+
+  pthread_mutex_init(&mutex, 0);
+  pthread_cond_init(&workcond, 0);
+  pthread_cond_init(&freecond, 0);
+
+  workers = new pthread_t[nworkers];
+  workerargs = new workerarg[nworkers];
+  nworkers_started = 0;
+  for (int i = 0; i < nworkers; i++)
+    {
+      workerargs[nworkers_started].me = this;
+      workerargs[nworkers_started].index = nworkers_started;
+      if ( pthread_create(&workers[nworkers_started], 0, oparallelBuffer::workerThread,
+			  (void *) &workerargs[nworkers_started]) )
+	{
+	  COUT << "oparallelBuffer: could not start worker thread " << i << std::endl;
+	  continue;
+	}
+      nworkers_started++;
+    }
+  // without any worker we compress in writeout()
+
+}
+
+// ----------------------------------------------------------
+// hands the completed buffer to the workers and switches to a free one.
+// returns 0, the bytes show up in getBytesWritten() once the buffer
+// is compressed and written.
+//
+int oparallelBuffer::writeout()
+{
+  if ( ! good_object || fd <= 0 ) return -1;
+
+  if (! dirty) return 0;
+
+  if (! has_end) addEoB();
+
+  if (starttime == 0) starttime = wallclock();
+
+  pthread_mutex_lock(&mutex);
+  slot *s = &slots[fillslot];
+  s->seq = nextseq++;
+  bytesin += bptr->Length;
+  if ( nworkers_started)
+    {
+      s->state = QUEUED;
+      pthread_cond_signal(&workcond);
+    }
+  else
+    {
+      s->state = COMPRESSING;
+      pthread_mutex_unlock(&mutex);
+      compress_slot(s, wrkmems[0]);
+      pthread_mutex_lock(&mutex);
+      s->state = DONE;
+      write_ready();
+    }
+
+  // wait for a buffer to fill next
+  int next = -1;
+  while (next < 0)
+    {
+      for (int i = 0; i < nslots; i++)
+	{
+	  if (slots[i].state == FREE)
+	    {
+	      next = i;
+	      break;
+	    }
+	}
+      if (next < 0)
+	{
+	  pthread_cond_wait(&freecond, &mutex);
+	}
+    }
+  slots[next].state = FILLING;
+  fillslot = next;
+  pthread_mutex_unlock(&mutex);
+
+  bptr = slots[next].in;
+  data_ptr = &(bptr->data[0]);
+  dirty = 0;
+  return 0;
+}
+
+// ----------------------------------------------------------
+// same format as the ogzBuffer and olzoBuffer
+void oparallelBuffer::compress_slot(slot *s, void *wrkmem)
+{
+  buffer_ptr in = s->in;
+  PHDWORD *out = s->out;
+
+  if ( compressionalgorithm == LZO)
+    {
+      lzo_uint outputlength_in_bytes = outputarraylength*4-16;
+      lzo1x_1_12_compress( (lzo_byte *) in,
+			   in->Length,
+			   (lzo_byte *) &out[4],
+			   &outputlength_in_bytes, (lzo_byte *) wrkmem);
+      s->outbytes = outputlength_in_bytes;
+      out[1] = LZO1XBUFFERMARKER;
+    }
+  else
+    {
+      uLongf outputlength_in_bytes = outputarraylength*4-16;
+      compress2 ( (Bytef*) &out[4], &outputlength_in_bytes, (Bytef*) in,
+		  in->Length, compressionlevel);
+      s->outbytes = outputlength_in_bytes;
+      out[1] = GZBUFFERMARKER;
+    }
+  out[0] = s->outbytes + 4*BUFFERHEADERLENGTH;
+  out[2] = in->Bufseq;
+  out[3] = in->Length;
+}
+
+// ----------------------------------------------------------
+// returns the number of bytes written, including record wasted space.
+unsigned int oparallelBuffer::write_slot(slot *s)
+{
+  unsigned int ip =0;
+  char *cp = (char *) s->out;
+
+  while (ip<s->out[0])
+    {
+      write ( fd, cp, BUFFERBLOCKSIZE);
+      cp += BUFFERBLOCKSIZE;
+      ip += BUFFERBLOCKSIZE;
+    }
+  return ip;
+}
+
+// ----------------------------------------------------------
+// write the compressed buffers which are next in line, called with
+// the mutex held. Only one thread writes at a time, the others
+// go back to compressing.
+void oparallelBuffer::write_ready()
+{
+  while ( ! writing)
+    {
+      slot *s = 0;
+      for (int i = 0; i < nslots; i++)
+	{
+	  if (slots[i].state == DONE && slots[i].seq == nextwrite)
+	    {
+	      s = &slots[i];
+	      break;
+	    }
+	}
+      if ( !s) return;
+
+      writing = 1;
+      pthread_mutex_unlock(&mutex);
+      unsigned int bytes = write_slot(s);
+      pthread_mutex_lock(&mutex);
+      writing = 0;
+      byteswritten += bytes;
+      s->state = FREE;
+      nextwrite++;
+      pthread_cond_broadcast(&freecond);
+    }
+}
+
+// ----------------------------------------------------------
+void *oparallelBuffer::workerThread( void *arg)
+{
+  workerarg *warg = (workerarg *) arg;
+  oparallelBuffer *me = warg->me;
+  void *wrkmem = me->wrkmems[warg->index];
+
+  pthread_mutex_lock(&me->mutex);
+  while (1)
+    {
+      // oldest queued buffer first, so they finish roughly in order
+      slot *s = 0;
+      for (int i = 0; i < me->nslots; i++)
+	{
+	  if (me->slots[i].state == QUEUED && ( !s || me->slots[i].seq < s->seq))
+	    {
+	      s = &me->slots[i];
+	    }
+	}
+      if ( !s)
+	{
+	  if (me->stopworkers) break;
+	  pthread_cond_wait(&me->workcond, &me->mutex);
+	  continue;
+	}
+      s->state = COMPRESSING;
+      pthread_mutex_unlock(&me->mutex);
+
+      me->compress_slot(s, wrkmem);
+
+      pthread_mutex_lock(&me->mutex);
+      s->state = DONE;
+      me->write_ready();
+    }
+  pthread_mutex_unlock(&me->mutex);
+  return 0;
+}
+
+// ----------------------------------------------------------
+unsigned long long oparallelBuffer::getBytesWritten() const
+{
+  pthread_mutex_t *m = const_cast<pthread_mutex_t *>(&mutex);
+  pthread_mutex_lock(m);
+  unsigned long long bytes = byteswritten;
+  pthread_mutex_unlock(m);
+  return bytes;
+}
+
+// ----------------------------------------------------------
+unsigned long long oparallelBuffer::getBytesIn() const
+{
+  pthread_mutex_t *m = const_cast<pthread_mutex_t *>(&mutex);
+  pthread_mutex_lock(m);
+  unsigned long long bytes = bytesin;
+  pthread_mutex_unlock(m);
+  return bytes;
+}
+
+// ----------------------------------------------------------
+double oparallelBuffer::getThroughput() const
+{
+  if (starttime == 0) return 0;
+  double elapsed = wallclock() - starttime;
+  if (elapsed <= 0) return 0;
+  return getBytesIn() / elapsed;
+}
+
+// ----------------------------------------------------------
+oparallelBuffer::~oparallelBuffer()
+{
+  writeout();
+
+  // wait until everything is on disk, then let the workers go
+  pthread_mutex_lock(&mutex);
+  while (nextwrite < nextseq)
+    {
+      pthread_cond_wait(&freecond, &mutex);
+    }
+  stopworkers = 1;
+  pthread_cond_broadcast(&workcond);
+  pthread_mutex_unlock(&mutex);
+  for (int i = 0; i < nworkers_started; i++)
+    {
+      pthread_join(workers[i], 0);
+    }
+  delete [] workers;
+  delete [] workerargs;
+
+  pthread_cond_destroy(&freecond);
+  pthread_cond_destroy(&workcond);
+  pthread_mutex_destroy(&mutex);
+
+  for (int i = 0; i < nworkers; i++)
+    {
+      if (wrkmems[i]) lzo_free(wrkmems[i]);
+    }
+  delete [] wrkmems;
+
+  for (int i = 0; i < nslots; i++)
+    {
+      if (slots[i].owned) delete [] (PHDWORD *) slots[i].in;
+      delete [] slots[i].out;
+    }
+  delete [] slots;
+}
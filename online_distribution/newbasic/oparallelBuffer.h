@@ -0,0 +1,110 @@
+#ifndef __OPARALLELBUFFER_H__
+#define __OPARALLELBUFFER_H__
+
+#include "oBuffer.h"
+
+#ifndef __CINT__
+#include <pthread.h>
+#endif
+
+
+/**
+   The oparallelBuffer writes the same gzip or lzo compressed buffers
+   as the ogzBuffer and olzoBuffer (so the gzbuffer and lzobuffer read
+   them back), but the compression of a completed buffer is done by a
+   pool of worker threads while the next buffer is filled. The
+   compressed buffers are written to the file in their original order.
+
+   The array given in the constructor is used as the first of the
+   buffers which are filled, the others are allocated here.
+*/
+
+#ifndef __CINT__
+class WINDOWSEXPORT oparallelBuffer : public oBuffer{
+#else
+class  oparallelBuffer : public oBuffer{
+#endif
+
+public:
+
+  enum { GZIP = 0, LZO = 1 };
+
+  //** Constructors
+
+  oparallelBuffer (int fdin, PHDWORD * where,
+		   const int length,
+		   const int nthreads = 2,
+		   const int algorithm = GZIP,
+		   const int level = 3,
+		   const int irun=1,
+		   const int iseq=0 );
+
+  virtual  ~oparallelBuffer();
+
+
+  virtual int writeout ();
+
+  virtual unsigned long long getBytesWritten() const;
+
+  /// uncompressed bytes handed to the compression so far
+  unsigned long long getBytesIn() const;
+
+  /// uncompressed bytes per second, from the first buffer until now
+  double getThroughput() const;
+
+
+protected:
+
+  // one buffer to fill and its compressed image
+  struct slot
+  {
+    buffer_ptr in;
+    PHDWORD *out;
+    unsigned int outbytes;
+    unsigned long long seq;
+    int state;
+    int owned;
+  };
+
+  enum { FREE = 0, FILLING = 1, QUEUED = 2, COMPRESSING = 3, DONE = 4 };
+
+  struct workerarg
+  {
+    oparallelBuffer *me;
+    int index;
+  };
+
+  void compress_slot(slot *s, void *wrkmem);
+  unsigned int write_slot(slot *s);
+  void write_ready();
+  static void *workerThread(void * arg);
+
+  int nslots;
+  slot *slots;
+  int fillslot;
+
+  int compressionalgorithm;
+  int compressionlevel;
+  unsigned int outputarraylength;
+
+  int nworkers;
+  int nworkers_started;
+#ifndef __CINT__
+  pthread_t *workers;
+  workerarg *workerargs;
+  pthread_mutex_t mutex;
+  pthread_cond_t workcond;
+  pthread_cond_t freecond;
+#endif
+  void **wrkmems;
+  int stopworkers;
+  int writing;
+
+  unsigned long long nextseq;
+  unsigned long long nextwrite;
+  unsigned long long bytesin;
+  double starttime;
+
+};
+
+#endif /* __OPARALLELBUFFER_H__ */
@@ -1,5 +1,6 @@
 #include <Event/testEventiterator.h>
 #include <Event/fileEventiterator.h>
+#include <Event/mmapEventiterator.h>
 #include <Event/listEventiterator.h>
 #include <Event/oncsEventiterator.h>
 #include <Event/rcdaqEventiterator.h>
@@ -80,7 +81,7 @@ int ptestopen()
 
 //-----------------------------------------
 
-int pfileopen(const char * filename)
+int pfileopen(const char * filename, const int use_mmap)
 {
   int status = 0;
   if ( theState.streamOpened() )
@@ -91,11 +92,20 @@ int pfileopen(const char * filename)
 
 #ifdef HAVE_FROG
   FROG f;
-  theIterator = new fileEventiterator(f.location(filename), status);
+  const char *location = f.location(filename);
 #else
-  theIterator = new fileEventiterator( filename, status);
+  const char *location = filename;
 #endif
 
+  if ( use_mmap )
+    {
+      theIterator = new mmapEventiterator(location, status);
+    }
+  else
+    {
+      theIterator = new fileEventiterator(location, status);
+    }
+
   if (status)
     {
       delete theIterator;
@@ -552,6 +562,7 @@ void phelp()
   cout << endl;
   cout << " pstatus()                 gives a brief status of pmonitor" << endl;
   cout << " pfileopen(\"filename\")     opens a PRDF file" << endl;
+  cout << " pfileopen(\"filename\", 1)  opens a PRDF file through a memory mapping" << endl;
   cout << " plistopen(\"filename\")     opens a file with a list of prdfs" << endl;
   cout << " ptestopen()               opens a test input stream" << endl;
   cout << " pclose()                  closes the open stream" << endl;
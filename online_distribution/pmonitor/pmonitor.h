@@ -12,7 +12,7 @@ int poncsetopen (const char * etname);
 
 int poncsopen (const char * filename);  
 int rcdaqopen (const char * ip=0);  
-int pfileopen (const char * filename);  
+int pfileopen (const char * filename, const int use_mmap=0);  
 int plistopen (const char * filename);  
 int pstart (const int nevents);         
 void prun ();                            
@@ -1,16 +1,17 @@
 #include "RawClusterBuilder.h"
 #include "RawClusterContainer.h"
 #include "RawClusterv1.h"
-#include "PHMakeGroups.h"
 
 #include "RawTower.h"
 #include "RawTowerGeomContainer.h"
 #include "RawTowerContainer.h"
 
+#include <g4detectors/PHG4GridClusterFinder.h>
 #include <phool/PHCompositeNode.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <phool/getClass.h>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -22,16 +23,13 @@
 
 using namespace std;
 
-// this is just a helper class which enables us to handle rollovers
-// when checking for adjacent towers, it requires one bit of
-// information (the total number of phibins) which
-// is not in the tower class
+// tower bins and id of a tower above threshold, the towers are
+// clustered in (eta, phi) order
 class twrs
 {
 public:
   twrs(RawTower *);
   virtual ~twrs() {}
-  bool is_adjacent(twrs &);
   void set_id(const int i)
   {
     id = i;
@@ -40,14 +38,6 @@ public:
   {
     return id;
   }
-  void set_maxphibin(const int i)
-  {
-    maxphibin = i;
-  }
-  int get_maxphibin() const
-  {
-    return maxphibin;
-  }
   int get_bineta() const
   {
     return bineta;
@@ -59,38 +49,16 @@ public:
 protected:
   int bineta;
   int binphi;
-  int maxphibin;
   RawTowerDefs::keytype id;
 };
 
 twrs::twrs(RawTower *rt):
-  maxphibin(-10),
   id(-1)
 {
   bineta = rt->get_bineta();
   binphi = rt->get_binphi();
 }
 
-bool
-twrs::is_adjacent(twrs &tower)
-{
-  if(bineta-1<=tower.get_bineta() && tower.get_bineta()<=bineta+1)
-    {
-      if(binphi-1<=tower.get_binphi() && tower.get_binphi()<=binphi+1)
-	{
-	  return true;
-	}
-      // cluster through the phi-wraparound
-      else if(((tower.get_binphi() == maxphibin-1) && (binphi == 0)) ||
-	      ((tower.get_binphi() == 0) && (binphi == maxphibin-1)))
-	{
-	  return true;
-	}
-    }
-  
-  return false;
-}
-
 bool operator<(const twrs& a, const twrs& b)
 {
   if (a.get_bineta() != b.get_bineta())
@@ -120,6 +88,12 @@ int RawClusterBuilder::InitRun(PHCompositeNode *topNode)
       throw;
     }
 
+  // nodes used in process_event, clusters of different detectors
+  // can be built concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode("TOWER_CALIB_" + detector);
+  DeclareInputNode("TOWERGEOM_" + detector);
+  DeclareOutputNode(ClusterNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -152,26 +126,32 @@ int RawClusterBuilder::process_event(PHCompositeNode *topNode)
       if (tower->get_energy() > _min_tower_e)
         {
           twrs twr(tower);
-	  twr.set_maxphibin(towergeom->get_phibins());
 	  twr.set_id(towerid);
           towerVector.push_back(twr);
         }
     }
 
-  // cluster the towers
-  std::multimap<int, twrs> clusteredTowers;
-  PHMakeGroups(towerVector, clusteredTowers);
+  // cluster the towers: neighbours within one eta and one phi bin,
+  // phi wraps around
+  std::sort(towerVector.begin(), towerVector.end());
+  PHG4GridClusterFinder clusterfinder;
+  for (unsigned int i = 0; i < towerVector.size(); i++)
+    {
+      clusterfinder.add_hit(0, towerVector[i].get_binphi(), towerVector[i].get_bineta());
+    }
+  clusterfinder.find_clusters(1, towergeom->get_phibins());
+  // towers grouped by cluster, clusters in increasing id
+  const std::vector<int> &members = clusterfinder.get_members();
+  const std::vector<int> &clusterids = clusterfinder.get_cluster_ids();
 
   // extract the clusters
   std::vector<float> energy;
   std::vector<float> eta;
   std::vector<float> phi;
 
-  std::multimap<int, twrs>::iterator ctitr = clusteredTowers.begin();
-  std::multimap<int, twrs>::iterator lastct = clusteredTowers.end();
-  for (; ctitr != lastct; ++ctitr)
+  for (unsigned int imember = 0; imember < members.size(); ++imember)
     {
-      int clusterid = ctitr->first;
+      int clusterid = clusterids[members[imember]];
       RawCluster *cluster = _clusters->getCluster(clusterid);
       if (!cluster)
         {
@@ -182,7 +162,7 @@ int RawClusterBuilder::process_event(PHCompositeNode *topNode)
           phi.push_back(0.0);
         }
 
-      twrs tmptower = ctitr->second;
+      twrs tmptower = towerVector[members[imember]];
       int iphi = tmptower.get_binphi();
       int ieta = tmptower.get_bineta();
       RawTower *rawtower = towers->getTower(ieta, iphi);
@@ -202,7 +182,7 @@ int RawClusterBuilder::process_event(PHCompositeNode *topNode)
 
       if (verbosity)
         {
-          std::cout << "RawClusterBuilder id: " << (ctitr->first) << " Tower: "
+          std::cout << "RawClusterBuilder id: " << clusterid << " Tower: "
                     << " (ieta,iphi) = (" << rawtower->get_bineta() << "," << rawtower->get_binphi() << ") "
                     << " (eta,phi,e) = (" << towergeom->get_etacenter(rawtower->get_bineta()) << ","
                     << towergeom->get_phicenter(rawtower->get_binphi()) << ","
@@ -1,17 +1,18 @@
 #include "RawClusterBuilderFwd.h"
 #include "RawClusterContainer.h"
 #include "RawClusterv1.h"
-#include "PHMakeGroups.h"
 
 #include "RawTower.h"
 #include "RawTowerGeomContainer.h"
 #include "RawTowerGeom.h"
 #include "RawTowerContainer.h"
 
+#include <g4detectors/PHG4GridClusterFinder.h>
 #include <phool/PHCompositeNode.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <phool/getClass.h>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -28,7 +29,6 @@ class twrs_fwd
 public:
   twrs_fwd(RawTower *);
   virtual ~twrs_fwd() {}
-  bool is_adjacent(twrs_fwd &);
   void set_id(const int i)
   {
     id = i;
@@ -58,20 +58,6 @@ twrs_fwd::twrs_fwd(RawTower *rt):
   bin_k = rt->get_binphi();
 }
 
-bool
-twrs_fwd::is_adjacent(twrs_fwd &tower)
-{
-  if(bin_j-1<=tower.get_j_bin() && tower.get_j_bin()<=bin_j+1)
-    {
-      if(bin_k-1<=tower.get_k_bin() && tower.get_k_bin()<=bin_k+1)
-	{
-	  return true;
-	}
-    }
-  
-  return false;
-}
-
 bool operator<(const twrs_fwd& a, const twrs_fwd& b)
 {
   if (a.get_j_bin() != b.get_j_bin())
@@ -138,20 +124,26 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
         }
     }
 
-  // cluster the towers
-  std::multimap<int, twrs_fwd> clusteredTowers;
-  PHMakeGroups(towerVector, clusteredTowers);
+  // cluster the towers: neighbours within one bin in j and k
+  std::sort(towerVector.begin(), towerVector.end());
+  PHG4GridClusterFinder clusterfinder;
+  for (unsigned int i = 0; i < towerVector.size(); i++)
+    {
+      clusterfinder.add_hit(0, towerVector[i].get_j_bin(), towerVector[i].get_k_bin());
+    }
+  clusterfinder.find_clusters(1);
+  // towers grouped by cluster, clusters in increasing id
+  const std::vector<int> &members = clusterfinder.get_members();
+  const std::vector<int> &clusterids = clusterfinder.get_cluster_ids();
 
   // extract the clusters
   std::vector<float> energy;
   std::vector<float> eta;
   std::vector<float> phi;
 
-  std::multimap<int, twrs_fwd>::iterator ctitr = clusteredTowers.begin();
-  std::multimap<int, twrs_fwd>::iterator lastct = clusteredTowers.end();
-  for (; ctitr != lastct; ++ctitr)
+  for (unsigned int imember = 0; imember < members.size(); ++imember)
     {
-      int clusterid = ctitr->first;
+      int clusterid = clusterids[members[imember]];
       RawCluster *cluster = _clusters->getCluster(clusterid);
       if (!cluster)
         {
@@ -162,7 +154,7 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
           phi.push_back(0.0);
         }
 
-      twrs_fwd tmptower = ctitr->second;
+      twrs_fwd tmptower = towerVector[members[imember]];
       int ij = tmptower.get_j_bin();
       int ik = tmptower.get_k_bin();
       RawTower *rawtower = towers->getTower(ij, ik);
@@ -184,7 +176,7 @@ int RawClusterBuilderFwd::process_event(PHCompositeNode *topNode)
 
       if (verbosity)
         {
-          std::cout << "RawClusterBuilderFwd id: " << (ctitr->first) << " Tower: "
+          std::cout << "RawClusterBuilderFwd id: " << clusterid << " Tower: "
                     << " (ieta,iphi) = (" << rawtower->get_bineta() << "," << rawtower->get_binphi() << ") "
                     << " (eta,phi,e) = (" << tgeo->get_eta() << ","
                     << tgeo->get_phi() << ","
@@ -1,7 +1,6 @@
 #include "RawClusterBuilderv1.h"
 #include "RawClusterContainer.h"
 #include "RawClusterv1.h"
-#include "PHMakeGroups.h"
 
 #include "RawTower.h"
 #include "RawTowerGeomContainer.h"
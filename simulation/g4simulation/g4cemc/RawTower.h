@@ -26,6 +26,9 @@ class RawTower : public PHObject {
 
   virtual ~RawTower() {}
 
+  //! copy of the tower of the same version, including the truth it stores
+  virtual RawTower* clone() const { PHOOL_VIRTUAL_WARN("clone()"); return NULL; }
+
   virtual void Reset() { PHOOL_VIRTUAL_WARNING; }
   virtual int isValid() const { PHOOL_VIRTUAL_WARN("isValid()"); return 0; }
   virtual void identify(std::ostream& os=std::cout) const { PHOOL_VIRTUAL_WARN("identify()"); }
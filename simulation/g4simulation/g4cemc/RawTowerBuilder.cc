@@ -3,6 +3,7 @@
 #include "RawTowerGeomContainer_Cylinderv1.h"
 #include "RawTowerGeomv1.h"
 #include "RawTowerv1.h"
+#include "RawTowerv2.h"
 #include <g4detectors/PHG4CylinderCellGeomContainer.h>
 #include <g4detectors/PHG4CylinderCellGeom.h>
 #include <g4detectors/PHG4CylinderCellContainer.h>
@@ -25,7 +26,7 @@ RawTowerBuilder::RawTowerBuilder(const std::string& name) :
     SubsysReco(name), _towers(NULL), rawtowergeom(NULL), detector("NONE"), _cell_binning(
         PHG4CylinderCellDefs::undefined), emin(1e-6), chkenergyconservation(0), _nlayers(
         -1), _nphibins(-1), _netabins(-1), _etamin(NAN), _phimin(NAN), _etastep(
-        NAN), _phistep(NAN), _tower_energy_src(kLightYield), _timer(
+        NAN), _phistep(NAN), _tower_energy_src(kLightYield), _keep_g4_truth(true), _timer(
         PHTimeServer::get()->insert_new(name))
 {
 }
@@ -70,6 +71,11 @@ RawTowerBuilder::InitRun(PHCompositeNode *topNode)
       //exit(1);
     }
 
+  // nodes used in process_event, towers of different detectors
+  // can be built concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode("G4CELL_" + detector);
+  DeclareOutputNode(TowerNodeName);
+
   if (verbosity >= 1)
     {
       cout << "RawTowerBuilder::InitRun :";
@@ -120,7 +126,10 @@ RawTowerBuilder::process_event(PHCompositeNode *topNode)
       RawTower *tower = _towers->getTower(cell->get_binz(), cell->get_binphi());
       if (!tower)
         {
-          tower = new RawTowerv1();
+          if (_keep_g4_truth)
+            tower = new RawTowerv1();
+          else
+            tower = new RawTowerv2();
           tower->set_energy(0);
           _towers->AddTower(cell->get_binz(), cell->get_binphi(), tower);
         }
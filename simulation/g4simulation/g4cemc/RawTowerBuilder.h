@@ -58,6 +58,20 @@ class RawTowerBuilder : public SubsysReco {
     _sim_tower_node_prefix = simTowerNodePrefix;
   }
 
+  //! keep the Geant4 cells and showers of each tower (RawTowerv1), otherwise
+  //! the towers are RawTowerv2 without truth association
+  bool
+  get_keep_g4_truth() const
+  {
+    return _keep_g4_truth;
+  }
+
+  void
+  set_keep_g4_truth(bool keepG4Truth)
+  {
+    _keep_g4_truth = keepG4Truth;
+  }
+
  protected:
   void CreateNodes(PHCompositeNode *topNode);
 
@@ -80,6 +94,7 @@ class RawTowerBuilder : public SubsysReco {
   double _etastep;
   double _phistep;
   enu_tower_energy_src _tower_energy_src;
+  bool _keep_g4_truth;
 
   PHTimeServer::timer _timer;
 
@@ -82,6 +82,11 @@ RawTowerBuilderByHitIndex::InitRun(PHCompositeNode *topNode)
       //exit(1);
     }
 
+  // nodes used in process_event, towers of different detectors
+  // can be built concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode("G4HIT_" + detector_);
+  DeclareOutputNode(node_name_towers_);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -61,6 +61,13 @@ RawTowerCalibration::InitRun(PHCompositeNode *topNode)
       std::cout << e.what() << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
     }
+
+  // nodes used in process_event, towers of different detectors
+  // can be calibrated concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode(RawTowerNodeName);
+  DeclareInputNode(TowerGeomNodeName);
+  DeclareOutputNode(CaliTowerNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -98,7 +105,11 @@ RawTowerCalibration::process_event(PHCompositeNode *topNode)
         {
           if (raw_tower->get_energy() > _zero_suppression_GeV)
             {
-              _calib_towers->AddTower(key, new RawTowerv1(*raw_tower));
+              RawTower *calib_tower = raw_tower->clone();
+              // tower versions without clone() are copied as RawTowerv1
+              if (!calib_tower)
+                calib_tower = new RawTowerv1(*raw_tower);
+              _calib_towers->AddTower(key, calib_tower);
             }
         }
       else if (_calib_algorithm == kSimple_linear_calibration)
@@ -109,7 +120,9 @@ RawTowerCalibration::process_event(PHCompositeNode *topNode)
 
           if (calib_energy > _zero_suppression_GeV)
             {
-              RawTower *calib_tower = new RawTowerv1(*raw_tower);
+              RawTower *calib_tower = raw_tower->clone();
+              if (!calib_tower)
+                calib_tower = new RawTowerv1(*raw_tower);
               calib_tower->set_energy(calib_energy);
               _calib_towers->AddTower(key, calib_tower);
             }
@@ -111,7 +111,10 @@ RawTowerCombiner::process_event(PHCompositeNode *topNode)
 
       if (it_new == new_tower_map.end())
         {
-          output_tower = new RawTowerv1(*input_tower);
+          output_tower = input_tower->clone();
+          // tower versions without clone() are copied as RawTowerv1
+          if (!output_tower)
+            output_tower = new RawTowerv1(*input_tower);
           assert(output_tower);
           new_tower_map[make_pair(output_eta, output_phi)] = output_tower;
 
@@ -1,6 +1,7 @@
 #include "RawTowerContainer.h"
 #include "RawTower.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -22,6 +23,7 @@ RawTowerContainer::compress(const double emin)
       RawTower *tower = (itr->second);
       if (tower->get_energy() < emin)
         {
+          index_tower(itr->first, NULL);
 	  delete tower;
           _towers.erase(itr++);
         }
@@ -30,6 +32,7 @@ RawTowerContainer::compress(const double emin)
           ++itr;
         }
     }
+  _dense_ntowers = _towers.size();
 }
 
 RawTowerContainer::ConstRange
@@ -42,18 +45,65 @@ RawTowerContainer::getTowers( void ) const
 RawTowerContainer::Range
 RawTowerContainer::getTowers( void )
 {
+  _dense_valid = false;
   return make_pair(_towers.begin(), _towers.end());
 }
 
+void
+RawTowerContainer::index_tower(RawTowerDefs::keytype key, RawTower *twr)
+{
+  if (!_dense_valid || RawTowerDefs::decode_caloid(key) != _caloid)
+    {
+      return;
+    }
+
+  const unsigned int index1 = RawTowerDefs::decode_index1(key);
+  const unsigned int index2 = RawTowerDefs::decode_index2(key);
+  if (index1 >= _dense_neta || index2 >= _dense_nphi)
+    {
+      if (!twr)
+        {
+          return;
+        }
+      // grow to the new extent, this happens in the first event only
+      _dense_neta = max(_dense_neta, index1 + 1);
+      _dense_nphi = max(_dense_nphi, index2 + 1);
+      rebuild_index();
+      return;
+    }
+  _dense[index1 * _dense_nphi + index2] = twr;
+}
+
+void
+RawTowerContainer::rebuild_index()
+{
+  for (ConstIterator iter = _towers.begin(); iter != _towers.end(); ++iter)
+    {
+      if (RawTowerDefs::decode_caloid(iter->first) == _caloid)
+        {
+          _dense_neta = max(_dense_neta, RawTowerDefs::decode_index1(iter->first) + 1);
+          _dense_nphi = max(_dense_nphi, RawTowerDefs::decode_index2(iter->first) + 1);
+        }
+    }
+  _dense.assign(_dense_neta * _dense_nphi, (RawTower *) NULL);
+  for (ConstIterator iter = _towers.begin(); iter != _towers.end(); ++iter)
+    {
+      if (RawTowerDefs::decode_caloid(iter->first) == _caloid)
+        {
+          _dense[RawTowerDefs::decode_index1(iter->first) * _dense_nphi
+              + RawTowerDefs::decode_index2(iter->first)] = iter->second;
+        }
+    }
+  _dense_ntowers = _towers.size();
+  _dense_valid = true;
+}
+
 
 RawTowerContainer::ConstIterator
 RawTowerContainer::AddTower(const unsigned int ieta, const int unsigned iphi, RawTower *rawtower)
 {
   RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(_caloid,ieta,iphi);
-  _towers[key] = rawtower;
-  rawtower->set_id(key); // force tower key to be synced to container key
-
-  return _towers.find(key);
+  return AddTower(key, rawtower);
 }
 
 RawTowerContainer::ConstIterator
@@ -66,15 +116,36 @@ RawTowerContainer::AddTower(RawTowerDefs::keytype key, RawTower *twr)
       exit(2);
     }
 
-  _towers[key] = twr;
+  pair<Iterator, bool> inserted = _towers.insert(make_pair(key, twr));
+  if (!inserted.second)
+    {
+      inserted.first->second = twr;
+    }
   twr->set_id(key); // force tower key to be synced to container key
+  index_tower(key, twr);
+  _dense_ntowers = _towers.size();
 
-  return _towers.find(key);
+  return inserted.first;
 }
 
 RawTower *
 RawTowerContainer::getTower(RawTowerDefs::keytype key)
 {
+  if (RawTowerDefs::decode_caloid(key) == _caloid)
+    {
+      if (!_dense_valid || _dense_ntowers != _towers.size())
+        {
+          rebuild_index();
+        }
+      const unsigned int index1 = RawTowerDefs::decode_index1(key);
+      const unsigned int index2 = RawTowerDefs::decode_index2(key);
+      if (index1 >= _dense_neta || index2 >= _dense_nphi)
+        {
+          return NULL;
+        }
+      return _dense[index1 * _dense_nphi + index2];
+    }
+
   Iterator it = _towers.find(key);
   if (it != _towers.end())
     {
@@ -101,9 +172,11 @@ RawTowerContainer::Reset()
 {
   while (_towers.begin() != _towers.end())
     {
+      index_tower(_towers.begin()->first, NULL);
       delete _towers.begin()->second;
       _towers.erase(_towers.begin());
     }
+  _dense_ntowers = 0;
 }
 
 void 
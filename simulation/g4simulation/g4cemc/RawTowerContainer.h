@@ -6,9 +6,19 @@
 #include <phool/phool.h>
 #include <iostream>
 #include <map>
+#include <vector>
 
 class RawTower;
 
+/*! \class RawTowerContainer
+    \brief towers of one calorimeter, keyed by tower ID
+
+    Besides the map, which is what goes to the DST, the container keeps a
+    transient dense (index1, index2) array of the tower pointers, so
+    getTower() is an array access. The array grows to the largest indices
+    seen and is rebuilt from the map when it could be stale, e.g. after
+    reading from a DST or after the towers were handed out for modification.
+*/
 class RawTowerContainer : public PHObject 
 {
 
@@ -20,7 +30,8 @@ class RawTowerContainer : public PHObject
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
 
-  RawTowerContainer( RawTowerDefs::CalorimeterId caloid = RawTowerDefs::NONE )
+  RawTowerContainer( RawTowerDefs::CalorimeterId caloid = RawTowerDefs::NONE ):
+    _dense_neta(0), _dense_nphi(0), _dense_ntowers(0), _dense_valid(false)
   {
     _caloid = caloid;
   }
@@ -30,7 +41,7 @@ class RawTowerContainer : public PHObject
   int isValid() const;
   void identify(std::ostream& os=std::cout) const;
 
-  void setCalorimeterID( RawTowerDefs::CalorimeterId caloid ) { _caloid = caloid; }
+  void setCalorimeterID( RawTowerDefs::CalorimeterId caloid ) { _caloid = caloid; _dense_valid = false; }
   RawTowerDefs::CalorimeterId getCalorimeterID( ) { return _caloid; }
 
   ConstIterator AddTower(const unsigned int ieta, const unsigned int iphi, RawTower *twr);
@@ -39,6 +50,7 @@ class RawTowerContainer : public PHObject
   RawTower *getTower(const unsigned int ieta, const unsigned int iphi);
   //! return all towers
   ConstRange getTowers( void ) const;
+  //! the towers may be replaced through the range, the dense index is rebuilt on the next lookup
   Range getTowers( void );
 
   unsigned int size() const {return _towers.size();}
@@ -46,9 +58,20 @@ class RawTowerContainer : public PHObject
   double getTotalEdep() const;
 
  protected:
+  void index_tower(RawTowerDefs::keytype key, RawTower *twr);
+  void rebuild_index();
+
   RawTowerDefs::CalorimeterId _caloid;
   Map _towers;
 
+  //! dense index, _dense[index1 * _dense_nphi + index2], NULL where there is no tower
+  std::vector<RawTower *> _dense; //!
+  unsigned int _dense_neta; //!
+  unsigned int _dense_nphi; //!
+  //! number of towers in _towers when the index was last in sync
+  unsigned int _dense_ntowers; //!
+  bool _dense_valid; //!
+
   ClassDef(RawTowerContainer,1)
 };
 
@@ -82,6 +82,13 @@ RawTowerDigitizer::InitRun(PHCompositeNode *topNode)
       std::cout << e.what() << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
     }
+
+  // nodes used in process_event, towers of different detectors
+  // can be digitized concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode(SimTowerNodeName);
+  DeclareInputNode(TowerGeomNodeName);
+  DeclareOutputNode(RawTowerNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -121,7 +128,10 @@ RawTowerDigitizer::process_event(PHCompositeNode *topNode)
         {
           if (sim_tower)
 	    {
-            digi_tower = new RawTowerv1(*sim_tower);
+            digi_tower = sim_tower->clone();
+            // tower versions without clone() are copied as RawTowerv1
+            if (!digi_tower)
+              digi_tower = new RawTowerv1(*sim_tower);
 	    }
         }
       else if (_digi_algorithm == kSimple_photon_digitization)
@@ -186,9 +196,9 @@ RawTowerDigitizer::simple_photon_digitization(RawTower * sim_tower)
     {
       // create new digitalizaed tower
       if (sim_tower)
-        digi_tower = new RawTowerv1(*sim_tower);
-      else
-        digi_tower = new RawTowerv1();
+        digi_tower = sim_tower->clone();
+      if (!digi_tower)
+        digi_tower = (sim_tower) ? new RawTowerv1(*sim_tower) : new RawTowerv1();
 
       digi_tower->set_energy((double) sum_ADC);
     }
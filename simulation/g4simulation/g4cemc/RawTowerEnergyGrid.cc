@@ -0,0 +1,129 @@
+#include "RawTowerEnergyGrid.h"
+#include "RawTowerContainer.h"
+#include "RawTower.h"
+#include "RawTowerDefs.h"
+
+#include <algorithm>
+
+using namespace std;
+
+RawTowerEnergyGrid::RawTowerEnergyGrid() :
+    _netabins(0), _nphibins(0)
+{
+}
+
+void
+RawTowerEnergyGrid::Reset()
+{
+  fill(_energy.begin(), _energy.end(), 0.);
+  fill(_prefix.begin(), _prefix.end(), 0.);
+  fill(_count_prefix.begin(), _count_prefix.end(), 0);
+}
+
+void
+RawTowerEnergyGrid::Fill(const RawTowerContainer *towers, const int netabins,
+    const int nphibins)
+{
+  _netabins = max(netabins, 0);
+  _nphibins = max(nphibins, 0);
+
+  // assign keeps the capacity, so refilling every event does not allocate
+  _energy.assign(_netabins * _nphibins, 0.);
+  _prefix.assign((_netabins + 1) * (_nphibins + 1), 0.);
+  _count_prefix.assign((_netabins + 1) * (_nphibins + 1), 0);
+
+  if (!towers)
+    return;
+
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator iter = begin_end.first;
+      iter != begin_end.second; ++iter)
+    {
+      const int ieta = RawTowerDefs::decode_index1(iter->first);
+      const int iphi = RawTowerDefs::decode_index2(iter->first);
+      if (ieta >= _netabins or iphi >= _nphibins)
+        continue;
+
+      _energy[ieta * _nphibins + iphi] += iter->second->get_energy();
+      // the raw counts are summed up in place below
+      ++_count_prefix[(ieta + 1) * (_nphibins + 1) + iphi + 1];
+    }
+
+  // prefix(eta + 1, phi + 1) = prefix(eta, phi + 1) + running sum of row eta
+  const int stride = _nphibins + 1;
+  for (int ieta = 0; ieta < _netabins; ++ieta)
+    {
+      double row = 0;
+      int count_row = 0;
+      for (int iphi = 0; iphi < _nphibins; ++iphi)
+        {
+          row += _energy[ieta * _nphibins + iphi];
+          _prefix[(ieta + 1) * stride + iphi + 1] = _prefix[ieta * stride
+              + iphi + 1] + row;
+
+          count_row += _count_prefix[(ieta + 1) * stride + iphi + 1];
+          _count_prefix[(ieta + 1) * stride + iphi + 1] = _count_prefix[ieta
+              * stride + iphi + 1] + count_row;
+        }
+    }
+}
+
+int
+RawTowerEnergyGrid::wrap_phi(const int iphi) const
+{
+  int wrapped = iphi % _nphibins;
+  if (wrapped < 0)
+    wrapped += _nphibins;
+  return wrapped;
+}
+
+double
+RawTowerEnergyGrid::rectangle_sum(const int eta0, const int eta1,
+    const int phi0, const int phi1) const
+{
+  const int stride = _nphibins + 1;
+  const int ntowers = _count_prefix[eta1 * stride + phi1]
+      - _count_prefix[eta0 * stride + phi1]
+      - _count_prefix[eta1 * stride + phi0]
+      + _count_prefix[eta0 * stride + phi0];
+  if (ntowers == 0)
+    return 0;
+
+  return prefix(eta1, phi1) - prefix(eta0, phi1) - prefix(eta1, phi0)
+      + prefix(eta0, phi0);
+}
+
+double
+RawTowerEnergyGrid::get_energy(const int ieta, const int iphi) const
+{
+  if (ieta < 0 or ieta >= _netabins or _nphibins <= 0)
+    return 0;
+
+  return _energy[ieta * _nphibins + wrap_phi(iphi)];
+}
+
+double
+RawTowerEnergyGrid::get_window_sum(const int ieta, const int iphi,
+    const int neta, const int nphi) const
+{
+  if (neta <= 0 or nphi <= 0 or _nphibins <= 0)
+    return 0;
+
+  // eta does not wrap, clip the window to the grid
+  const int eta0 = max(ieta, 0);
+  const int eta1 = min(ieta + neta, _netabins);
+  if (eta0 >= eta1)
+    return 0;
+
+  if (nphi >= _nphibins)
+    return rectangle_sum(eta0, eta1, 0, _nphibins);
+
+  // a window crossing the phi boundary is split in two
+  const int phi0 = wrap_phi(iphi);
+  const int phi1 = phi0 + nphi;
+  if (phi1 <= _nphibins)
+    return rectangle_sum(eta0, eta1, phi0, phi1);
+
+  return rectangle_sum(eta0, eta1, phi0, _nphibins)
+      + rectangle_sum(eta0, eta1, 0, phi1 - _nphibins);
+}
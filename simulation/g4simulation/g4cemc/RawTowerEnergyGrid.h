@@ -0,0 +1,69 @@
+#ifndef RAWTOWERENERGYGRID_H__
+#define RAWTOWERENERGYGRID_H__
+
+#include <vector>
+
+class RawTowerContainer;
+
+/*! \class RawTowerEnergyGrid
+    \brief dense (eta, phi) view of the tower energies of one event
+
+    The energies of a RawTowerContainer are copied into a flat
+    eta x phi array together with their summed-area table (2D prefix
+    sum), so a single tower is an array access and the sum over any
+    rectangular window costs four lookups instead of one map lookup
+    per tower. The phi index wraps around, eta bins outside of the
+    grid contribute nothing.
+
+    The grid is a transient helper and is meant to be kept in the
+    module and refilled every event.
+*/
+class RawTowerEnergyGrid
+{
+
+ public:
+
+  RawTowerEnergyGrid();
+  virtual ~RawTowerEnergyGrid() {}
+
+  //! copy the tower energies, towers outside of netabins x nphibins are ignored
+  void Fill(const RawTowerContainer *towers, const int netabins, const int nphibins);
+  void Reset();
+
+  int get_etabins() const {return _netabins;}
+  int get_phibins() const {return _nphibins;}
+
+  //! energy of one tower, phi wraps around, 0 outside of the eta range
+  double get_energy(const int ieta, const int iphi) const;
+
+  //! energy sum of the towers ieta ... ieta + neta - 1, iphi ... iphi + nphi - 1
+  double get_window_sum(const int ieta, const int iphi, const int neta, const int nphi) const;
+
+ protected:
+
+  int wrap_phi(const int iphi) const;
+
+  //! sum of the towers with eta < ieta and phi < iphi, 0 <= ieta <= _netabins, 0 <= iphi <= _nphibins
+  double prefix(const int ieta, const int iphi) const
+  {
+    return _prefix[ieta * (_nphibins + 1) + iphi];
+  }
+
+  //! sum over [eta0, eta1) x [phi0, phi1) inside of the grid
+  double rectangle_sum(const int eta0, const int eta1, const int phi0, const int phi1) const;
+
+  int _netabins;
+  int _nphibins;
+
+  //! tower energies, index ieta * _nphibins + iphi
+  std::vector<double> _energy;
+
+  //! summed-area table, (_netabins + 1) x (_nphibins + 1)
+  std::vector<double> _prefix;
+
+  //! summed-area table of the number of towers, a window without towers
+  //! is exactly 0 rather than a rounding residual of the differences
+  std::vector<int> _count_prefix;
+};
+
+#endif /* RAWTOWERENERGYGRID_H__ */
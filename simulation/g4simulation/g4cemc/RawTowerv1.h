@@ -17,6 +17,8 @@ class RawTowerv1 : public RawTower {
              const unsigned int iphi);
   virtual ~RawTowerv1();
 
+  RawTowerv1* clone() const { return new RawTowerv1(*this); }
+
   void Reset();
   int isValid() const;
   void identify(std::ostream& os = std::cout) const;
@@ -0,0 +1,69 @@
+#include "RawTowerv2.h"
+
+#include "RawTowerDefs.h"
+
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+ClassImp(RawTowerv2)
+
+// empty ranges handed out for the cells and showers
+static const RawTower::CellMap empty_cells;
+static const RawTower::ShowerMap empty_showers;
+
+RawTowerv2::RawTowerv2() :
+    towerid(~0), // initialize all bits on
+    energy(0), time(NAN)
+{
+}
+
+RawTowerv2::RawTowerv2(const RawTower & tower) :
+    towerid(tower.get_id()), energy(tower.get_energy()), time(tower.get_time())
+{
+}
+
+RawTowerv2::RawTowerv2(RawTowerDefs::keytype id) :
+    towerid(id), energy(0), time(NAN)
+{
+}
+
+RawTowerv2::RawTowerv2(const RawTowerDefs::CalorimeterId caloid,
+    const unsigned int ieta, const unsigned int iphi) :
+    towerid(0), energy(0), time(NAN)
+{
+  towerid = RawTowerDefs::encode_towerid(caloid, ieta, iphi);
+}
+
+void
+RawTowerv2::Reset()
+{
+  energy = 0;
+  time = NAN;
+}
+
+int
+RawTowerv2::isValid() const
+{
+  return get_energy() != 0;
+}
+
+void
+RawTowerv2::identify(std::ostream& os) const
+{
+  os << "RawTowerv2: etabin: " << get_bineta() << ", phibin: " << get_binphi()
+      << " energy=" << get_energy() << std::endl;
+}
+
+RawTower::CellConstRange
+RawTowerv2::get_g4cells() const
+{
+  return make_pair(empty_cells.begin(), empty_cells.end());
+}
+
+RawTower::ShowerConstRange
+RawTowerv2::get_g4showers() const
+{
+  return make_pair(empty_showers.begin(), empty_showers.end());
+}
@@ -0,0 +1,62 @@
+#ifndef RAWTOWERV2_H_
+#define RAWTOWERV2_H_
+
+#include "RawTower.h"
+
+#include "RawTowerDefs.h"
+
+/*! \class RawTowerv2
+    \brief tower without the Geant4 cell and shower back-references
+
+    Only the tower ID, energy and time are kept, which makes the tower
+    a few bytes on the DST instead of two maps. Cells and showers added
+    to it are dropped, so it is meant for production where the truth
+    association of towers is not needed.
+*/
+class RawTowerv2 : public RawTower {
+ public:
+  RawTowerv2();
+  RawTowerv2(const RawTower& tower);
+  RawTowerv2(RawTowerDefs::keytype id);
+  RawTowerv2(const RawTowerDefs::CalorimeterId caloid, const unsigned int ieta,
+             const unsigned int iphi);
+  virtual ~RawTowerv2() {}
+
+  RawTowerv2* clone() const { return new RawTowerv2(*this); }
+
+  void Reset();
+  int isValid() const;
+  void identify(std::ostream& os = std::cout) const;
+
+  void set_id(RawTowerDefs::keytype id) { towerid = id; }
+  RawTowerDefs::keytype get_id() const { return towerid; }
+  int get_bineta() const { return RawTowerDefs::decode_index1(towerid); }
+  int get_binphi() const { return RawTowerDefs::decode_index2(towerid); }
+  double get_energy() const { return energy; }
+  void set_energy(const double e) { energy = e; }
+  float get_time() const { return time; }
+  void set_time(const float t) { time = t; }
+
+  //---no cells or showers, they are ignored when added--------------------------
+
+  RawTower::CellConstRange get_g4cells() const;
+  void add_ecell(const PHG4CylinderCellDefs::keytype g4cellid,
+                 const float ecell) {}
+
+  RawTower::ShowerConstRange get_g4showers() const;
+  void add_eshower(const int g4showerid, const float eshower) {}
+
+ protected:
+  RawTowerDefs::keytype towerid;
+
+  //! energy assigned to the tower. Depending on stage of process and DST node
+  //! name, it could be energy deposition, light yield or calibrated energies
+  double energy;
+  //! Time stamp assigned to the tower. Depending on the tower maker, it could
+  //! be rise time or peak time.
+  float time;
+
+  ClassDef(RawTowerv2, 1)
+};
+
+#endif /* RAWTOWERV2_H_ */
@@ -18,6 +18,9 @@
 
 #include <TROOT.h>
 
+#include <boost/unordered_map.hpp>
+
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -281,6 +284,12 @@ int PHG4CylinderCellReco::InitRun(PHCompositeNode *topNode)
     cout << "===========================================================================" << endl;
   }
 
+  // nodes used in process_event, cells of different detectors
+  // can be made concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode(hitnodename);
+  DeclareInputNode(seggeonodename);
+  DeclareOutputNode(cellnodename);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -313,6 +322,12 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
   map<int, std::pair <double, double> >::iterator sizeiter;
   PHG4HitContainer::LayerIter layer;
   pair<PHG4HitContainer::LayerIter, PHG4HitContainer::LayerIter> layer_begin_end = g4hit->getLayers();
+  // This map holds the hit cells of the current layer
+  // the key is constructed from the phi and z (or eta) bin index values:
+  // phibin * nzbins + zbin, unique for a given phi and z (or eta) bin combination
+  boost::unordered_map<unsigned long, PHG4CylinderCell*> cellptmap;
+  vector<pair<unsigned long, PHG4CylinderCell*> > sortedcells;
+  vector<pair<unsigned long, PHG4CylinderCell*> >::const_iterator it;
   //   cout << "number of layers: " << g4hit->num_layers() << endl;
   //   cout << "number of hits: " << g4hit->size() << endl;
   //   for (layer = layer_begin_end.first; layer != layer_begin_end.second; layer++)
@@ -451,37 +466,29 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
                   int iphibin = vphi[i1];
                   int ietabin = veta[i1];
 
-		  // This is the key for cellptmap
-		  // It is constructed using the phi and z (or eta) bin index values
-		  // It will be unique for a given phi and z (or eta) bin combination
-		  char inkey[1024];
-		  sprintf(inkey,"%i-%i",iphibin,ietabin);
-		  std::string key(inkey);
+		  unsigned long key = (unsigned long) iphibin * nzbins + ietabin;
 
 		  if(verbosity > 1)
 		    cout << " iphibin " << iphibin << " ietabin " << ietabin << " key " << key << endl;
 
-		  if(cellptmap.count(key) > 0)
+		  PHG4CylinderCell *&cell = cellptmap[key];
+		  if(cell)
 		    {
 		      if(verbosity > 1)
 			cout << "  add energy to existing cell " << endl;
-
-		      cellptmap.find(key)->second->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
-		      cellptmap.find(key)->second->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
 		    }
 		  else
 		    {
 		      if(verbosity > 1)
 			cout << "    did not find a previous entry for key = " << key << " add a new one" << endl;
 
-		      cellptmap[key] = new PHG4CylinderCellv1();
-		      it = cellptmap.find(key);
-                      it->second->set_layer(*layer);
-                      it->second->set_phibin(iphibin);
-                      it->second->set_etabin(ietabin);		      
-		      it->second->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
-		      it->second->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
+		      cell = new PHG4CylinderCellv1();
+                      cell->set_layer(*layer);
+                      cell->set_phibin(iphibin);
+                      cell->set_etabin(ietabin);		      
 		    }
+		  cell->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
+		  cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
 
 		  // just a sanity check - we don't want to mess up by having Nan's or Infs in our energy deposition
 		  if (! isfinite(hiter->second->get_edep()*vdedx[i1]))
@@ -497,7 +504,10 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
           int numcells = 0;
 
-	  for(it = cellptmap.begin(); it != cellptmap.end(); ++it)
+	  // hand the cells over in phi/eta bin order
+	  sortedcells.assign(cellptmap.begin(), cellptmap.end());
+	  sort(sortedcells.begin(), sortedcells.end());
+	  for(it = sortedcells.begin(); it != sortedcells.end(); ++it)
 	    {
 	      cells->AddCylinderCell(*layer, it->second);
 	      numcells++;
@@ -677,52 +687,38 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
                   int iphibin = vphi[i1];
                   int izbin = vz[i1];
 
-		  char inkey[1024];
-		  sprintf(inkey,"%i-%i",iphibin,izbin);
-		  std::string key(inkey);
+		  unsigned long key = (unsigned long) iphibin * nzbins + izbin;
 
 		  if(verbosity > 1)
 		    cout << " iphibin " << iphibin << " izbin " << izbin << " key " << key << endl;
 	
 		  // check to see if there is already an entry for this cell
-		  if(cellptmap.count(key) > 0)
+		  PHG4CylinderCell *&cell = cellptmap[key];
+		  if(cell)
 		    {
 		      if(verbosity > 1)
-			cout << "  add energy to existing cell for key = " << cellptmap.find(key)->first << endl;
-
-		      cellptmap.find(key)->second->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
-		      cellptmap.find(key)->second->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
-
-		      if(verbosity > 1 && std::isnan(hiter->second->get_light_yield()*vdedx[i1]))
-            {
-
-              cout << "    NAN lighy yield with vdedx[i1] = "<<vdedx[i1]
-              <<" and hiter->second->get_light_yield() = "<<hiter->second->get_light_yield() << endl;
-
-            }
+			cout << "  add energy to existing cell for key = " << key << endl;
 		    }
 		  else
 		    {
 		      if(verbosity > 1)
 			cout << "    did not find a previous entry for key = " << key << " create a new one" << endl;
 
-		      cellptmap[key] = new PHG4CylinderCellv1();
-		      it = cellptmap.find(key);
-		      it->second->set_layer(*layer);
-                      it->second->set_phibin(iphibin);
-                      it->second->set_zbin(izbin);
-		      it->second->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
-		      it->second->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
+		      cell = new PHG4CylinderCellv1();
+		      cell->set_layer(*layer);
+                      cell->set_phibin(iphibin);
+                      cell->set_zbin(izbin);
+		    }
+		  cell->add_edep(hiter->first, hiter->second->get_edep()*vdedx[i1], hiter->second->get_light_yield()*vdedx[i1]);
+		  cell->add_shower_edep(hiter->second->get_shower_id(), hiter->second->get_edep()*vdedx[i1]);
 
-		      if(verbosity > 1 && std::isnan(hiter->second->get_light_yield()*vdedx[i1]))
+		  if(verbosity > 1 && std::isnan(hiter->second->get_light_yield()*vdedx[i1]))
             {
 
               cout << "    NAN lighy yield with vdedx[i1] = "<<vdedx[i1]
               <<" and hiter->second->get_light_yield() = "<<hiter->second->get_light_yield() << endl;
 
             }
-
-		    }
 		}
               vphi.clear();
               vz.clear();
@@ -731,7 +727,10 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
           int numcells = 0;
 
-	  for(it = cellptmap.begin(); it != cellptmap.end(); ++it)
+	  // hand the cells over in phi/z bin order
+	  sortedcells.assign(cellptmap.begin(), cellptmap.end());
+	  sort(sortedcells.begin(), sortedcells.end());
+	  for(it = sortedcells.begin(); it != sortedcells.end(); ++it)
 	    {
 	      cells->AddCylinderCell(*layer, it->second);
 	      numcells++;
@@ -756,11 +755,8 @@ PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
       // now reset the cell map before moving on to the next layer
       if(verbosity > 1)
 	cout << "cellptmap for layer " << *layer << " has final length " << cellptmap.size();
-      while(cellptmap.begin() != cellptmap.end())
-	{
-	  // Assumes that mmmory is freed by the cylinder cell container when it is destroyed
-	  cellptmap.erase(cellptmap.begin());
-	} 
+      // Assumes that mmmory is freed by the cylinder cell container when it is destroyed
+      cellptmap.clear();
       if(verbosity > 1)
 	cout << " reset it to " << cellptmap.size() << endl;
     }
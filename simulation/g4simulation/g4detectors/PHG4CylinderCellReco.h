@@ -64,8 +64,6 @@ class PHG4CylinderCellReco : public SubsysReco
   std::string geonodename;
   std::string seggeonodename;
   std::map<int, std::pair<int, int> > n_phi_z_bins;
-  std::map<std::string, PHG4CylinderCell*> cellptmap;  // This map holds the hit cells
-  std::map<std::string, PHG4CylinderCell*>::iterator it;
 
   PHTimeServer::timer _timer;
   int nbins[2];
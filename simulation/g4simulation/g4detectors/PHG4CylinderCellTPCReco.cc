@@ -16,10 +16,16 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/PHIODataNode.h>
 #include <phool/getClass.h>
+#include <phool/PHRandomSeed.h>
 
 #include <TROOT.h>
 #include <TMath.h>
 
+#include <gsl/gsl_randist.h>
+
+#include <boost/unordered_map.hpp>
+
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -34,14 +40,21 @@ PHG4CylinderCellTPCReco::PHG4CylinderCellTPCReco(int n_pixel,
       diffusion(0.0057),
       elec_per_kev(38.),
       driftv(6.0/1000.0), // cm per ns
+      fast_diffusion(false),
       num_pixel_layers(n_pixel),
       tmin_default(0.0),  // ns
       tmax_default(60.0), // ns
       tmin_max(),
-      distortion(NULL) {}
+      distortion(NULL)
+{
+  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  unsigned int seed = PHRandomSeed(); // fixed seed is handled in this funtcion
+  gsl_rng_set(RandomGenerator, seed);
+}
 
 PHG4CylinderCellTPCReco::~PHG4CylinderCellTPCReco()
 {
+  gsl_rng_free(RandomGenerator);
   if (distortion)
     delete distortion;
 }
@@ -65,6 +78,22 @@ void PHG4CylinderCellTPCReco::cellsize(const int i, const double sr, const doubl
 }
 
 
+void PHG4CylinderCellTPCReco::bin_integrals(vector<double> &integrals, const double disp, const double step, const double sig_inv, const int n)
+{
+  // neighbouring bins share an edge, so 2n+2 erf calls for 2n+1 bins
+  edge_erf.resize(2*n+2);
+  for( int k = 0; k < 2*n+2; ++k )
+  {
+    edge_erf[k] = erf(-0.5*sqrt(2.)*disp*sig_inv + 0.5*sqrt(2.)*( ((double)(k - n) - 0.5)*step )*sig_inv);
+  }
+  integrals.resize(2*n+1);
+  for( int i = 0; i < 2*n+1; ++i )
+  {
+    integrals[i] = 0.5*edge_erf[i+1] - 0.5*edge_erf[i];
+  }
+}
+
+
 int PHG4CylinderCellTPCReco::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -179,10 +208,13 @@ int PHG4CylinderCellTPCReco::process_event(PHCompositeNode *topNode)
   map<int, std::pair <double, double> >::iterator sizeiter;
   PHG4HitContainer::LayerIter layer;
   pair<PHG4HitContainer::LayerIter, PHG4HitContainer::LayerIter> layer_begin_end = g4hit->getLayers();
+  // fired cells of the current layer, keyed by phibin*nzbins + zbin
+  boost::unordered_map<unsigned long, PHG4CylinderCell*> cellptmap;
+  vector<pair<unsigned long, PHG4CylinderCell*> > sortedcells;
   
   for(layer = layer_begin_end.first; layer != layer_begin_end.second; layer++)
   {
-    std::map<std::string, PHG4CylinderCell*> cellptmap;
+    cellptmap.clear();
     PHG4HitContainer::ConstIterator hiter;
     PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits(*layer);
     PHG4CylinderCellGeom *geo = seggeo->GetLayerCellGeom(*layer);
@@ -245,24 +277,16 @@ int PHG4CylinderCellTPCReco::process_event(PHCompositeNode *topNode)
       
       if( (*layer) < (unsigned int)num_pixel_layers )
       {
-        char inkey[1024];
-        sprintf(inkey,"%i-%i",phibin,zbin);
-        std::string key(inkey);
-        if(cellptmap.count(key) > 0)
-        {
-          cellptmap.find(key)->second->add_edep(hiter->first, edep);
-          cellptmap.find(key)->second->add_shower_edep(hiter->second->get_shower_id(), edep);
-        }
-        else
+        PHG4CylinderCell *&cell = cellptmap[(unsigned long) phibin * nzbins + zbin];
+        if(!cell)
         {
-          cellptmap[key] = new PHG4CylinderCellv1();
-          std::map<std::string, PHG4CylinderCell*>::iterator it = cellptmap.find(key);
-          it->second->set_layer(*layer);
-          it->second->set_phibin(phibin);
-          it->second->set_zbin(zbin);
-          it->second->add_edep(hiter->first, edep);
-          it->second->add_shower_edep(hiter->second->get_shower_id(), edep);
+          cell = new PHG4CylinderCellv1();
+          cell->set_layer(*layer);
+          cell->set_phibin(phibin);
+          cell->set_zbin(zbin);
         }
+        cell->add_edep(hiter->first, edep);
+        cell->add_shower_edep(hiter->second->get_shower_id(), edep);
       }
       else
       {
@@ -277,6 +301,78 @@ int PHG4CylinderCellTPCReco::process_event(PHCompositeNode *topNode)
         double cloud_sig_x_inv = 1./cloud_sig_x;
         double cloud_sig_z_inv = 1./cloud_sig_z;
         
+        if( fast_diffusion )
+        {
+          // the cloud factorizes in phi and z, each row of bins needs
+          // one set of integrals instead of four erf calls per bin
+          bin_integrals( phi_integrals, phidisp*r, phistepsize*r, cloud_sig_x_inv, n_phi );
+          bin_integrals( z_integrals, zdisp, zstepsize, cloud_sig_z_inv, n_z );
+          
+          // z integral over the bins inside of the layer
+          double z_sum = 0.;
+          for( int iz = -n_z; iz <= n_z; ++iz )
+          {
+            int cur_z_bin = zbin + iz;
+            if( (cur_z_bin >= 0) && (cur_z_bin < nzbins) ){z_sum += z_integrals[iz + n_z];}
+          }
+          if( !(z_sum > 0.) ){continue;}
+          
+          for( int iphi = -n_phi; iphi <= n_phi; ++iphi )
+          {
+            int cur_phi_bin = phibin + iphi;
+            if( cur_phi_bin < 0 ){cur_phi_bin += nphibins;}
+            else if( cur_phi_bin >= nphibins ){cur_phi_bin -= nphibins;}
+            
+            if( (cur_phi_bin < 0) || (cur_phi_bin >= nphibins) ){continue;}
+            
+            // independent Poisson counts in the bins of a row are the same as
+            // one Poisson count for the row, shared out multinomially by the
+            // z integrals. Rows in the tails of the cloud cost one draw.
+            double row_mean = nelec*phi_integrals[iphi + n_phi]*z_sum;
+            if( !(row_mean > 0.) ){continue;}
+            int row_count = rand.Poisson( row_mean );
+            if( row_count == 0 ){continue;}
+            
+            // multinomial split as a chain of binomials: each bin takes its
+            // share of the electrons left, conditional on the bins before it
+            z_counts.assign( 2*n_z+1, 0 );
+            unsigned int remaining = row_count;
+            double remaining_p = z_sum;
+            // the last bin inside of the layer takes the rest
+            const int iz_last = min( n_z, nzbins - 1 - zbin );
+            for( int iz = -n_z; iz <= n_z && remaining > 0; ++iz )
+            {
+              int cur_z_bin = zbin + iz;
+              if( (cur_z_bin < 0) || (cur_z_bin >= nzbins) ){continue;}
+              double p = z_integrals[iz + n_z];
+              unsigned int n = remaining;
+              if( (iz < iz_last) && (p < remaining_p) ){n = gsl_ran_binomial( RandomGenerator, p/remaining_p, remaining );}
+              z_counts[iz + n_z] = n;
+              remaining -= n;
+              remaining_p -= p;
+            }
+            
+            for( int iz = -n_z; iz <= n_z; ++iz )
+            {
+              if( z_counts[iz + n_z] == 0 ){continue;}
+              int cur_z_bin = zbin + iz;
+              double total_weight = z_counts[iz + n_z];
+              
+              PHG4CylinderCell *&cell = cellptmap[(unsigned long) cur_phi_bin * nzbins + cur_z_bin];
+              if(!cell)
+              {
+                cell = new PHG4CylinderCellv1();
+                cell->set_layer(*layer);
+                cell->set_phibin(cur_phi_bin);
+                cell->set_zbin(cur_z_bin);
+              }
+              cell->add_edep(hiter->first, total_weight);
+              cell->add_shower_edep(hiter->second->get_shower_id(), total_weight);
+            }
+          }
+          continue;
+        }
+        
         // we will store effective number of electrons instead of edep
         for( int iphi = -n_phi; iphi <= n_phi; ++iphi )
         {
@@ -300,30 +396,25 @@ int PHG4CylinderCellTPCReco::process_event(PHCompositeNode *topNode)
             if( !(total_weight == total_weight) ){continue;}
             if(total_weight == 0.){continue;}
             
-            char inkey[1024];
-            sprintf(inkey,"%i-%i",cur_phi_bin,cur_z_bin);
-            std::string key(inkey);
-            if(cellptmap.count(key) > 0)
-            {
-              cellptmap.find(key)->second->add_edep(hiter->first, total_weight);
-              cellptmap.find(key)->second->add_shower_edep(hiter->second->get_shower_id(), total_weight);
-            }
-            else
+            PHG4CylinderCell *&cell = cellptmap[(unsigned long) cur_phi_bin * nzbins + cur_z_bin];
+            if(!cell)
             {
-              cellptmap[key] = new PHG4CylinderCellv1();
-              std::map<std::string, PHG4CylinderCell*>::iterator it = cellptmap.find(key);
-              it->second->set_layer(*layer);
-              it->second->set_phibin(cur_phi_bin);
-              it->second->set_zbin(cur_z_bin);
-              it->second->add_edep(hiter->first, total_weight);
-              it->second->add_shower_edep(hiter->second->get_shower_id(), total_weight);
+              cell = new PHG4CylinderCellv1();
+              cell->set_layer(*layer);
+              cell->set_phibin(cur_phi_bin);
+              cell->set_zbin(cur_z_bin);
             }
+            cell->add_edep(hiter->first, total_weight);
+            cell->add_shower_edep(hiter->second->get_shower_id(), total_weight);
           }
         }
       }
     }
+    // hand the cells over in phi/z bin order
+    sortedcells.assign(cellptmap.begin(), cellptmap.end());
+    sort(sortedcells.begin(), sortedcells.end());
     int count = 0;
-    for(std::map<std::string, PHG4CylinderCell*>::iterator it = cellptmap.begin(); it != cellptmap.end(); ++it)
+    for(vector<pair<unsigned long, PHG4CylinderCell*> >::const_iterator it = sortedcells.begin(); it != sortedcells.end(); ++it)
     {
       cells->AddCylinderCell((unsigned int)(*layer), it->second);
       count += 1;
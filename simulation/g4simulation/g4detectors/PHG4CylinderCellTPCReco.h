@@ -5,7 +5,9 @@
 #include <phool/PHTimeServer.h>
 #include <string>
 #include <map>
+#include <vector>
 #include "TRandom3.h"
+#include <gsl/gsl_rng.h>
 
 class PHCompositeNode;
 class PHG4CylinderCell;
@@ -39,6 +41,8 @@ public:
   void setDiffusion( double diff ){diffusion = diff;}
   void setElectronsPerKeV( double epk ){elec_per_kev = epk;}
   void set_drift_velocity( const double cm_per_ns) { driftv = cm_per_ns;}
+  //! true: row-wise diffusion with shared bin integrals, false (default): bin-by-bin reference
+  void set_fast_diffusion( const bool b ) { fast_diffusion = b;}
   
   double get_timing_window_min(const int i) {return tmin_max[i].first;}
   double get_timing_window_max(const int i) {return tmin_max[i].second;}
@@ -53,6 +57,9 @@ public:
   void setDistortion (PHG4TPCDistortion * d) {distortion = d;}
 
 protected:
+  //! integrals of a unit gaussian over the 2n+1 bins around the hit, from the erf at the bin edges
+  void bin_integrals(std::vector<double> &integrals, const double disp, const double step, const double sig_inv, const int n);
+
 //   void set_size(const int i, const double sizeA, const double sizeB, const int what);
 //   int CheckEnergy(PHCompositeNode *topNode);
 //   static std::pair<double, double> get_etaphi(const double x, const double y, const double z);
@@ -76,10 +83,13 @@ protected:
   int nbins[2];
   
   TRandom3 rand;
+  //! splits the electrons of a row over its z bins (binomial draws)
+  gsl_rng *RandomGenerator;
 
   double diffusion;
   double elec_per_kev;
   double driftv;
+  bool fast_diffusion;
 
   int num_pixel_layers;
 
@@ -89,6 +99,12 @@ protected:
   
   //! distortion to the primary ionization if not NULL
   PHG4TPCDistortion * distortion;
+
+  // work space of the diffusion, reused between hits
+  std::vector<double> edge_erf;
+  std::vector<double> phi_integrals;
+  std::vector<double> z_integrals;
+  std::vector<int> z_counts;
 };
 
 #endif
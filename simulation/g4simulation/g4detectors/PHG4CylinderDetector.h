@@ -27,6 +27,7 @@ class PHG4CylinderDetector: public PHG4Detector
   void Construct( G4LogicalVolume* world );
 
   bool IsInCylinder(const G4VPhysicalVolume*) const;
+  const G4VPhysicalVolume *GetCylinderVolume() const {return cylinder_physi;}
   void SuperDetector(const std::string &name) {superdetector = name;}
   const std::string SuperDetector() const {return superdetector;}
   int get_Layer() const {return layer;}
@@ -4,7 +4,6 @@
 
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Hit.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -98,8 +97,9 @@ bool PHG4CylinderSteppingAction::UserSteppingAction( const G4Step* aStep, bool )
 	  // flush out previous hit
 	  save_previous_g4hit();
           save_layer_id = layer_id;
+	  savehitcontainer = hits_;
 
-          hit = new PHG4Hitv1();
+          hit = savehitcontainer->NewHit();
 
 	  hit->set_layer((unsigned int)layer_id);
 
@@ -118,7 +118,6 @@ bool PHG4CylinderSteppingAction::UserSteppingAction( const G4Step* aStep, bool )
 	  hit->set_trkid(aTrack->GetTrackID());
           //set the initial energy deposit
           hit->set_edep(0);
-	  savehitcontainer = hits_;
 	  if ( G4VUserTrackInformation* p = aTrack->GetUserInformation() )
 	    {
 	      if ( PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p) )
@@ -214,6 +213,16 @@ PHG4CylinderSteppingAction::flush_cached_values()
   return;
 }
 
+bool
+PHG4CylinderSteppingAction::GetVolumes(std::set<const G4VPhysicalVolume *> &volumes) const
+{
+  if (detector_->GetCylinderVolume())
+    {
+      volumes.insert(detector_->GetCylinderVolume());
+    }
+  return true;
+}
+
 void
 PHG4CylinderSteppingAction::save_previous_g4hit()
 {
@@ -232,7 +241,7 @@ PHG4CylinderSteppingAction::save_previous_g4hit()
     }
   else
     {
-      delete hit;
+      savehitcontainer->RecycleHit(hit);
     }
   hit = NULL;
   return;
@@ -29,6 +29,9 @@ class PHG4CylinderSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers( PHCompositeNode* );
 
+  //! reimplemented from base class, we only need steps in our cylinder
+  virtual bool GetVolumes(std::set<const G4VPhysicalVolume *> &volumes) const;
+
   void flush_cached_values();
 
   private:
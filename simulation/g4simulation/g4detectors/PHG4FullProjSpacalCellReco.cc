@@ -289,6 +289,13 @@ PHG4FullProjSpacalCellReco::InitRun(PHCompositeNode *topNode)
         }
     }
   
+  // nodes used in process_event, cells of different detectors
+  // can be made concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode(hitnodename);
+  DeclareInputNode(seggeonodename);
+  DeclareInputNode(geonodename);
+  DeclareOutputNode(cellnodename);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
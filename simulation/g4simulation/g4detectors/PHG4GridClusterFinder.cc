@@ -0,0 +1,123 @@
+#include "PHG4GridClusterFinder.h"
+
+#include <algorithm>
+
+using namespace std;
+
+bool PHG4GridClusterFinder::cell_less(const cell_hit &lhs, const cell_hit &rhs)
+{
+  if (lhs.sensor != rhs.sensor) return lhs.sensor < rhs.sensor;
+  if (lhs.ib != rhs.ib) return lhs.ib < rhs.ib;
+  return lhs.ia < rhs.ia;
+}
+
+void PHG4GridClusterFinder::clear()
+{
+  _hits.clear();
+  _sorted.clear();
+  _parent.clear();
+  _cluster_id.clear();
+  _members.clear();
+  _offsets.clear();
+}
+
+void PHG4GridClusterFinder::add_hit(const int sensor, const int ib, const int ia)
+{
+  cell_hit h;
+  h.sensor = sensor;
+  h.ib = ib;
+  h.ia = ia;
+  h.hit = _hits.size();
+  _hits.push_back(h);
+}
+
+int PHG4GridClusterFinder::find_root(int i)
+{
+  // path halving
+  while (_parent[i] != i)
+  {
+    _parent[i] = _parent[_parent[i]];
+    i = _parent[i];
+  }
+  return i;
+}
+
+void PHG4GridClusterFinder::join(const int i, const int j)
+{
+  int ri = find_root(i);
+  int rj = find_root(j);
+  if (ri == rj) return;
+  // the lower hit index becomes the root
+  if (ri < rj) _parent[rj] = ri;
+  else _parent[ri] = rj;
+}
+
+void PHG4GridClusterFinder::join_cells(const int i, const int sensor, const int ib, const int ia_min, const int ia_max)
+{
+  cell_hit lo;
+  lo.sensor = sensor;
+  lo.ib = ib;
+  lo.ia = ia_min;
+  lo.hit = 0;
+  for (vector<cell_hit>::const_iterator it = lower_bound(_sorted.begin(), _sorted.end(), lo, cell_less);
+       it != _sorted.end() && it->sensor == sensor && it->ib == ib && it->ia <= ia_max;
+       ++it)
+  {
+    join(i, it->hit);
+  }
+}
+
+int PHG4GridClusterFinder::find_clusters(const int a_reach, const int b_period)
+{
+  const int nhits = _hits.size();
+
+  _sorted = _hits;
+  sort(_sorted.begin(), _sorted.end(), cell_less);
+
+  _parent.resize(nhits);
+  for (int i = 0; i < nhits; ++i) _parent[i] = i;
+
+  // each pair is joined from the hit with the lower b bin, or the lower
+  // a bin in the same row, so only half of the neighbourhood is searched
+  for (int i = 0; i < nhits; ++i)
+  {
+    const cell_hit &h = _hits[i];
+    join_cells(i, h.sensor, h.ib, h.ia, h.ia + a_reach);
+    join_cells(i, h.sensor, h.ib + 1, h.ia - a_reach, h.ia + a_reach);
+    if (b_period > 0 && h.ib == b_period - 1)
+    {
+      join_cells(i, h.sensor, 0, h.ia - a_reach, h.ia + a_reach);
+    }
+  }
+
+  // number the clusters by their first hit
+  vector<int> &label = _cluster_id;
+  label.assign(nhits, -1);
+  int nclusters = 0;
+  _offsets.assign(1, 0);
+  for (int i = 0; i < nhits; ++i)
+  {
+    const int root = find_root(i);
+    if (root == i)
+    {
+      label[i] = nclusters++;
+      _offsets.push_back(0);
+    }
+    else
+    {
+      label[i] = label[root];
+    }
+    ++_offsets[label[i] + 1];
+  }
+
+  // members grouped by cluster, in hit order
+  for (int k = 0; k < nclusters; ++k) _offsets[k + 1] += _offsets[k];
+  _members.resize(nhits);
+  vector<int> next(_offsets.begin(), _offsets.end() - 1);
+  for (int i = 0; i < nhits; ++i)
+  {
+    _members[next[label[i]]++] = i;
+  }
+
+  return nclusters;
+}
@@ -0,0 +1,72 @@
+#ifndef PHG4GRIDCLUSTERFINDER_H
+#define PHG4GRIDCLUSTERFINDER_H
+
+#include <vector>
+
+/*! \class PHG4GridClusterFinder
+    \brief connected groups of hits on a (sensor, b, a) grid
+
+    Hits are given as integer cell coordinates, e.g. (0, phi bin, z bin)
+    for a cylinder layer or (0, phi bin, eta bin) for a calorimeter. Two
+    hits are neighbours if they are in the same sensor, their b bins
+    differ by at most one and their a bins by at most a_reach. With a
+    b period the first and last b bins are neighbours as well (phi
+    wrap-around).
+
+    The hits are sorted by cell and the neighbours of each hit are found
+    by binary search, so the grouping is O(N log N) instead of testing
+    all pairs. The groups are joined with union-find. Clusters are
+    numbered by their first hit, which is the numbering
+    boost::connected_components gives for the same hit order, and the
+    members of each cluster come in the order the hits were added.
+*/
+class PHG4GridClusterFinder
+{
+ public:
+
+  PHG4GridClusterFinder() {}
+  virtual ~PHG4GridClusterFinder() {}
+
+  //! forget the hits, the memory is kept for the next event
+  void clear();
+
+  //! hits are numbered in the order they are added
+  void add_hit(const int sensor, const int ib, const int ia);
+  unsigned int size() const {return _hits.size();}
+
+  //! \return number of clusters
+  int find_clusters(const int a_reach, const int b_period = 0);
+
+  //! cluster id of each hit
+  const std::vector<int> &get_cluster_ids() const {return _cluster_id;}
+
+  //! hits of cluster k are get_members()[get_offsets()[k]] ... get_members()[get_offsets()[k+1]-1]
+  const std::vector<int> &get_members() const {return _members;}
+  const std::vector<int> &get_offsets() const {return _offsets;}
+
+ protected:
+
+  struct cell_hit
+  {
+    int sensor;
+    int ib;
+    int ia;
+    int hit;
+  };
+
+  static bool cell_less(const cell_hit &lhs, const cell_hit &rhs);
+
+  int find_root(int i);
+  void join(const int i, const int j);
+  //! join hit i with the hits in cells (sensor, ib, ia_min ... ia_max)
+  void join_cells(const int i, const int sensor, const int ib, const int ia_min, const int ia_max);
+
+  std::vector<cell_hit> _hits;
+  std::vector<cell_hit> _sorted;
+  std::vector<int> _parent;
+  std::vector<int> _cluster_id;
+  std::vector<int> _members;
+  std::vector<int> _offsets;
+};
+
+#endif
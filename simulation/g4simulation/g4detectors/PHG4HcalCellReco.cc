@@ -152,6 +152,12 @@ int PHG4HcalCellReco::InitRun(PHCompositeNode *topNode)
     tmin_max.insert(std::make_pair(layer,std::make_pair(tmin_default,tmax_default)));    
   }
   
+  // nodes used in process_event, cells of different detectors
+  // can be made concurrently (Fun4AllServer::ParallelSubsystems)
+  DeclareInputNode(hitnodename);
+  DeclareInputNode(seggeonodename);
+  DeclareOutputNode(cellnodename);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
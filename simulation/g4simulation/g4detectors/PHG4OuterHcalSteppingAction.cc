@@ -9,7 +9,6 @@
 
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Hit.h>
-#include <g4main/PHG4Hitv1.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4TrackUserInfoV1.h>
 
@@ -183,7 +182,16 @@ bool PHG4OuterHcalSteppingAction::UserSteppingAction( const G4Step* aStep, bool
 	  // flush out previous hit
 	  save_previous_g4hit();
           save_layer_id = layer_id;
-	  hit = new PHG4Hitv1();
+	  // Now save the container we want to add this hit to
+	  if (whichactive > 0) // return of IsInOuterHcalDetector, > 0 hit in scintillator, < 0 hit in absorber
+	    {
+	      savehitcontainer = hits_;
+	    }
+	  else
+	    {
+	      savehitcontainer = absorberhits_;
+	    }
+	  hit = savehitcontainer->NewHit();
 	  hit->set_layer(motherid);
 	  hit->set_scint_id(tower_id); // the slat id (or steel plate id)
 	  //here we set the entrance values in cm
@@ -211,12 +219,6 @@ bool PHG4OuterHcalSteppingAction::UserSteppingAction( const G4Step* aStep, bool
 	  if (whichactive > 0) // return of IsInOuterHcalDetector, > 0 hit in scintillator, < 0 hit in absorber
 	    {
 	      hit->set_light_yield(0); //  for scintillator only, initialize light yields
-	      // Now save the container we want to add this hit to
-	      savehitcontainer = hits_;
-	    }
-	  else
-	    {
-	      savehitcontainer = absorberhits_;
 	    }
 	  if ( G4VUserTrackInformation* p = aTrack->GetUserInformation() )
 	    {
@@ -486,7 +488,7 @@ PHG4OuterHcalSteppingAction::save_previous_g4hit()
     }
   else
     {
-      delete hit;
+      savehitcontainer->RecycleHit(hit);
     }
   hit = NULL;
   return;
@@ -232,35 +232,38 @@ PHG4SiliconTrackerCellReco::process_event(PHCompositeNode *topNode)
 	  // ladder_phi index is the phi bin for the ladder segment containing the sensor with this hit strip
 	  // strip_z_index is the strip column inside the sensor
 	  // strip_y_index is the number of the strip i the column
-	  char inkey[1024];
-	  sprintf(inkey,"%i-%i_%i_%i",ladder_z_index, ladder_phi_index, strip_z_index, strip_y_index);
-	  std::string key(inkey);
-
-	  if (celllist.count(key) > 0) {
-	    celllist[key]->add_edep(hiter->first, hiter->second->get_edep());
+	  // each index goes into 16 bits of the key (indices are way below 2^15)
+	  unsigned long long key = ((unsigned long long) (unsigned short) ladder_z_index << 48) |
+	    ((unsigned long long) (unsigned short) ladder_phi_index << 32) |
+	    ((unsigned long long) (unsigned short) strip_z_index << 16) |
+	    (unsigned long long) (unsigned short) strip_y_index;
+
+	  PHG4CylinderCell *&cell = celllist[key];
+	  if (cell) {
+	    cell->add_edep(hiter->first, hiter->second->get_edep());
 	  } else {
-	    celllist[key] = new PHG4CylinderCellv2();
-	    celllist[key]->set_layer(*layer);
+	    cell = new PHG4CylinderCellv2();
+	    cell->set_layer(*layer);
 
 	    // This encodes the z and phi position of the sensor 
 	    ostringstream name;
 	    name << ladder_z_index << "_" << ladder_phi_index;
 	    std::string sensor_index = name.str();
-	    celllist[key]->set_sensor_index(sensor_index);
+	    cell->set_sensor_index(sensor_index);
 
-	    celllist[key]->set_ladder_z_index(ladder_z_index);
-	    celllist[key]->set_ladder_phi_index(ladder_phi_index);
+	    cell->set_ladder_z_index(ladder_z_index);
+	    cell->set_ladder_phi_index(ladder_phi_index);
 	    
 	    // The z and phi position of the hit strip within the sensor
-	    celllist[key]->set_zbin(strip_z_index);
-	    celllist[key]->set_phibin(strip_y_index);	  
+	    cell->set_zbin(strip_z_index);
+	    cell->set_phibin(strip_y_index);	  
 
-	    celllist[key]->add_edep(hiter->first, hiter->second->get_edep());
+	    cell->add_edep(hiter->first, hiter->second->get_edep());
 	  }
 	} // end loop over g4hits
 
       int numcells = 0;
-      for (map<std::string, PHG4CylinderCell *>::const_iterator mapiter = celllist.begin();mapiter != celllist.end() ; ++mapiter)
+      for (map<unsigned long long, PHG4CylinderCell *>::const_iterator mapiter = celllist.begin();mapiter != celllist.end() ; ++mapiter)
 	{	  
 	  cells->AddCylinderCell(*layer, mapiter->second);
 	  numcells++;
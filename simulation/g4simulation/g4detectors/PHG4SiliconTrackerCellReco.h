@@ -61,7 +61,7 @@ class PHG4SiliconTrackerCellReco : public SubsysReco
   int chkenergyconservation;
   int layer;
   //std::map<unsigned int, PHG4CylinderCell *> celllist;
-  std::map<std::string, PHG4CylinderCell*> celllist;  // This map holds the hit cells
+  std::map<unsigned long long, PHG4CylinderCell*> celllist;  // This map holds the hit cells
 
   double tmin_default;
   double tmax_default;
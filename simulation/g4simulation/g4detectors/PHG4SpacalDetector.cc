@@ -96,6 +96,26 @@ PHG4SpacalDetector::IsInCylinderActive(const G4VPhysicalVolume * volume)
   return INACTIVE;
 }
 
+void
+PHG4SpacalDetector::GetActiveVolumes(std::set<const G4VPhysicalVolume*> &volumes) const
+{
+  std::map<const G4VPhysicalVolume*, int>::const_iterator iter;
+  if (active)
+    {
+      for (iter = fiber_core_vol.begin(); iter != fiber_core_vol.end(); ++iter)
+        volumes.insert(iter->first);
+    }
+  if (absorberactive)
+    {
+      for (iter = fiber_vol.begin(); iter != fiber_vol.end(); ++iter)
+        volumes.insert(iter->first);
+      for (iter = block_vol.begin(); iter != block_vol.end(); ++iter)
+        volumes.insert(iter->first);
+      for (iter = calo_vol.begin(); iter != calo_vol.end(); ++iter)
+        volumes.insert(iter->first);
+    }
+}
+
 //_______________________________________________________________
 void
 PHG4SpacalDetector::Construct(G4LogicalVolume* logicWorld)
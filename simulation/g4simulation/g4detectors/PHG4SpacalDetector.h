@@ -74,6 +74,10 @@ public:
   int
   IsInCylinderActive(const G4VPhysicalVolume*);
 
+  //! all volumes for which IsInCylinderActive can return something else than INACTIVE
+  void
+  GetActiveVolumes(std::set<const G4VPhysicalVolume*> &volumes) const;
+
   void
   SuperDetector(const std::string& name)
   {
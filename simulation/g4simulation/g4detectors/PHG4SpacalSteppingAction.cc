@@ -11,7 +11,7 @@
 #include "PHG4CylinderGeom_Spacalv3.h"
 
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitDefs.h>
 #include <g4main/PHG4Shower.h>
 
@@ -133,8 +133,17 @@ PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 	  // flush out previous hit
 	  save_previous_g4hit();
           save_layer_id = layer_id;
+        // the container we want to add this hit to
+        if (isactive == PHG4SpacalDetector::FIBER_CORE) // the slat ids start with zero
+          {
+	    savehitcontainer = hits_;	    
+          }
+        else
+          {
+            savehitcontainer = absorberhits_;
+          }
 
-        hit = new PHG4Hitv1();
+        hit = savehitcontainer->NewHit();
 
         hit->set_layer((unsigned int) layer_id);
         hit->set_scint_id(scint_id); // isactive contains the scintillator slat id
@@ -155,15 +164,6 @@ PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
             hit->set_light_yield(0);
           }
         //	  hit->print();
-        // Now add the hit
-        if (isactive == PHG4SpacalDetector::FIBER_CORE) // the slat ids start with zero
-          {
-	    savehitcontainer = hits_;	    
-          }
-        else
-          {
-            savehitcontainer = absorberhits_;
-          }
 	if ( G4VUserTrackInformation* p = aTrack->GetUserInformation() )
 	  {
 	    if ( PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p) )
@@ -259,6 +259,15 @@ PHG4SpacalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     }
 }
 
+//____________________________________________________________________________..
+bool
+PHG4SpacalSteppingAction::GetVolumes(std::set<const G4VPhysicalVolume *> &volumes) const
+{
+  // neither active nor absorberactive leaves the list empty, no step is of interest then
+  detector_->GetActiveVolumes(volumes);
+  return true;
+}
+
 //____________________________________________________________________________..
 void
 PHG4SpacalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
@@ -340,7 +349,7 @@ PHG4SpacalSteppingAction::save_previous_g4hit()
     }
   else
     {
-      delete hit;
+      savehitcontainer->RecycleHit(hit);
     }
   hit = NULL;
   return;
@@ -40,6 +40,10 @@ public:
   virtual void
   SetInterfacePointers(PHCompositeNode*);
 
+  //! reimplemented from base class, only steps in our active volumes are of interest
+  virtual bool
+  GetVolumes(std::set<const G4VPhysicalVolume *> &volumes) const;
+
   double
   get_zmin();
 
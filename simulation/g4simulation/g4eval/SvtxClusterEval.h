@@ -64,6 +64,7 @@ private:
 
   void get_node_pointers(PHCompositeNode* topNode);
   bool has_node_pointers();
+  void fill_reverse_index();
   
   SvtxHitEval _hiteval;
   SvtxClusterMap* _clustermap;
@@ -84,6 +85,12 @@ private:
   std::map<PHG4Hit*,SvtxCluster* >                      _cache_best_cluster_from_g4hit;
   std::map<std::pair<SvtxCluster*,PHG4Particle*>,float> _cache_get_energy_contribution_g4particle;
   std::map<std::pair<SvtxCluster*,PHG4Hit*>,float>      _cache_get_energy_contribution_g4hit;
+
+  // truth -> reco index, filled by a single pass over the cluster map
+  // on the first forward query of an event
+  bool                                                                            _index_filled;
+  std::map<int,std::set<SvtxCluster*> >                                           _index_clusters_from_trkid;
+  std::map<std::pair<unsigned int,PHG4HitDefs::keytype>,std::set<SvtxCluster*> > _index_clusters_from_g4hit;
 };
 
 #endif // __SVTXCLUSTEREVAL_H__
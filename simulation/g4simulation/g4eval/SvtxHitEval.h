@@ -66,6 +66,7 @@ private:
 
   void get_node_pointers(PHCompositeNode *topNode);
   bool has_node_pointers();
+  void fill_reverse_index();
 
   SvtxTruthEval _trutheval;
   SvtxHitMap* _hitmap;
@@ -89,6 +90,12 @@ private:
   std::map<PHG4Hit*,SvtxHit*>                       _cache_best_hit_from_g4hit;
   std::map<std::pair<SvtxHit*,PHG4Particle*>,float> _cache_get_energy_contribution_g4particle;
   std::map<std::pair<SvtxHit*,PHG4Hit*>,float>      _cache_get_energy_contribution_g4hit;
+
+  // truth -> reco index, filled by a single pass over the hit map
+  // on the first forward query of an event
+  bool                                                                        _index_filled;
+  std::map<int,std::set<SvtxHit*> >                                           _index_hits_from_trkid;
+  std::map<std::pair<unsigned int,PHG4HitDefs::keytype>,std::set<SvtxHit*> > _index_hits_from_g4hit;
 };
 
 #endif // __SVTXHITEVAL_H__
@@ -66,6 +66,7 @@ private:
 
   void get_node_pointers(PHCompositeNode* topNode);
   bool has_node_pointers();
+  void fill_reverse_index();
   
   SvtxClusterEval _clustereval;
   SvtxTrackMap* _trackmap;
@@ -86,6 +87,13 @@ private:
   std::map<SvtxCluster*,SvtxTrack*>                           _cache_best_track_from_cluster;
   std::map<std::pair<SvtxTrack*,PHG4Particle*>, unsigned int> _cache_get_nclusters_contribution;
   std::map<std::pair<SvtxTrack*,PHG4Particle*>, unsigned int> _cache_get_nclusters_contribution_by_layer;
+
+  // truth/cluster -> track index, filled by a single pass over the
+  // track map on the first forward query of an event
+  bool                                                        _index_filled;
+  std::map<int,std::set<SvtxTrack*> >                         _index_tracks_from_particle_trkid;
+  std::map<int,std::set<SvtxTrack*> >                         _index_tracks_from_g4hit_trkid;
+  std::map<unsigned int,std::set<SvtxTrack*> >                _index_tracks_from_cluster;
 };
 
 #endif // __SVTXTRACKEVAL_H__
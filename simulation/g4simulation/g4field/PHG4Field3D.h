@@ -31,11 +31,6 @@
 #include <TNtuple.h>
 
 
-#ifndef __CINT__
-#include <boost/tuple/tuple.hpp>
-#include <boost/tuple/tuple_comparison.hpp>
-#endif // __CINT__
-
 #include <map> 
 #include <string>
 #include <vector>
@@ -44,36 +39,66 @@
 
 class PHG4Field3D : public G4MagneticField
 {
-  typedef boost::tuple<float,float,float> trio;
-  
  public:
   
+  //! the map is read from the ntuple "map" in filename. A binary copy of the
+  //! grid is kept in filename + ".cache" (if the directory is writable) which is
+  //! memory mapped instead of reading the ntuple when the root file did not change
   PHG4Field3D(const std::string  &filename, int verb=0, const float magfield_rescale = 1.0);
-  virtual ~PHG4Field3D() {}
+  virtual ~PHG4Field3D();
   
   void GetFieldValue( const double Point[4],    double *Bfield ) const;
   void GetFieldCyl  ( const double CylPoint[4], double *Bfield ) const;
   
  protected:
   
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector< std::vector< std::vector<float> > > BFieldZ_; 
-  std::vector< std::vector< std::vector<float> > > BFieldR_;
-  std::vector< std::vector< std::vector<float> > > BFieldPHI_;
-  
-  // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float>   z_map_;   // < i > 
-  std::vector<float>   r_map_;   // < j > 
-  std::vector<float>   phi_map_; // < k > 
+  //! one field map entry from the ntuple
+  struct MapEntry
+  {
+    float z, r, phi;
+    float bz, br, bphi;
+  };
+
+  //! grid node values of one axis, with the step size if the nodes are equidistant
+  struct Axis
+  {
+    std::vector<float> nodes;
+    bool uniform;
+    float invstep;
+    void SetNodes(const std::vector<float> &n);
+    //! lower node index for val, returns false if val is outside [first, last).
+    //! index is checked first (last cell used) before the bin is calculated
+    bool FindBin(const float val, unsigned int &index) const;
+  };
+
+  bool ReadNtuple(const std::string &filename);
+  bool ReadCache(const std::string &cachename, const std::string &filename);
+  void WriteCache(const std::string &cachename, const std::string &filename) const;
+
+  //! field in G4 units at node (iz, ir, iphi) is at
+  //! field_[3*((iz*nr + ir)*nphi + iphi)] in the order Bz, Br, Bphi
+  const float *field_;
+  std::vector<float> field_storage_; // used when the map was read from the ntuple
+  void *mapped_; // used when the map is memory mapped from the cache file
+  size_t mapped_size_;
+
+  Axis z_axis_;   // < i > 
+  Axis r_axis_;   // < j > 
+  Axis phi_axis_; // < k > 
   
   float maxz_, minz_;    // boundaries of magnetic field map cyl
+  float rescale_;
   unsigned verb_;
 
  private:
 
-  bool bin_search( const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index ) const;
-  void print_map( std::map<trio,trio>::iterator& it ) const;
+  void print_map( const MapEntry &entry ) const;
 
+  // the last cell used, consecutive G4 steps are mostly in the same cell
+  // (mutable since GetFieldValue is const, see PHG4Field2D)
+  mutable unsigned int z_index_cache;
+  mutable unsigned int r_index_cache;
+  mutable unsigned int phi_index_cache;
 };
 
 #endif // __CINT__
@@ -63,11 +63,6 @@ private:
 		       const PHG4CylinderCell*);
   static bool ladder_lessthan(const PHG4CylinderCell*, 
 			      const PHG4CylinderCell*);
-  bool are_adjacent(const PHG4CylinderCell*, 
-		    const PHG4CylinderCell*, 
-		    const int &);
-  bool ladder_are_adjacent(const PHG4CylinderCell*, 
-			   const PHG4CylinderCell*);
   
   void CalculateCylinderThresholds(PHCompositeNode *topNode);
   void CalculateLadderThresholds(PHCompositeNode *topNode);
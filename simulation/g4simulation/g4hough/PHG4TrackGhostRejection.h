@@ -40,7 +40,8 @@ class PHG4TrackCandidate
 /// This module runs after the pattern recognition to remove
 /// track candidates with a user defined overlap. The steps are:
 /// (1) Sort the hits on each track by index
-/// (2) Fill a multi-map between a track and all of the overlapping tracks
+/// (2) Build a cluster -> tracks index and count the shared clusters
+///     only for the tracks which have at least one cluster in common
 /// (3) Keep only the best track from the set of overlapping tracks
 ///
 class PHG4TrackGhostRejection : public SubsysReco
@@ -71,7 +72,12 @@ class PHG4TrackGhostRejection : public SubsysReco
   unsigned int _max_shared_hits;
   std::vector<bool> _layer_enabled;
 
-  std::multimap< unsigned int, unsigned int > _overlapping;
+  // (cluster id, candidate index) sorted by cluster id
+  std::vector< std::pair<unsigned int, unsigned int> > _cluster_tracks;
+  // shared clusters with the current candidate, by candidate index
+  std::vector<unsigned int> _nshared;
+  // overlapping candidate pairs (i,j) with i < j, ordered by i then j
+  std::vector< std::pair<unsigned int, unsigned int> > _overlapping;
 
 };
 
@@ -35,6 +35,7 @@ class SvtxClusterMap;
 class SvtxEvalStack;
 class TFile;
 class TTree;
+class TH1D;
 
 //! \brief Helper class for using RAVE vertex finder.
 class PHRaveVertexFactory;
@@ -128,6 +129,15 @@ public:
 		_vertexing_method = vertexingMethod;
 	}
 
+	//! Tracks whose refit takes longer than this (ms) are printed, 0 disables
+	double get_slow_track_threshold() const {
+		return _slow_track_threshold;
+	}
+
+	void set_slow_track_threshold(double threshold) {
+		_slow_track_threshold = threshold;
+	}
+
 private:
 
 	//! Event counter
@@ -189,6 +199,12 @@ private:
 	TClonesArray* _tca_trackmap_refit;
 	TClonesArray* _tca_vertexmap_refit;
 
+	//! refit time per track in ms, written with the eval tree
+	TH1D* _h_refit_time;
+
+	//! report tracks with a refit time above this (ms)
+	double _slow_track_threshold;
+
 	bool _do_evt_display;
 
 };
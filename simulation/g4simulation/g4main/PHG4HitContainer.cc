@@ -1,6 +1,7 @@
 #include "PHG4HitContainer.h"
 #include "PHG4Hit.h"
 #include "PHG4Hitv1.h"
+#include "PHG4Hitv2.h"
 
 #include <phool/phool.h>
 #include <cstdlib>
@@ -17,17 +18,58 @@ PHG4HitContainer::PHG4HitContainer(std::string nodename)
 {
 }
 
+PHG4HitContainer::~PHG4HitContainer()
+{
+  Reset();
+  while (!hitpool.empty())
+    {
+      delete hitpool.back();
+      hitpool.pop_back();
+    }
+}
+
 void
 PHG4HitContainer::Reset()
 {
-   while(hitmap.begin() != hitmap.end())
-     {
-       delete hitmap.begin()->second;
-       hitmap.erase(hitmap.begin());
-     }
+  for (Iterator iter = hitmap.begin(); iter != hitmap.end(); ++iter)
+    {
+      RecycleHit(iter->second);
+    }
+  hitmap.clear();
+  layermaxkey.clear();
+  return;
+}
+
+void
+PHG4HitContainer::RecycleHit(PHG4Hit *hit)
+{
+  // our own hits go back into the pool, everything else
+  // (e.g. hits read back from a DST) is deleted
+  PHG4Hitv2 *hitv2 = dynamic_cast<PHG4Hitv2 *> (hit);
+  if (hitv2)
+    {
+      hitv2->Reset();
+      hitpool.push_back(hitv2);
+    }
+  else
+    {
+      delete hit;
+    }
   return;
 }
 
+PHG4Hit *
+PHG4HitContainer::NewHit()
+{
+  if (hitpool.empty())
+    {
+      return new PHG4Hitv2();
+    }
+  PHG4Hit *hit = hitpool.back();
+  hitpool.pop_back();
+  return hit;
+}
+
 void
 PHG4HitContainer::identify(ostream& os) const
 {
@@ -83,23 +125,39 @@ PHG4HitContainer::genkey(const unsigned int detid)
   PHG4HitDefs::keytype shiftval = detidlong << PHG4HitDefs::hit_idbits;
   //  cout << "max index: " << (detminmax->second)->first << endl;
   // after removing hits with no energy deposition, we have holes
-  // in our hit ranges. This construct will get us the last hit in
-  // a layer and return it's hit id. Adding 1 will put us at the end of this layer
-  PHG4HitDefs::keytype hitid = getmaxkey(detid);
-  hitid++;
-  PHG4HitDefs::keytype newkey = hitid | shiftval;
-  if (hitmap.find(newkey) != hitmap.end())
+  // in our hit ranges. getmaxkey will get us the last hit in
+  // a layer and return it's hit id. Adding 1 will put us at the end of this layer.
+  // The last id is remembered per layer so the map is searched only
+  // for the first hit of a layer in an event
+  map<unsigned int, PHG4HitDefs::keytype>::iterator maxkeyiter = layermaxkey.find(detid);
+  if (maxkeyiter == layermaxkey.end())
     {
-      cout << PHWHERE << " duplicate key: 0x" 
-           << hex << newkey << dec 
-	   << " for detector " << detid 
-	   << " hitmap.size: " << hitmap.size()
-	   << " hitid: " << hitid << " exiting now" << endl;
-            exit(1);
+      maxkeyiter = layermaxkey.insert(make_pair(detid, getmaxkey(detid))).first;
     }
+  PHG4HitDefs::keytype hitid = ++(maxkeyiter->second);
+  PHG4HitDefs::keytype newkey = hitid | shiftval;
   return newkey;
 }
 
+void
+PHG4HitContainer::UpdateMaxKey(const PHG4HitDefs::keytype key)
+{
+  PHG4HitDefs::keytype detidlong = key >> PHG4HitDefs::hit_idbits;
+  unsigned int detid = detidlong;
+  map<unsigned int, PHG4HitDefs::keytype>::iterator maxkeyiter = layermaxkey.find(detid);
+  // layers without entry are initialized from the hitmap when needed
+  if (maxkeyiter == layermaxkey.end())
+    {
+      return;
+    }
+  PHG4HitDefs::keytype hitid = key - (detidlong << PHG4HitDefs::hit_idbits);
+  if (hitid > maxkeyiter->second)
+    {
+      maxkeyiter->second = hitid;
+    }
+  return;
+}
+
 PHG4HitContainer::ConstIterator
 PHG4HitContainer::AddHit(PHG4Hit *newhit)
 {
@@ -112,8 +170,8 @@ PHG4HitContainer::AddHit(PHG4Hit *newhit)
   PHG4HitDefs::keytype detidlong = key >>  PHG4HitDefs::hit_idbits;
   unsigned int detid = detidlong;
   layers.insert(detid);
-  hitmap[key] = newhit;
-  return hitmap.find(key);
+  UpdateMaxKey(key);
+  return hitmap.insert(make_pair(key, newhit)).first;
 }
 
 PHG4HitContainer::ConstIterator
@@ -122,8 +180,17 @@ PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
   PHG4HitDefs::keytype key = genkey(detid);
   layers.insert(detid);
   newhit->set_hit_id(key);
-  hitmap[key] = newhit;
-  return hitmap.find(key);
+  pair<Iterator, bool> ret = hitmap.insert(make_pair(key, newhit));
+  if (!ret.second)
+    {
+      cout << PHWHERE << " duplicate key: 0x" 
+           << hex << key << dec 
+	   << " for detector " << detid 
+	   << " hitmap.size: " << hitmap.size()
+	   << " exiting now" << endl;
+      exit(1);
+    }
+  return ret.first;
 }
 
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid) const
@@ -151,12 +218,12 @@ PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype k
   PHG4HitContainer::Iterator it = hitmap.find(key);
   if(it == hitmap.end())
   {
-    hitmap[key] = new PHG4Hitv1();
-    it = hitmap.find(key);
+    it = hitmap.insert(make_pair(key, NewHit())).first;
     PHG4Hit* mhit = it->second;
     mhit->set_hit_id(key);
     mhit->set_edep(0.);
     layers.insert(mhit->get_layer()); // add layer to our set of layers
+    UpdateMaxKey(key);
   }
   return it;
 }
@@ -183,7 +250,7 @@ PHG4HitContainer::RemoveZeroEDep()
       PHG4Hit *hit = itr->second;
       if (hit->get_edep() == 0)
         {
-          delete hit;
+          RecycleHit(hit);
           hitmap.erase(itr++);
         }
       else
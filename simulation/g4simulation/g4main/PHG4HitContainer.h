@@ -7,6 +7,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 class PHG4Hit;
 
 class PHG4HitContainer: public PHObject
@@ -23,7 +24,7 @@ class PHG4HitContainer: public PHObject
   PHG4HitContainer(); //< used only by ROOT for DST readback
   PHG4HitContainer(std::string nodename);
 
-  virtual ~PHG4HitContainer() {}
+  virtual ~PHG4HitContainer();
 
   void Reset();
 
@@ -33,6 +34,14 @@ class PHG4HitContainer: public PHObject
   void SetID(int i) {id = i;}
   int GetID() const {return id;}
   
+  //! hit to be filled and handed to AddHit(), hits created this way
+  //! are recycled by Reset() instead of being deleted
+  PHG4Hit *NewHit();
+
+  //! give back a hit which was not added, it goes into the pool
+  //! if it came from NewHit() and is deleted otherwise
+  void RecycleHit(PHG4Hit *hit);
+
   ConstIterator AddHit(PHG4Hit *newhit);
 
   ConstIterator AddHit(const unsigned int detid, PHG4Hit *newhit);
@@ -60,10 +69,16 @@ class PHG4HitContainer: public PHObject
   PHG4HitDefs::keytype getmaxkey(const unsigned int detid);
 
  protected:
+  //! keep layermaxkey in sync with hits added under an explicit key
+  void UpdateMaxKey(const PHG4HitDefs::keytype key);
 
   int id; //< unique identifier from hash of node name. Defined following PHG4HitDefs::get_volume_id
   Map hitmap;
   std::set<unsigned int> layers; // layers is not reset since layers must not change event by event
+  //! last hit id handed out per layer, saves the map search in genkey
+  std::map<unsigned int, PHG4HitDefs::keytype> layermaxkey; //!
+  //! PHG4Hitv2 objects from previous events waiting to be reused by NewHit()
+  std::vector<PHG4Hit *> hitpool; //!
 
   ClassDef(PHG4HitContainer,1)
 };
@@ -7,6 +7,7 @@
 // first classes with streamers
 #pragma link C++ class PHG4Hit+;
 #pragma link C++ class PHG4Hitv1+;
+#pragma link C++ class PHG4Hitv2+;
 #pragma link C++ class PHG4HitEval+;
 #pragma link C++ class PHG4HitContainer+;
 #pragma link C++ class PHG4Shower+;
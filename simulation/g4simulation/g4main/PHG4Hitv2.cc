@@ -0,0 +1,370 @@
+#include "PHG4Hitv2.h"
+#include "PHG4HitDefs.h"
+
+#include <phool/phool.h>
+
+#include <cstdlib>
+
+using namespace std;
+
+ClassImp(PHG4Hitv2)
+
+PHG4Hitv2::PHG4Hitv2()
+{
+  Reset();
+}
+
+PHG4Hitv2::PHG4Hitv2(PHG4Hit const &g4hit)
+{
+  Reset();
+  Copy(g4hit);
+}
+
+void
+PHG4Hitv2::Reset()
+{
+  for (int i = 0; i<2;i++)
+    {
+      set_x(i,NAN);
+      set_y(i,NAN);
+      set_z(i,NAN);
+      set_t(i,NAN);
+    }
+  hitid = ULONG_LONG_MAX;
+  trackid = INT_MIN;
+  showerid = INT_MIN;
+  edep = NAN;
+  slot_mask = 0;
+  for (int i = 0; i < slot_MAX_NUMBER; i++)
+    {
+      slot_prop[i] = 0;
+    }
+  prop_map.clear();
+}
+
+void
+PHG4Hitv2::print() const {
+  std::cout<<"New Hitv2  0x"<< hex << hitid 
+	   << dec << "  on track "<<trackid<<" EDep "<<edep<<std::endl;
+  std::cout<<"Location: X "<<x[0]<<"/"<<x[1]<<"  Y "<<y[0]<<"/"<<y[1]<<"  Z "<<z[0]<<"/"<<z[1]<<std::endl;
+  std::cout<<"Time        "<<t[0]<<"/"<<t[1]<<std::endl;
+
+  for (unsigned char ic = 0; ic < UCHAR_MAX; ic++)
+    {
+      PROPERTY prop_id = static_cast<PROPERTY>(ic);
+      if (! has_property(prop_id))
+	{
+	  continue;
+	}
+      pair<const string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+      cout << "\t" << prop_id << ":\t" << property_info.first << " = \t";
+      switch(property_info.second)
+	{
+	case type_int:
+	  cout << get_property_int(prop_id);
+	  break;
+	case type_uint:
+	  cout << get_property_uint(prop_id);
+	  break;
+	case type_float:
+	  cout << get_property_float(prop_id);
+	  break;
+	default:
+	  cout << " unknown type ";
+	}
+      cout <<endl;
+    }
+}
+
+PHG4Hitv2::SLOT
+PHG4Hitv2::get_slot(const PROPERTY prop_id)
+{
+  switch (prop_id)
+    {
+    case prop_eion:
+      return slot_eion;
+    case prop_light_yield:
+      return slot_light_yield;
+    case prop_px_0:
+      return slot_px_0;
+    case prop_px_1:
+      return slot_px_1;
+    case prop_py_0:
+      return slot_py_0;
+    case prop_py_1:
+      return slot_py_1;
+    case prop_pz_0:
+      return slot_pz_0;
+    case prop_pz_1:
+      return slot_pz_1;
+    case prop_path_length:
+      return slot_path_length;
+    case prop_layer:
+      return slot_layer;
+    case prop_scint_id:
+      return slot_scint_id;
+    case prop_row:
+      return slot_row;
+    case prop_strip_z_index:
+      return slot_strip_z_index;
+    case prop_strip_y_index:
+      return slot_strip_y_index;
+    case prop_ladder_z_index:
+      return slot_ladder_z_index;
+    case prop_ladder_phi_index:
+      return slot_ladder_phi_index;
+    case prop_index_i:
+      return slot_index_i;
+    case prop_index_j:
+      return slot_index_j;
+    case prop_index_k:
+      return slot_index_k;
+    case prop_index_l:
+      return slot_index_l;
+    default:
+      return slot_none;
+    }
+}
+
+PHG4Hit::PROPERTY_TYPE
+PHG4Hitv2::get_type(const PROPERTY prop_id)
+{
+  switch (get_slot(prop_id))
+    {
+    case slot_eion:
+    case slot_light_yield:
+    case slot_px_0:
+    case slot_px_1:
+    case slot_py_0:
+    case slot_py_1:
+    case slot_pz_0:
+    case slot_pz_1:
+    case slot_path_length:
+      return type_float;
+    case slot_layer:
+      return type_uint;
+    case slot_none:
+      // not one of ours, ask the base class (slow but rare)
+      return get_property_info(prop_id).second;
+    default:
+      return type_int;
+    }
+}
+
+void
+PHG4Hitv2::wrong_type(const PROPERTY prop_id, const PROPERTY_TYPE prop_type)
+{
+  pair<const string,PROPERTY_TYPE> property_info = get_property_info(prop_id); 
+  cout << PHWHERE << " Property " << property_info.first << " with id "
+       << prop_id << " is of type " << get_property_type(property_info.second) 
+       << " not " << get_property_type(prop_type) << endl; 
+  exit(1);
+}
+
+bool
+PHG4Hitv2::has_property(const PROPERTY prop_id) const
+{
+  SLOT islot = get_slot(prop_id);
+  if (islot != slot_none)
+    {
+      return has_slot(islot);
+    }
+  prop_map_t::const_iterator i = prop_map.find(prop_id);
+  return i!=prop_map.end();
+}
+
+float
+PHG4Hitv2::get_property_float(const PROPERTY prop_id) const
+{
+  if (get_type(prop_id) != type_float)
+    {
+      wrong_type(prop_id, type_float);
+    }
+  if (!has_property(prop_id))
+    {
+      return NAN;
+    }
+  return u_property(get_property_nocheck(prop_id)).fdata;
+}
+
+int
+PHG4Hitv2::get_property_int(const PROPERTY prop_id) const
+{
+  if (get_type(prop_id) != type_int)
+    {
+      wrong_type(prop_id, type_int);
+    }
+  if (!has_property(prop_id))
+    {
+      return INT_MIN;
+    }
+  return u_property(get_property_nocheck(prop_id)).idata;
+}
+
+unsigned int
+PHG4Hitv2::get_property_uint(const PROPERTY prop_id) const
+{
+  if (get_type(prop_id) != type_uint)
+    {
+      wrong_type(prop_id, type_uint);
+    }
+  if (!has_property(prop_id))
+    {
+      return UINT_MAX;
+    }
+  return u_property(get_property_nocheck(prop_id)).uidata;
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop_id, const float value)
+{
+  if (get_type(prop_id) != type_float)
+    {
+      wrong_type(prop_id, type_float);
+    }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop_id, const int value)
+{
+  if (get_type(prop_id) != type_int)
+    {
+      wrong_type(prop_id, type_int);
+    }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+void
+PHG4Hitv2::set_property(const PROPERTY prop_id, const unsigned int value)
+{
+  if (get_type(prop_id) != type_uint)
+    {
+      wrong_type(prop_id, type_uint);
+    }
+  set_property_nocheck(prop_id, u_property(value).get_storage());
+}
+
+unsigned int
+PHG4Hitv2::get_property_nocheck(const PROPERTY prop_id) const
+{
+  SLOT islot = get_slot(prop_id);
+  if (islot != slot_none)
+    {
+      return has_slot(islot) ? slot_prop[islot] : UINT_MAX;
+    }
+  prop_map_t::const_iterator iter = prop_map.find(prop_id);
+  if (iter != prop_map.end())
+    {
+      return iter->second;
+    }
+  return UINT_MAX;
+}
+
+void
+PHG4Hitv2::set_property_nocheck(const PROPERTY prop_id, const unsigned int ui)
+{
+  SLOT islot = get_slot(prop_id);
+  if (islot != slot_none)
+    {
+      set_slot(islot, u_property(ui));
+      return;
+    }
+  prop_map[prop_id] = ui;
+}
+
+float
+PHG4Hitv2::get_px(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_slot_float(slot_px_0);
+    case 1:
+      return  get_slot_float(slot_px_1);
+    default:
+      cout << "Invalid index in get_px: " << i << endl;
+      exit(1);
+    }
+}
+
+float
+PHG4Hitv2::get_py(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_slot_float(slot_py_0);
+    case 1:
+      return  get_slot_float(slot_py_1);
+    default:
+      cout << "Invalid index in get_py: " << i << endl;
+      exit(1);
+    }
+}
+
+float
+PHG4Hitv2::get_pz(const int i) const
+{
+  switch(i)
+    {
+    case 0:
+      return  get_slot_float(slot_pz_0);
+    case 1:
+      return  get_slot_float(slot_pz_1);
+    default:
+      cout << "Invalid index in get_pz: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_px(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_slot(slot_px_0,u_property(f));
+      return;
+    case 1:
+      set_slot(slot_px_1,u_property(f));
+      return;
+    default:
+      cout << "Invalid index in set_px: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_py(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_slot(slot_py_0,u_property(f));
+      return;
+    case 1:
+      set_slot(slot_py_1,u_property(f));
+      return;
+    default:
+      cout << "Invalid index in set_py: " << i << endl;
+      exit(1);
+    }
+}
+
+void
+PHG4Hitv2::set_pz(const int i, const float f)
+{
+  switch(i)
+    {
+    case 0:
+      set_slot(slot_pz_0,u_property(f));
+      return;
+    case 1:
+      set_slot(slot_pz_1,u_property(f));
+      return;
+    default:
+      cout << "Invalid index in set_pz: " << i << endl;
+      exit(1);
+    }
+}
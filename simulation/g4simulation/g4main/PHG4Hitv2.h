@@ -0,0 +1,188 @@
+#ifndef PHG4Hitv2_H__
+#define PHG4Hitv2_H__
+
+#include "PHG4Hit.h"
+#include "PHG4HitDefs.h"
+
+#ifdef __CINT__
+#include <stdint.h>
+#else
+#include <cstdint>
+#endif
+#include <iostream>
+#include <map>
+
+// same content as PHG4Hitv1, but the properties which are filled by the
+// stepping actions live in fixed slots with a bit mask telling which ones
+// are set instead of a std::map (one allocation per property per hit).
+// Properties without a slot go into prop_map like in PHG4Hitv1.
+// Use PHG4HitContainer::NewHit() to get one, the container recycles
+// the hits of the previous event
+class PHG4Hitv2 : public PHG4Hit
+{
+ public:
+  PHG4Hitv2();
+  explicit PHG4Hitv2(const PHG4Hit &g4hit);
+  virtual ~PHG4Hitv2() {}
+
+  //! put the hit back into the state of a newly constructed one
+  void Reset();
+
+  // The indices here represent the entry and exit points of the particle
+  float get_x(const int i) const {return x[i];}
+  float get_y(const int i) const {return y[i];}
+  float get_z(const int i) const {return z[i];}
+  float get_t(const int i) const {return t[i];}
+  float get_edep() const {return edep;}
+  PHG4HitDefs::keytype get_hit_id() const {return hitid;}
+  int get_shower_id() const {return showerid;}
+  int get_trkid() const {return trackid;}
+  
+  void set_x(const int i, const float f) {x[i]=f;}
+  void set_y(const int i, const float f) {y[i]=f;}
+  void set_z(const int i, const float f) {z[i]=f;}
+  void set_t(const int i, const float f) {t[i]=f;}
+  void set_edep(const float f) {edep = f;}
+  void set_hit_id(const PHG4HitDefs::keytype i) {hitid=i;}
+  void set_shower_id(const int i) {showerid = i;}
+  void set_trkid(const int i) {trackid=i;}
+
+  virtual void print() const;
+
+  bool  has_property(const PROPERTY prop_id) const;
+  float get_property_float(const PROPERTY prop_id) const;
+  int   get_property_int(const PROPERTY prop_id) const;
+  unsigned int   get_property_uint(const PROPERTY prop_id) const;
+  void  set_property(const PROPERTY prop_id, const float value);
+  void  set_property(const PROPERTY prop_id, const int value);
+  void  set_property(const PROPERTY prop_id, const unsigned int value);
+
+  virtual float get_px(const int i) const;
+  virtual float get_py(const int i) const;
+  virtual float get_pz(const int i) const;
+  virtual float get_eion() const          {return  get_slot_float(slot_eion);}
+  virtual float get_light_yield() const   {return  get_slot_float(slot_light_yield);}
+  virtual float get_path_length() const {return  get_slot_float(slot_path_length);}
+  virtual unsigned int get_layer() const  {return  get_slot_uint(slot_layer);}
+  virtual int get_scint_id() const        {return  get_slot_int(slot_scint_id);}
+  virtual int get_row() const {return  get_slot_int(slot_row);}
+  virtual int get_strip_z_index() const   {return  get_slot_int(slot_strip_z_index);}
+  virtual int get_strip_y_index() const   {return  get_slot_int(slot_strip_y_index);}
+  virtual int get_ladder_z_index() const  {return  get_slot_int(slot_ladder_z_index);}
+  virtual int get_ladder_phi_index() const{return  get_slot_int(slot_ladder_phi_index);}
+  virtual int get_index_i() const {return  get_slot_int(slot_index_i);}
+  virtual int get_index_j() const {return  get_slot_int(slot_index_j);}
+  virtual int get_index_k() const {return  get_slot_int(slot_index_k);}
+  virtual int get_index_l() const {return  get_slot_int(slot_index_l);}
+
+  virtual void set_px(const int i, const float f);
+  virtual void set_py(const int i, const float f);
+  virtual void set_pz(const int i, const float f);
+  virtual void set_eion(const float f)            {set_slot(slot_eion,u_property(f));}
+  virtual void set_light_yield(const float f)           {set_slot(slot_light_yield,u_property(f));}
+  virtual void set_path_length(const float f)           {set_slot(slot_path_length,u_property(f));}
+  virtual void set_layer(const unsigned int i)    {set_slot(slot_layer,u_property(i));}
+  virtual void set_scint_id(const int i)          {set_slot(slot_scint_id,u_property(i));}
+  virtual void set_row(const int i)          {set_slot(slot_row,u_property(i));}
+  virtual void set_strip_z_index(const int i)     {set_slot(slot_strip_z_index,u_property(i));}
+  virtual void set_strip_y_index(const int i)     {set_slot(slot_strip_y_index,u_property(i));}
+  virtual void set_ladder_z_index(const int i)    {set_slot(slot_ladder_z_index,u_property(i));}
+  virtual void set_ladder_phi_index(const int i)  {set_slot(slot_ladder_phi_index,u_property(i));}
+  virtual void set_index_i(const int i)  {set_slot(slot_index_i,u_property(i));}
+  virtual void set_index_j(const int i)  {set_slot(slot_index_j,u_property(i));}
+  virtual void set_index_k(const int i)  {set_slot(slot_index_k,u_property(i));}
+  virtual void set_index_l(const int i)  {set_slot(slot_index_l,u_property(i));}
+
+ protected:
+  //! fixed slots for the properties set by our stepping actions
+  enum SLOT
+  {
+    slot_eion = 0,
+    slot_light_yield,
+    slot_px_0,
+    slot_px_1,
+    slot_py_0,
+    slot_py_1,
+    slot_pz_0,
+    slot_pz_1,
+    slot_path_length,
+    slot_layer,
+    slot_scint_id,
+    slot_row,
+    slot_strip_z_index,
+    slot_strip_y_index,
+    slot_ladder_z_index,
+    slot_ladder_phi_index,
+    slot_index_i,
+    slot_index_j,
+    slot_index_k,
+    slot_index_l,
+    slot_MAX_NUMBER,
+    slot_none = -1
+  };
+
+  //! slot for a given property, slot_none if it goes into prop_map
+  static SLOT get_slot(const PROPERTY prop_id);
+
+  //! same as check_property but without building the property name
+  static PROPERTY_TYPE get_type(const PROPERTY prop_id);
+  static void wrong_type(const PROPERTY prop_id, const PROPERTY_TYPE prop_type);
+
+  unsigned int get_property_nocheck(const PROPERTY prop_id) const;
+  void set_property_nocheck(const PROPERTY prop_id,const unsigned int ui);
+
+  //! storage types for additional property
+  typedef uint8_t prop_id_t;
+  typedef uint32_t prop_storage_t;
+  typedef std::map<prop_id_t, prop_storage_t> prop_map_t;
+
+  //! convert between 32bit inputs and storage type prop_storage_t
+  union u_property{
+    float fdata;
+    int32_t idata;
+    uint32_t uidata;
+
+    u_property(int32_t in): idata(in) {}
+    u_property(uint32_t in): uidata(in) {}
+    u_property(float in): fdata(in) {}
+    u_property(): uidata(0) {}
+
+    prop_storage_t get_storage() const {return uidata;}
+  };
+
+  bool has_slot(const SLOT islot) const {return (slot_mask >> islot) & 1;}
+  void set_slot(const SLOT islot, const u_property &value)
+  {
+    slot_prop[islot] = value.get_storage();
+    slot_mask |= (1U << islot);
+  }
+  float get_slot_float(const SLOT islot) const
+  {return has_slot(islot) ? u_property(slot_prop[islot]).fdata : NAN;}
+  int get_slot_int(const SLOT islot) const
+  {return has_slot(islot) ? u_property(slot_prop[islot]).idata : INT_MIN;}
+  unsigned int get_slot_uint(const SLOT islot) const
+  {return has_slot(islot) ? u_property(slot_prop[islot]).uidata : UINT_MAX;}
+
+  // Store both the entry and exit points of the particle
+  // Remember, particles do not always enter on the inner edge!
+  float x[2];
+  float y[2];
+  float z[2];
+  float t[2];
+  PHG4HitDefs::keytype hitid;
+  int trackid;
+  int showerid;
+  float edep;
+
+  //! bit i is set if slot_prop[i] holds a value
+  uint32_t slot_mask;
+  //! fixed slot storage, the dimension has to match slot_MAX_NUMBER
+  prop_storage_t slot_prop[20];
+
+  //! container for properties without a fixed slot
+  prop_map_t prop_map;
+
+  ClassDef(PHG4Hitv2,1)
+};
+
+#endif
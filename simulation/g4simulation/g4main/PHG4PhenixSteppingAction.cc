@@ -1,12 +1,71 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4SteppingAction.h"
 
+#include <Geant4/G4Step.hh>
+
+#include <map>
+#include <set>
+
+using namespace std;
+
+//_________________________________________________________________
+void PHG4PhenixSteppingAction::BuildVolumeMap()
+{
+  global_actions_.clear();
+  volume_actions_.clear();
+  // volumes of each action, actions which want to see every step are not in here
+  map<PHG4SteppingAction *, set<const G4VPhysicalVolume *> > action_volumes;
+  set<const G4VPhysicalVolume *> allvolumes;
+  for( ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter )
+  {
+    set<const G4VPhysicalVolume *> volumes;
+    if (!(*iter)->GetVolumes(volumes))
+    {
+      global_actions_.push_back(*iter);
+      continue;
+    }
+    // an action without volumes (e.g. nothing active) is never called
+    action_volumes[*iter] = volumes;
+    allvolumes.insert(volumes.begin(), volumes.end());
+  }
+  // every registered volume gets the global actions plus the ones
+  // which registered it, keeping the order in which the actions were added
+  // (the hit_was_used flag depends on it)
+  for( set<const G4VPhysicalVolume *>::const_iterator viter = allvolumes.begin(); viter != allvolumes.end(); ++viter )
+  {
+    ActionList &volactions = volume_actions_[*viter];
+    for( ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter )
+    {
+      map<PHG4SteppingAction *, set<const G4VPhysicalVolume *> >::const_iterator aiter = action_volumes.find(*iter);
+      if (aiter == action_volumes.end() || aiter->second.find(*viter) != aiter->second.end())
+      {
+	volactions.push_back(*iter);
+      }
+    }
+  }
+  volume_map_built = true;
+}
+
 //_________________________________________________________________
 void PHG4PhenixSteppingAction::UserSteppingAction( const G4Step* aStep )
 {
+  if (!volume_map_built)
+  {
+    BuildVolumeMap();
+  }
+  // pick the actions interested in the volume of this step
+  const ActionList *actions = &global_actions_;
+  if (!volume_actions_.empty())
+  {
+    VolumeMap::const_iterator viter = volume_actions_.find(aStep->GetPreStepPoint()->GetTouchableHandle()->GetVolume());
+    if (viter != volume_actions_.end())
+    {
+      actions = &viter->second;
+    }
+  }
   // loop over registered actions, and process
   bool hit_was_used = false;
-  for( ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter )
+  for( ActionList::const_iterator iter = actions->begin(); iter != actions->end(); ++iter )
   {
     if(*iter)
     {
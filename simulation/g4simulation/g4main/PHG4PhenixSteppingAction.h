@@ -2,9 +2,13 @@
 #define PHG4VUserSteppingAction_h
 
 #include <Geant4/G4UserSteppingAction.hh>
-#include <list>
+
+#include <boost/unordered_map.hpp>
+
+#include <vector>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHG4SteppingAction;
 class PHCompositeNode;
 
@@ -12,7 +16,8 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
 {
 
   public:
-  PHG4PhenixSteppingAction( void )
+  PHG4PhenixSteppingAction( void ):
+    volume_map_built(false)
   {}
 
   virtual ~PHG4PhenixSteppingAction()
@@ -24,17 +29,32 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
     if (action)
       {
 	actions_.push_back( action );
+	volume_map_built = false;
       }
   }
 
+  //! build the volume -> actions lookup from PHG4SteppingAction::GetVolumes
+  /*! needs the constructed geometry, PHG4Reco calls it after the G4 initialization.
+    If it was not called it is done on the first step */
+  void BuildVolumeMap();
+
   virtual void UserSteppingAction(const G4Step*);
 
   private:
 
   //! list of subsystem specific stepping actions
-  typedef std::list<PHG4SteppingAction*> ActionList;
+  typedef std::vector<PHG4SteppingAction*> ActionList;
   ActionList actions_;
 
+  //! actions whose GetVolumes returned false, they are called for every step
+  ActionList global_actions_;
+
+  //! actions to call for a registered volume (global ones included), in registration order
+  typedef boost::unordered_map<const G4VPhysicalVolume*, ActionList> VolumeMap;
+  VolumeMap volume_actions_;
+
+  bool volume_map_built;
+
 };
 
 
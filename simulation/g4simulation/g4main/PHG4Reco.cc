@@ -344,6 +344,9 @@ PHG4Reco::InitRun( PHCompositeNode* topNode )
   // initialize
   runManager_->Initialize();
 
+  // geometry exists now, the stepping actions can tell us their volumes
+  steppingAction_->BuildVolumeMap();
+
   // add cerenkov and optical photon processes
   // cout << endl << "Ignore the next message - we implemented this correctly" << endl;
   G4Cerenkov* theCerenkovProcess = new G4Cerenkov("Cerenkov");
@@ -6,6 +6,7 @@
 #include <string>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 
 class PHG4SteppingAction
@@ -40,6 +41,15 @@ class PHG4SteppingAction
 
   virtual void flush_cached_values() {return;}
 
+  //! physical volumes handled by this action
+  /*!
+  called once after the geometry is constructed. Actions which return true are
+  only called for steps inside the volumes they added (none if they added none),
+  actions which return false (the default) are called for every step and have
+  to check the volume themselves
+  */
+  virtual bool GetVolumes(std::set<const G4VPhysicalVolume *> &volumes) const {return false;}
+
   virtual void SetInterfacePointers( PHCompositeNode* ) {return;}
 
   void SetOpt(const std::string &name, const int i) {opt_int[name] = i;}
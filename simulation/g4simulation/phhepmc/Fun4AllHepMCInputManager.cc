@@ -1,4 +1,5 @@
 #include "Fun4AllHepMCInputManager.h"
+#include "PHHepMCBinaryFile.h"
 
 #include <fun4all/Fun4AllServer.h>
 #include <fun4all/Fun4AllSyncManager.h>
@@ -28,12 +29,15 @@
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace std;
 
-static boost::iostreams::filtering_streambuf<boost::iostreams::input> zinbuffer;
 static const double toMM = 1.e-12;
 
 Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const string &name, const string &nodename, const string &topnodename) :
@@ -46,9 +50,13 @@ Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const string &name, const str
   lengthunit(HepMC::Units::CM),
   topNodeName(topnodename),
   ascii_in(NULL),
+  binary_in(NULL),
+  binary_cache(NULL),
+  usebinarycache(0),
   evt(NULL),
   save_evt(NULL),
   filestream(NULL),
+  zinbuffer(NULL),
   unzipstream(NULL)
 {
   Fun4AllServer *se = Fun4AllServer::instance();
@@ -65,9 +73,12 @@ Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const string &name, const str
 Fun4AllHepMCInputManager::~Fun4AllHepMCInputManager()
 {
   fileclose();
+  CloseBinaryCache(0);
   delete ascii_in;
-  delete filestream;
+  delete binary_in;
   delete unzipstream;
+  delete zinbuffer;
+  delete filestream;
 }
 
 int
@@ -93,31 +104,72 @@ Fun4AllHepMCInputManager::fileopen(const string &filenam)
       cout << ThisName << ": opening file " << fname << endl;
     }
 
+  TString tstr(fname);
+  TPRegexp binary_ext(".bhepmc$");
   if (readoscar)
     {
       theOscarFile.open(fname.c_str());
     }
+  else if (tstr.Contains(binary_ext))
+    {
+      binary_in = new PHHepMCBinaryFile();
+      if (binary_in->open_read(fname))
+	{
+	  cout << PHWHERE << " could not open binary HepMC file " << fname << endl;
+	  delete binary_in;
+	  binary_in = NULL;
+	  return -1;
+	}
+    }
   else
     {
-      TString tstr(fname);
+      if (usebinarycache)
+	{
+	  // a cache older than the ASCII file is written again
+	  binarycachename = BinaryCacheName(fname);
+	  struct stat asciistat;
+	  struct stat cachestat;
+	  if (!stat(fname.c_str(), &asciistat) &&
+	      !stat(binarycachename.c_str(), &cachestat) &&
+	      cachestat.st_mtime >= asciistat.st_mtime)
+	    {
+	      binary_in = new PHHepMCBinaryFile();
+	      if (binary_in->open_read(binarycachename))
+		{
+		  delete binary_in;
+		  binary_in = NULL;
+		}
+	      else if (verbosity > 0)
+		{
+		  cout << ThisName << ": reading binary cache " << binarycachename << endl;
+		}
+	    }
+	}
+    }
+  if (!readoscar && !binary_in)
+    {
       TPRegexp bzip_ext(".bz2$");
       TPRegexp gzip_ext(".gz$");
       if (tstr.Contains(bzip_ext))
 	{
 	  // use boost iosteam library to decompress bz2 on the fly
 	  filestream = new ifstream(fname.c_str(), std::ios::in | std::ios::binary);
-	  zinbuffer.push(boost::iostreams::bzip2_decompressor());
-	  zinbuffer.push(*filestream);
-	  unzipstream = new istream(&zinbuffer);
+	  boost::iostreams::filtering_streambuf<boost::iostreams::input> *zbuf = new boost::iostreams::filtering_streambuf<boost::iostreams::input>();
+	  zbuf->push(boost::iostreams::bzip2_decompressor());
+	  zbuf->push(*filestream);
+	  zinbuffer = zbuf;
+	  unzipstream = new istream(zinbuffer);
 	  ascii_in = new HepMC::IO_GenEvent(*unzipstream);
 	}
       else if (tstr.Contains(gzip_ext))
 	{
 	  // use boost iosream to decompress the gzip file on the fly
 	  filestream = new ifstream(fname.c_str(), std::ios::in | std::ios::binary);
-	  zinbuffer.push(boost::iostreams::gzip_decompressor());
-	  zinbuffer.push(*filestream);
-	  unzipstream = new istream(&zinbuffer);
+	  boost::iostreams::filtering_streambuf<boost::iostreams::input> *zbuf = new boost::iostreams::filtering_streambuf<boost::iostreams::input>();
+	  zbuf->push(boost::iostreams::gzip_decompressor());
+	  zbuf->push(*filestream);
+	  zinbuffer = zbuf;
+	  unzipstream = new istream(zinbuffer);
 	  ascii_in = new HepMC::IO_GenEvent(*unzipstream);
 
 	}
@@ -126,6 +178,25 @@ Fun4AllHepMCInputManager::fileopen(const string &filenam)
 	  // expects normal ascii hepmc file
 	  ascii_in = new HepMC::IO_GenEvent(fname, std::ios::in);
 	}
+      if (usebinarycache)
+	{
+	  // written under a temporary name and renamed once the whole
+	  // ASCII file was read, so other jobs never see a partial cache
+	  ostringstream tmpname;
+	  tmpname << binarycachename << "." << getpid() << ".tmp";
+	  binarycachetmpname = tmpname.str();
+	  binary_cache = new PHHepMCBinaryFile();
+	  if (binary_cache->open_write(binarycachetmpname))
+	    {
+	      cout << ThisName << ": running without binary cache" << endl;
+	      delete binary_cache;
+	      binary_cache = NULL;
+	    }
+	  else if (verbosity > 0)
+	    {
+	      cout << ThisName << ": writing binary cache " << binarycachename << endl;
+	    }
+	}
     }
 
   recoConsts *rc = recoConsts::instance();
@@ -183,15 +254,30 @@ Fun4AllHepMCInputManager::run(const int nevents)
 	{
 	  evt = ConvertFromOscar();
 	}
+      else if (binary_in)
+	{
+	  evt = binary_in->read_next_event();
+	}
       else
 	{
 	  evt = ascii_in->read_next_event();
+	  if (binary_cache)
+	    {
+	      if (evt)
+		{
+		  binary_cache->write_event(evt);
+		}
+	      else
+		{
+		  CloseBinaryCache(ascii_in->rdstate() & ios::eofbit);
+		}
+	    }
 	}
     }
   genevent->addEvent(evt);
   if (!evt)
     {
-      if (verbosity > 1)
+      if (verbosity > 1 && ascii_in)
 	{
 	  cout << "error type: " << ascii_in->error_type()
 	       << ", rdstate: " << ascii_in->rdstate() << endl;
@@ -232,8 +318,18 @@ Fun4AllHepMCInputManager::fileclose()
     }
   else
     {
+      // a cache which did not see the end of the file is dropped
+      CloseBinaryCache(0);
       delete ascii_in;
       ascii_in = NULL;
+      delete binary_in;
+      binary_in = NULL;
+      delete unzipstream;
+      unzipstream = NULL;
+      delete zinbuffer;
+      zinbuffer = NULL;
+      delete filestream;
+      filestream = NULL;
     }
   isopen = 0;
   // if we have a file list, move next entry to top of the list
@@ -320,6 +416,18 @@ Fun4AllHepMCInputManager::PushBackEvents(const int i)
   // the skipping of events we read -i events.
   int nevents = -i; // negative number of events to push back -> skip num events
   int errorflag = 0;
+  if (binary_in)
+    {
+      // the binary file knows where each event starts
+      if (binary_in->seek(binary_in->current() + nevents))
+	{
+	  cout << "Error skipping " << nevents << " events, only "
+	       << binary_in->entries() - binary_in->current() << " left" << endl;
+	  errorflag = -1;
+	  fileclose();
+	}
+      return errorflag;
+    }
   while (nevents > 0 && ! errorflag)
     {
       evt = ascii_in->read_next_event();
@@ -329,8 +437,13 @@ Fun4AllHepMCInputManager::PushBackEvents(const int i)
 	  cout << "error type: " << ascii_in->error_type()
 	       << ", rdstate: " << ascii_in->rdstate() << endl;
 	  errorflag = -1;
+	  CloseBinaryCache(ascii_in->rdstate() & ios::eofbit);
 	  fileclose();
 	}
+      else if (binary_cache)
+	{
+	  binary_cache->write_event(evt);
+	}
       else
 	{
 	  if (verbosity > 3)
@@ -344,6 +457,65 @@ Fun4AllHepMCInputManager::PushBackEvents(const int i)
   return errorflag;
 }
 
+int
+Fun4AllHepMCInputManager::SeekEvent(const int i)
+{
+  if (!binary_in)
+    {
+      cout << PHWHERE << ThisName
+	   << " random access needs a binary HepMC file or cache" << endl;
+      return -1;
+    }
+  if (i < 0 || binary_in->seek(i))
+    {
+      cout << PHWHERE << ThisName << " cannot go to event " << i
+	   << ", file has " << binary_in->entries() << " events" << endl;
+      return -1;
+    }
+  save_evt = NULL;
+  return 0;
+}
+
+string
+Fun4AllHepMCInputManager::BinaryCacheName(const string &fname) const
+{
+  if (binarycachedir.empty())
+    {
+      return fname + ".bhepmc";
+    }
+  string basename = fname;
+  size_t pos = basename.rfind('/');
+  if (pos != string::npos)
+    {
+      basename = basename.substr(pos + 1);
+    }
+  return binarycachedir + "/" + basename + ".bhepmc";
+}
+
+void
+Fun4AllHepMCInputManager::CloseBinaryCache(const int complete)
+{
+  if (!binary_cache)
+    {
+      return;
+    }
+  if (complete && !binary_cache->close() &&
+      !rename(binarycachetmpname.c_str(), binarycachename.c_str()))
+    {
+      if (verbosity > 0)
+	{
+	  cout << ThisName << ": wrote binary cache " << binarycachename << endl;
+	}
+    }
+  else
+    {
+      binary_cache->close();
+      unlink(binarycachetmpname.c_str());
+    }
+  delete binary_cache;
+  binary_cache = NULL;
+}
+
 HepMC::GenEvent *
 Fun4AllHepMCInputManager::ConvertFromOscar()
 {
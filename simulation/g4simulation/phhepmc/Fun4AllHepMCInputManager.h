@@ -17,6 +17,7 @@ namespace HepMC
 };
 
 class PHCompositeNode;
+class PHHepMCBinaryFile;
 
 class Fun4AllHepMCInputManager : public Fun4AllInputManager
 {
@@ -33,6 +34,15 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   void Print(const std::string &what = "ALL") const;
   int PushBackEvents(const int i);
 
+  // keep a binary copy of the ASCII input (<file>.bhepmc, in the directory
+  // of the input file or in dir) which is read instead of the ASCII file
+  // next time. Files ending in .bhepmc are always read as binary
+  void UseBinaryCache(const int i = 1) {usebinarycache = i;}
+  void BinaryCacheDir(const std::string &dir) {binarycachedir = dir;}
+  // random access, only for binary input. The next event read is event i
+  // of the current file
+  int SeekEvent(const int i);
+
   // Effectivly turn off the synchronization checking
   //
   int SyncIt(const SyncObject* /*mastersync*/) {return Fun4AllReturnCodes::SYNC_OK;}
@@ -42,6 +52,8 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
 
  protected:
   int OpenNextFile();
+  std::string BinaryCacheName(const std::string &fname) const;
+  void CloseBinaryCache(const int complete);
   int isopen;
   int events_total;
   int events_thisfile;
@@ -52,11 +64,18 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager
   std::string topNodeName;
   PHCompositeNode *topNode;
   HepMC::IO_GenEvent *ascii_in;
+  PHHepMCBinaryFile *binary_in;
+  PHHepMCBinaryFile *binary_cache;
+  int usebinarycache;
+  std::string binarycachedir;
+  std::string binarycachename;
+  std::string binarycachetmpname;
   HepMC::GenEvent *evt;
   HepMC::GenEvent *save_evt;
 
   // some pointers for use in decompression handling
   std::ifstream *filestream; // holds compressed filestream
+  std::streambuf *zinbuffer; // decompressing stream buffer
   std::istream *unzipstream; // feed into HepMc
   std::ifstream theOscarFile;
 };
@@ -0,0 +1,540 @@
+#include "PHHepMCBinaryFile.h"
+
+#include <phool/phool.h>
+
+#include <HepMC/GenEvent.h>
+#include <HepMC/GenVertex.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/HeavyIon.h>
+#include <HepMC/PdfInfo.h>
+#include <HepMC/GenCrossSection.h>
+#include <HepMC/WeightContainer.h>
+
+#include <iostream>
+#include <map>
+
+using namespace std;
+
+static const unsigned int MAGIC = 0x424d4348; // "HCMB" in the file
+static const unsigned int VERSION = 1;
+
+// the file ends with: offsets[nevents], nevents, start of offsets, MAGIC
+static const long TRAILERLENGTH = 2 * sizeof(unsigned long long) + sizeof(unsigned int);
+
+PHHepMCBinaryFile::PHHepMCBinaryFile():
+  fp(NULL),
+  writing(0),
+  next_event(0)
+{}
+
+PHHepMCBinaryFile::~PHHepMCBinaryFile()
+{
+  close();
+}
+
+int
+PHHepMCBinaryFile::open_write(const string &name)
+{
+  close();
+  fp = fopen(name.c_str(), "wb");
+  if (!fp)
+    {
+      cout << PHWHERE << " could not open " << name << " for writing" << endl;
+      return -1;
+    }
+  unsigned int header[2] = {MAGIC, VERSION};
+  if (fwrite(header, sizeof(header), 1, fp) != 1)
+    {
+      cout << PHWHERE << " could not write header to " << name << endl;
+      fclose(fp);
+      fp = NULL;
+      return -1;
+    }
+  writing = 1;
+  next_event = 0;
+  offsets.clear();
+  return 0;
+}
+
+int
+PHHepMCBinaryFile::open_read(const string &name)
+{
+  close();
+  fp = fopen(name.c_str(), "rb");
+  if (!fp)
+    {
+      return -1;
+    }
+  unsigned int header[2];
+  if (fread(header, sizeof(header), 1, fp) != 1 || header[0] != MAGIC || header[1] != VERSION)
+    {
+      cout << PHWHERE << " " << name << " is not a binary HepMC file of version " << VERSION << endl;
+      fclose(fp);
+      fp = NULL;
+      return -1;
+    }
+  writing = 0;
+  if (read_index())
+    {
+      cout << PHWHERE << " " << name << " has no valid event index" << endl;
+      fclose(fp);
+      fp = NULL;
+      return -1;
+    }
+  return seek(0);
+}
+
+int
+PHHepMCBinaryFile::read_index()
+{
+  offsets.clear();
+  if (fseeko(fp, -TRAILERLENGTH, SEEK_END))
+    {
+      return -1;
+    }
+  unsigned long long nevents;
+  unsigned long long indexstart;
+  unsigned int magic;
+  if (fread(&nevents, sizeof(nevents), 1, fp) != 1 ||
+      fread(&indexstart, sizeof(indexstart), 1, fp) != 1 ||
+      fread(&magic, sizeof(magic), 1, fp) != 1 ||
+      magic != MAGIC)
+    {
+      return -1;
+    }
+  offsets.resize(nevents);
+  if (fseeko(fp, indexstart, SEEK_SET))
+    {
+      return -1;
+    }
+  if (nevents > 0 && fread(&offsets[0], sizeof(unsigned long long), nevents, fp) != nevents)
+    {
+      offsets.clear();
+      return -1;
+    }
+  return 0;
+}
+
+int
+PHHepMCBinaryFile::close()
+{
+  if (!fp)
+    {
+      return 0;
+    }
+  int iret = 0;
+  if (writing)
+    {
+      unsigned long long indexstart = ftello(fp);
+      unsigned long long nevents = offsets.size();
+      if ((nevents > 0 && fwrite(&offsets[0], sizeof(unsigned long long), nevents, fp) != nevents) ||
+	  fwrite(&nevents, sizeof(nevents), 1, fp) != 1 ||
+	  fwrite(&indexstart, sizeof(indexstart), 1, fp) != 1 ||
+	  fwrite(&MAGIC, sizeof(MAGIC), 1, fp) != 1)
+	{
+	  cout << PHWHERE << " could not write event index" << endl;
+	  iret = -1;
+	}
+    }
+  if (fclose(fp))
+    {
+      iret = -1;
+    }
+  fp = NULL;
+  writing = 0;
+  next_event = 0;
+  offsets.clear();
+  return iret;
+}
+
+int
+PHHepMCBinaryFile::is_valid(const string &name)
+{
+  PHHepMCBinaryFile testfile;
+  FILE *f = fopen(name.c_str(), "rb");
+  if (!f)
+    {
+      return 0;
+    }
+  unsigned int header[2];
+  int valid = (fread(header, sizeof(header), 1, f) == 1 && header[0] == MAGIC && header[1] == VERSION);
+  testfile.fp = f;
+  if (valid)
+    {
+      valid = !testfile.read_index();
+    }
+  testfile.close();
+  return valid;
+}
+
+int
+PHHepMCBinaryFile::write_event(const HepMC::GenEvent *evt)
+{
+  if (!fp || !writing || !evt)
+    {
+      return -1;
+    }
+
+  EventRecord rec;
+  rec.event_number = evt->event_number();
+  rec.signal_process_id = evt->signal_process_id();
+  rec.mpi = evt->mpi();
+  rec.signal_process_vertex = -1;
+  rec.beam1 = -1;
+  rec.beam2 = -1;
+  rec.momentum_unit = evt->momentum_unit();
+  rec.length_unit = evt->length_unit();
+  rec.spare = 0;
+  rec.event_scale = evt->event_scale();
+  rec.alphaQCD = evt->alphaQCD();
+  rec.alphaQED = evt->alphaQED();
+
+  // vertices and particles are referenced by their position in the arrays
+  map<const HepMC::GenVertex *, int> vertexindex;
+  vertices.clear();
+  vertexweights.clear();
+  for (HepMC::GenEvent::vertex_const_iterator v = evt->vertices_begin(); v != evt->vertices_end(); ++v)
+    {
+      vertexindex[*v] = vertices.size();
+      VertexRecord vr;
+      vr.x = (*v)->position().x();
+      vr.y = (*v)->position().y();
+      vr.z = (*v)->position().z();
+      vr.t = (*v)->position().t();
+      vr.barcode = (*v)->barcode();
+      vr.id = (*v)->id();
+      vr.nweights = (*v)->weights().size();
+      vr.spare = 0;
+      for (int i = 0; i < vr.nweights; i++)
+	{
+	  vertexweights.push_back((*v)->weights()[i]);
+	}
+      vertices.push_back(vr);
+      if (*v == evt->signal_process_vertex())
+	{
+	  rec.signal_process_vertex = vertexindex[*v];
+	}
+    }
+
+  particles.clear();
+  flows.clear();
+  for (HepMC::GenEvent::particle_const_iterator p = evt->particles_begin(); p != evt->particles_end(); ++p)
+    {
+      ParticleRecord pr;
+      pr.px = (*p)->momentum().px();
+      pr.py = (*p)->momentum().py();
+      pr.pz = (*p)->momentum().pz();
+      pr.e = (*p)->momentum().e();
+      pr.m = (*p)->generated_mass();
+      pr.theta = (*p)->polarization().theta();
+      pr.phi = (*p)->polarization().phi();
+      pr.barcode = (*p)->barcode();
+      pr.pdg = (*p)->pdg_id();
+      pr.status = (*p)->status();
+      pr.production_vertex = ((*p)->production_vertex()) ? vertexindex[(*p)->production_vertex()] : -1;
+      pr.end_vertex = ((*p)->end_vertex()) ? vertexindex[(*p)->end_vertex()] : -1;
+      pr.nflows = 0;
+      const HepMC::Flow &flow = (*p)->flow();
+      for (HepMC::Flow::const_iterator f = flow.begin(); f != flow.end(); ++f)
+	{
+	  flows.push_back(f->first);
+	  flows.push_back(f->second);
+	  pr.nflows++;
+	}
+      if (*p == evt->beam_particles().first)
+	{
+	  rec.beam1 = particles.size();
+	}
+      if (*p == evt->beam_particles().second)
+	{
+	  rec.beam2 = particles.size();
+	}
+      particles.push_back(pr);
+    }
+
+  weights.clear();
+  for (unsigned int i = 0; i < evt->weights().size(); i++)
+    {
+      weights.push_back(evt->weights()[i]);
+    }
+  randomstates.clear();
+  for (unsigned int i = 0; i < evt->random_states().size(); i++)
+    {
+      randomstates.push_back(evt->random_states()[i]);
+    }
+
+  rec.nvertices = vertices.size();
+  rec.nparticles = particles.size();
+  rec.nweights = weights.size();
+  rec.nrandom = randomstates.size();
+  rec.nvertexweights = vertexweights.size();
+  rec.nflows = flows.size() / 2;
+  rec.has_heavyion = (evt->heavy_ion() != NULL);
+  rec.has_pdfinfo = (evt->pdf_info() != NULL);
+  rec.has_crosssection = (evt->cross_section() != NULL);
+
+  offsets.push_back(ftello(fp));
+  int ok = (fwrite(&rec, sizeof(rec), 1, fp) == 1);
+  if (rec.nvertices > 0)
+    {
+      ok &= (fwrite(&vertices[0], sizeof(VertexRecord), rec.nvertices, fp) == vertices.size());
+    }
+  if (rec.nparticles > 0)
+    {
+      ok &= (fwrite(&particles[0], sizeof(ParticleRecord), rec.nparticles, fp) == particles.size());
+    }
+  if (rec.nweights > 0)
+    {
+      ok &= (fwrite(&weights[0], sizeof(double), rec.nweights, fp) == weights.size());
+    }
+  if (rec.nrandom > 0)
+    {
+      ok &= (fwrite(&randomstates[0], sizeof(long long), rec.nrandom, fp) == randomstates.size());
+    }
+  if (rec.nvertexweights > 0)
+    {
+      ok &= (fwrite(&vertexweights[0], sizeof(double), rec.nvertexweights, fp) == vertexweights.size());
+    }
+  if (rec.nflows > 0)
+    {
+      ok &= (fwrite(&flows[0], sizeof(int), flows.size(), fp) == flows.size());
+    }
+  if (rec.has_heavyion)
+    {
+      const HepMC::HeavyIon *hi = evt->heavy_ion();
+      HeavyIonRecord hr;
+      hr.Ncoll_hard = hi->Ncoll_hard();
+      hr.Npart_proj = hi->Npart_proj();
+      hr.Npart_targ = hi->Npart_targ();
+      hr.Ncoll = hi->Ncoll();
+      hr.spectator_neutrons = hi->spectator_neutrons();
+      hr.spectator_protons = hi->spectator_protons();
+      hr.N_Nwounded_collisions = hi->N_Nwounded_collisions();
+      hr.Nwounded_N_collisions = hi->Nwounded_N_collisions();
+      hr.Nwounded_Nwounded_collisions = hi->Nwounded_Nwounded_collisions();
+      hr.impact_parameter = hi->impact_parameter();
+      hr.event_plane_angle = hi->event_plane_angle();
+      hr.eccentricity = hi->eccentricity();
+      hr.sigma_inel_NN = hi->sigma_inel_NN();
+      ok &= (fwrite(&hr, sizeof(hr), 1, fp) == 1);
+    }
+  if (rec.has_pdfinfo)
+    {
+      const HepMC::PdfInfo *pdf = evt->pdf_info();
+      PdfInfoRecord pr;
+      pr.id1 = pdf->id1();
+      pr.id2 = pdf->id2();
+      pr.pdf_id1 = pdf->pdf_id1();
+      pr.pdf_id2 = pdf->pdf_id2();
+      pr.x1 = pdf->x1();
+      pr.x2 = pdf->x2();
+      pr.scalePDF = pdf->scalePDF();
+      pr.pdf1 = pdf->pdf1();
+      pr.pdf2 = pdf->pdf2();
+      ok &= (fwrite(&pr, sizeof(pr), 1, fp) == 1);
+    }
+  if (rec.has_crosssection)
+    {
+      CrossSectionRecord xr;
+      xr.cross_section = evt->cross_section()->cross_section();
+      xr.cross_section_error = evt->cross_section()->cross_section_error();
+      ok &= (fwrite(&xr, sizeof(xr), 1, fp) == 1);
+    }
+  if (!ok)
+    {
+      cout << PHWHERE << " could not write event " << rec.event_number << endl;
+      offsets.pop_back();
+      return -1;
+    }
+  next_event++;
+  return 0;
+}
+
+int
+PHHepMCBinaryFile::seek(const unsigned int i)
+{
+  if (!fp || writing || i > offsets.size())
+    {
+      return -1;
+    }
+  // one past the last event is the end of the file
+  if (i < offsets.size() && fseeko(fp, offsets[i], SEEK_SET))
+    {
+      return -1;
+    }
+  next_event = i;
+  return 0;
+}
+
+HepMC::GenEvent *
+PHHepMCBinaryFile::read_event(const unsigned int i)
+{
+  if (seek(i))
+    {
+      return NULL;
+    }
+  return read_next_event();
+}
+
+HepMC::GenEvent *
+PHHepMCBinaryFile::read_next_event()
+{
+  if (!fp || writing || next_event >= offsets.size())
+    {
+      return NULL;
+    }
+
+  EventRecord rec;
+  if (fread(&rec, sizeof(rec), 1, fp) != 1)
+    {
+      cout << PHWHERE << " could not read event record " << next_event << endl;
+      return NULL;
+    }
+  vertices.resize(rec.nvertices);
+  particles.resize(rec.nparticles);
+  weights.resize(rec.nweights);
+  randomstates.resize(rec.nrandom);
+  vertexweights.resize(rec.nvertexweights);
+  flows.resize(2 * rec.nflows);
+  int ok = 1;
+  if (rec.nvertices > 0)
+    {
+      ok &= (fread(&vertices[0], sizeof(VertexRecord), rec.nvertices, fp) == vertices.size());
+    }
+  if (rec.nparticles > 0)
+    {
+      ok &= (fread(&particles[0], sizeof(ParticleRecord), rec.nparticles, fp) == particles.size());
+    }
+  if (rec.nweights > 0)
+    {
+      ok &= (fread(&weights[0], sizeof(double), rec.nweights, fp) == weights.size());
+    }
+  if (rec.nrandom > 0)
+    {
+      ok &= (fread(&randomstates[0], sizeof(long long), rec.nrandom, fp) == randomstates.size());
+    }
+  if (rec.nvertexweights > 0)
+    {
+      ok &= (fread(&vertexweights[0], sizeof(double), rec.nvertexweights, fp) == vertexweights.size());
+    }
+  if (rec.nflows > 0)
+    {
+      ok &= (fread(&flows[0], sizeof(int), flows.size(), fp) == flows.size());
+    }
+  HeavyIonRecord hr;
+  if (rec.has_heavyion)
+    {
+      ok &= (fread(&hr, sizeof(hr), 1, fp) == 1);
+    }
+  PdfInfoRecord pr;
+  if (rec.has_pdfinfo)
+    {
+      ok &= (fread(&pr, sizeof(pr), 1, fp) == 1);
+    }
+  CrossSectionRecord xr;
+  if (rec.has_crosssection)
+    {
+      ok &= (fread(&xr, sizeof(xr), 1, fp) == 1);
+    }
+  if (!ok)
+    {
+      cout << PHWHERE << " truncated event record " << next_event << endl;
+      return NULL;
+    }
+  next_event++;
+
+  HepMC::GenEvent *evt = new HepMC::GenEvent((HepMC::Units::MomentumUnit) rec.momentum_unit,
+					     (HepMC::Units::LengthUnit) rec.length_unit);
+  evt->set_event_number(rec.event_number);
+  evt->set_signal_process_id(rec.signal_process_id);
+  evt->set_mpi(rec.mpi);
+  evt->set_event_scale(rec.event_scale);
+  evt->set_alphaQCD(rec.alphaQCD);
+  evt->set_alphaQED(rec.alphaQED);
+  for (int i = 0; i < rec.nweights; i++)
+    {
+      evt->weights().push_back(weights[i]);
+    }
+  vector<long> states(randomstates.begin(), randomstates.end());
+  evt->set_random_states(states);
+
+  vector<HepMC::GenVertex *> genvertices(rec.nvertices);
+  unsigned int iweight = 0;
+  for (int i = 0; i < rec.nvertices; i++)
+    {
+      const VertexRecord &vr = vertices[i];
+      vector<double> vw(vertexweights.begin() + iweight, vertexweights.begin() + iweight + vr.nweights);
+      iweight += vr.nweights;
+      HepMC::GenVertex *v = new HepMC::GenVertex(HepMC::FourVector(vr.x, vr.y, vr.z, vr.t), vr.id, HepMC::WeightContainer(vw));
+      v->suggest_barcode(vr.barcode);
+      evt->add_vertex(v);
+      genvertices[i] = v;
+    }
+  if (rec.signal_process_vertex >= 0)
+    {
+      evt->set_signal_process_vertex(genvertices[rec.signal_process_vertex]);
+    }
+
+  HepMC::GenParticle *beam1 = NULL;
+  HepMC::GenParticle *beam2 = NULL;
+  unsigned int iflow = 0;
+  for (int i = 0; i < rec.nparticles; i++)
+    {
+      const ParticleRecord &part = particles[i];
+      HepMC::Flow flow;
+      for (int j = 0; j < part.nflows; j++)
+	{
+	  flow.set_icode(flows[iflow], flows[iflow + 1]);
+	  iflow += 2;
+	}
+      HepMC::GenParticle *p = new HepMC::GenParticle(HepMC::FourVector(part.px, part.py, part.pz, part.e),
+						     part.pdg, part.status, flow,
+						     HepMC::Polarization(part.theta, part.phi));
+      p->setGeneratedMass(part.m);
+      p->suggest_barcode(part.barcode);
+      if (part.production_vertex >= 0)
+	{
+	  genvertices[part.production_vertex]->add_particle_out(p);
+	}
+      if (part.end_vertex >= 0)
+	{
+	  genvertices[part.end_vertex]->add_particle_in(p);
+	}
+      if (i == rec.beam1)
+	{
+	  beam1 = p;
+	}
+      if (i == rec.beam2)
+	{
+	  beam2 = p;
+	}
+    }
+  if (beam1 || beam2)
+    {
+      evt->set_beam_particles(beam1, beam2);
+    }
+
+  if (rec.has_heavyion)
+    {
+      HepMC::HeavyIon hi(hr.Ncoll_hard, hr.Npart_proj, hr.Npart_targ, hr.Ncoll,
+			 hr.spectator_neutrons, hr.spectator_protons,
+			 hr.N_Nwounded_collisions, hr.Nwounded_N_collisions,
+			 hr.Nwounded_Nwounded_collisions,
+			 hr.impact_parameter, hr.event_plane_angle,
+			 hr.eccentricity, hr.sigma_inel_NN);
+      evt->set_heavy_ion(hi);
+    }
+  if (rec.has_pdfinfo)
+    {
+      HepMC::PdfInfo pdf(pr.id1, pr.id2, pr.x1, pr.x2, pr.scalePDF, pr.pdf1, pr.pdf2,
+			 pr.pdf_id1, pr.pdf_id2);
+      evt->set_pdf_info(pdf);
+    }
+  if (rec.has_crosssection)
+    {
+      HepMC::GenCrossSection xsec;
+      xsec.set_cross_section(xr.cross_section, xr.cross_section_error);
+      evt->set_cross_section(xsec);
+    }
+  return evt;
+}
@@ -0,0 +1,157 @@
+#ifndef PHHEPMCBINARYFILE_H__
+#define PHHEPMCBINARYFILE_H__
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace HepMC
+{
+    class GenEvent;
+};
+
+// Binary file of HepMC events. The vertices and particles of an event
+// are stored as flat arrays which are read back with a few fread calls
+// instead of parsing the IO_GenEvent text. The file ends with the
+// offsets of all events, so skipping and random access only need a seek.
+// Heavy ion, pdf and cross section information, weights and random
+// states are kept, weight names are not.
+// The file is written in native byte order, it is meant as a local cache
+// of an ASCII HepMC file and not for exchanging events.
+
+class PHHepMCBinaryFile
+{
+ public:
+  PHHepMCBinaryFile();
+  virtual ~PHHepMCBinaryFile();
+
+  // return 0 on success
+  int open_read(const std::string &name);
+  int open_write(const std::string &name);
+  // for writing this adds the event index, a file which was not
+  // closed cannot be opened for reading
+  int close();
+  int isOpen() const {return (fp != NULL);}
+
+  int write_event(const HepMC::GenEvent *evt);
+
+  // the caller owns the returned event, NULL at the end of the file
+  HepMC::GenEvent *read_next_event();
+  HepMC::GenEvent *read_event(const unsigned int i);
+  // position on event i, the next read_next_event returns it
+  int seek(const unsigned int i);
+
+  unsigned int entries() const {return offsets.size();}
+  unsigned int current() const {return next_event;}
+
+  // checks that the file is a complete binary HepMC file
+  static int is_valid(const std::string &name);
+
+ protected:
+  struct EventRecord
+  {
+    int event_number;
+    int signal_process_id;
+    int mpi;
+    int signal_process_vertex; // vertex index, -1 if none
+    int beam1;                 // particle indices, -1 if none
+    int beam2;
+    int momentum_unit;
+    int length_unit;
+    int nvertices;
+    int nparticles;
+    int nweights;
+    int nrandom;
+    int nvertexweights;
+    int nflows;
+    int has_heavyion;
+    int has_pdfinfo;
+    int has_crosssection;
+    int spare;
+    double event_scale;
+    double alphaQCD;
+    double alphaQED;
+  };
+
+  struct VertexRecord
+  {
+    double x;
+    double y;
+    double z;
+    double t;
+    int barcode;
+    int id;
+    int nweights;
+    int spare;
+  };
+
+  struct ParticleRecord
+  {
+    double px;
+    double py;
+    double pz;
+    double e;
+    double m;
+    double theta;
+    double phi;
+    int barcode;
+    int pdg;
+    int status;
+    int production_vertex; // vertex indices, -1 if none
+    int end_vertex;
+    int nflows;
+  };
+
+  struct HeavyIonRecord
+  {
+    int Ncoll_hard;
+    int Npart_proj;
+    int Npart_targ;
+    int Ncoll;
+    int spectator_neutrons;
+    int spectator_protons;
+    int N_Nwounded_collisions;
+    int Nwounded_N_collisions;
+    int Nwounded_Nwounded_collisions;
+    float impact_parameter;
+    float event_plane_angle;
+    float eccentricity;
+    float sigma_inel_NN;
+  };
+
+  struct PdfInfoRecord
+  {
+    int id1;
+    int id2;
+    int pdf_id1;
+    int pdf_id2;
+    double x1;
+    double x2;
+    double scalePDF;
+    double pdf1;
+    double pdf2;
+  };
+
+  struct CrossSectionRecord
+  {
+    double cross_section;
+    double cross_section_error;
+  };
+
+  int read_index();
+
+  FILE *fp;
+  int writing;
+  unsigned int next_event;
+  std::vector<unsigned long long> offsets;
+
+  // reused between events
+  std::vector<VertexRecord> vertices;
+  std::vector<ParticleRecord> particles;
+  std::vector<double> weights;
+  std::vector<double> vertexweights;
+  std::vector<long long> randomstates;
+  std::vector<int> flows;
+};
+
+#endif /* PHHEPMCBINARYFILE_H__ */